@@ -100,6 +100,19 @@ typedef struct {
 #define WMITLV_GET_TAG_NUM_TLV_ATTRIB(wmi_cmd_event_id)      \
        WMI_TLV_HLPR_NUM_TLVS_FOR_##wmi_cmd_event_id
 
+/*
+ * Scratch buffer to carve the parsed TLV structure and the padded TLVs of
+ * one command/event out of, instead of allocating them every time.
+ * Whatever does not fit is allocated from the heap. Freeing the TLVs
+ * resets the scratch buffer, so one scratch buffer serves one
+ * command/event at a time.
+ */
+typedef struct {
+    A_UINT8     *buf;
+    A_UINT32    size;
+    A_UINT32    used;
+} wmitlv_scratch;
+
 
 void
 wmitlv_set_static_param_tlv_buf(void *param_tlv_buf, A_UINT32 max_tlvs_accomodated);
@@ -117,6 +130,12 @@ wmitlv_free_allocated_event_tlvs(
     A_UINT32 event_id,
     void **wmi_cmd_struct_ptr);
 
+void
+wmitlv_free_allocated_event_tlvs_scratch(
+    A_UINT32 event_id,
+    void **wmi_cmd_struct_ptr,
+    wmitlv_scratch *scratch);
+
 int
 wmitlv_check_command_tlv_params(
     void *os_ctx, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id);
@@ -133,6 +152,11 @@ int
 wmitlv_check_and_pad_event_tlvs(
     void *os_ctx, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr);
 
+int
+wmitlv_check_and_pad_event_tlvs_scratch(
+    void *os_ctx, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr,
+    wmitlv_scratch *scratch);
+
 /** This structure is the element for the Version WhiteList
  *  table. */
 typedef struct {
@@ -10,6 +10,11 @@
 #include <linux/mm.h>
 #include <linux/err.h>
 #include <linux/of.h>
+#include <linux/log2.h>
+#include <linux/math64.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/workqueue.h>
 #include <linux/version.h>
 #include "cnss_common.h"
 #ifdef CONFIG_CNSS_OUT_OF_TREE
@@ -37,14 +42,35 @@ MODULE_DESCRIPTION("CNSS prealloc driver");
  * features: memorypool and kmem cache.
  */
 
+/**
+ * struct cnss_pool_stats - Usage statistics of a memory pool
+ * @in_use: Elements currently handed out
+ * @peak: Highest @in_use seen, kept across pool re-initialization
+ * @alloc: Allocations served by the pool
+ * @fallback: Allocations served by the pool on behalf of a smaller size
+ *            class which was exhausted
+ * @req_bytes: Bytes requested by the allocations served by the pool
+ */
+struct cnss_pool_stats {
+	atomic_t in_use;
+	atomic_t peak;
+	atomic64_t alloc;
+	atomic64_t fallback;
+	atomic64_t req_bytes;
+};
+
 struct cnss_pool {
 	size_t size;
 	int min;
 	const char name[50];
 	mempool_t *mp;
 	struct kmem_cache *cache;
+	struct cnss_pool_stats stats;
 };
 
+/* Max reserve of a pool, as a multiple of its configured minimum */
+#define CNSS_POOL_RESERVE_MAX_FACTOR 2
+
 /**
  * Memory pool
  * -----------
@@ -59,12 +85,18 @@ struct cnss_pool {
  *              if not merged with another pool.
  *      mp    : A pointer to memory pool. Updated during init.
  *      cache : A pointer to cache. Updated during init.
- * 2. Always keep the table in increasing order
+ * 2. Always keep the table in increasing order, each size being double
+ *    of the previous one. Size class lookup relies on it.
  * 3. Please keep the reserve pool as minimum as possible as it's always
  *    preallocated.
  * 4. Always profile with different use cases after updating this table.
  * 5. A dynamic view of this pool can be viewed at /proc/slabinfo.
  * 6. Each pool has a sys node at /sys/kernel/slab/<name>
+ * 7. Usage, peak and internal fragmentation of each pool can be viewed at
+ *    <debugfs>/cnss_prealloc/stats.
+ * 8. The reserve of a pool grows up to CNSS_POOL_RESERVE_MAX_FACTOR * min
+ *    to cover the peak usage recorded, so that later driver loads and SSR
+ *    recovery find their buffers preallocated.
  *
  */
 
@@ -96,6 +128,12 @@ static struct cnss_pool cnss_pools_wcn6750[] = {
 struct cnss_pool *cnss_pools;
 unsigned int cnss_prealloc_pool_size = ARRAY_SIZE(cnss_pools_default);
 
+static atomic64_t cnss_pool_alloc_fail;
+static struct dentry *cnss_prealloc_debugfs;
+
+static void cnss_pool_resize_work_fn(struct work_struct *work);
+static DECLARE_WORK(cnss_pool_resize_work, cnss_pool_resize_work_fn);
+
 /**
  * cnss_pool_alloc_threshold() - Allocation threshold
  *
@@ -109,6 +147,102 @@ static inline size_t cnss_pool_alloc_threshold(void)
 	return cnss_pools[0].size;
 }
 
+/**
+ * cnss_pool_size_index() - Get the index of the size class for a size
+ * @size: Size in bytes
+ *
+ * Pool sizes double from one entry to the next, so the size class is
+ * derived from the size instead of probing the pools.
+ *
+ * Return: Index of the smallest pool fitting @size, cnss_prealloc_pool_size
+ *         if none fits
+ */
+static unsigned int cnss_pool_size_index(size_t size)
+{
+	unsigned int i;
+
+	if (size <= cnss_pools[0].size)
+		return 0;
+
+	i = order_base_2(DIV_ROUND_UP(size, cnss_pools[0].size));
+	while (i < cnss_prealloc_pool_size && cnss_pools[i].size < size)
+		i++;
+
+	return min(i, cnss_prealloc_pool_size);
+}
+
+/**
+ * cnss_pool_reserve_target() - Reserve wanted for a pool
+ * @pool: Memory pool
+ *
+ * Return: Configured minimum, raised to the recorded peak usage up to
+ *         CNSS_POOL_RESERVE_MAX_FACTOR times the configured minimum
+ */
+static int cnss_pool_reserve_target(struct cnss_pool *pool)
+{
+	int peak = atomic_read(&pool->stats.peak);
+
+	return clamp(peak, pool->min, pool->min * CNSS_POOL_RESERVE_MAX_FACTOR);
+}
+
+/**
+ * cnss_pool_resize_work_fn() - Grow pool reserves to the recorded usage
+ * @work: Work item
+ *
+ * mempool_resize() may sleep, so it is deferred from the allocation path.
+ */
+static void cnss_pool_resize_work_fn(struct work_struct *work)
+{
+	struct cnss_pool *pool;
+	int target;
+	int i;
+
+	for (i = 0; i < cnss_prealloc_pool_size; i++) {
+		pool = &cnss_pools[i];
+		if (!pool->mp)
+			continue;
+
+		target = cnss_pool_reserve_target(pool);
+		if (target <= pool->mp->min_nr)
+			continue;
+
+		if (mempool_resize(pool->mp, target))
+			continue;
+
+		pr_info("cnss_prealloc: grew mempool %s reserve to %d\n",
+			pool->name, target);
+	}
+}
+
+/**
+ * cnss_pool_account_alloc() - Account an allocation served by a pool
+ * @i: Index of the pool
+ * @size: Requested size
+ * @fallback: Served on behalf of a smaller, exhausted size class
+ *
+ * Return: None
+ */
+static void cnss_pool_account_alloc(unsigned int i, size_t size, bool fallback)
+{
+	struct cnss_pool *pool = &cnss_pools[i];
+	int in_use = atomic_inc_return(&pool->stats.in_use);
+	int peak = atomic_read(&pool->stats.peak);
+
+	atomic64_inc(&pool->stats.alloc);
+	atomic64_add(size, &pool->stats.req_bytes);
+	if (fallback)
+		atomic64_inc(&pool->stats.fallback);
+
+	while (in_use > peak) {
+		if (atomic_try_cmpxchg(&pool->stats.peak, &peak, in_use)) {
+			if (in_use > pool->mp->min_nr &&
+			    pool->mp->min_nr < cnss_pool_reserve_target(pool))
+				schedule_work(&cnss_pool_resize_work);
+			break;
+		}
+	}
+}
+
 /**
  * cnss_pool_int() - Initialize memory pools.
  *
@@ -139,8 +273,9 @@ static int cnss_pool_init(void)
 
 		/* Create the pool and associate to slab cache */
 		cnss_pools[i].mp =
-		    mempool_create(cnss_pools[i].min, mempool_alloc_slab,
-				   mempool_free_slab, cnss_pools[i].cache);
+		    mempool_create(cnss_pool_reserve_target(&cnss_pools[i]),
+				   mempool_alloc_slab, mempool_free_slab,
+				   cnss_pools[i].cache);
 
 		if (!cnss_pools[i].mp) {
 			pr_err("cnss_prealloc: mempool %s failed\n",
@@ -150,8 +285,9 @@ static int cnss_pool_init(void)
 			continue;
 		}
 
+		atomic_set(&cnss_pools[i].stats.in_use, 0);
 		pr_info("cnss_prealloc: created mempool %s of min size %d * %zu\n",
-			cnss_pools[i].name, cnss_pools[i].min,
+			cnss_pools[i].name, cnss_pools[i].mp->min_nr,
 			cnss_pools[i].size);
 	}
 
@@ -172,6 +308,8 @@ static void cnss_pool_deinit(void)
 	if (!cnss_pools)
 		return;
 
+	cancel_work_sync(&cnss_pool_resize_work);
+
 	for (i = 0; i < cnss_prealloc_pool_size; i++) {
 		pr_info("cnss_prealloc: destroy mempool %s\n",
 			cnss_pools[i].name);
@@ -220,13 +358,29 @@ void cnss_deinitialize_prealloc_pool(void)
 }
 EXPORT_SYMBOL(cnss_deinitialize_prealloc_pool);
 
+/**
+ * cnss_pool_cache_index() - Get the index of the pool owning a slab cache
+ * @cache: Slab cache
+ *
+ * Return: Index of the pool, -ENOENT if @cache is not a pool cache
+ */
+static int cnss_pool_cache_index(struct kmem_cache *cache)
+{
+	unsigned int i = cnss_pool_size_index(kmem_cache_size(cache));
+
+	if (i < cnss_prealloc_pool_size && cnss_pools[i].cache == cache)
+		return i;
+
+	return -ENOENT;
+}
+
 /**
  * cnss_pool_get_index() - Get the index of memory pool
  * @mem: Allocated memory
  *
  * Returns the index of the memory pool which fits the reqested memory. The
- * complexity of this check is O(num of memory pools). Returns a negative
- * value with error code in case of failure.
+ * pool is looked up from the size of the owning slab cache, so the check is
+ * O(1). Returns a negative value with error code in case of failure.
  *
  */
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 17, 0))
@@ -234,7 +388,6 @@ static int cnss_pool_get_index(void *mem)
 {
 	struct slab *slab;
 	struct kmem_cache *cache;
-	int i;
 
 	if (!virt_addr_valid(mem))
 		return -EINVAL;
@@ -248,20 +401,13 @@ static int cnss_pool_get_index(void *mem)
 	if (!cache)
 		return -ENOENT;
 
-	/* Check if memory belongs to a pool */
-	for (i = 0; i < cnss_prealloc_pool_size; i++) {
-		if (cnss_pools[i].cache == cache)
-			return i;
-	}
-
-	return -ENOENT;
+	return cnss_pool_cache_index(cache);
 }
 #else /* (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 17, 0)) */
 static int cnss_pool_get_index(void *mem)
 {
 	struct page *page;
 	struct kmem_cache *cache;
-	int i;
 
 	if (!virt_addr_valid(mem))
 		return -EINVAL;
@@ -275,13 +421,7 @@ static int cnss_pool_get_index(void *mem)
 	if (!cache)
 		return -ENOENT;
 
-	/* Check if memory belongs to a pool */
-	for (i = 0; i < cnss_prealloc_pool_size; i++) {
-		if (cnss_pools[i].cache == cache)
-			return i;
-	}
-
-	return -ENOENT;
+	return cnss_pool_cache_index(cache);
 }
 #endif /* (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 17, 0)) */
 
@@ -289,8 +429,8 @@ static int cnss_pool_get_index(void *mem)
  * wcnss_prealloc_get() - Get preallocated memory from a pool
  * @size: Size to allocate
  *
- * Memory pool is chosen based on the size. If memory is not available in a
- * given pool it goes to next higher sized pool until it succeeds.
+ * Memory pool is chosen based on the size class. If memory is not available
+ * in a given pool it goes to next higher sized pool until it succeeds.
  *
  * Return: A void pointer to allocated memory
  */
@@ -299,7 +439,7 @@ void *wcnss_prealloc_get(size_t size)
 
 	void *mem = NULL;
 	gfp_t gfp_mask = __GFP_ZERO;
-	int i;
+	unsigned int start, i;
 
 	if (!cnss_pools)
 		return mem;
@@ -310,17 +450,21 @@ void *wcnss_prealloc_get(size_t size)
 		gfp_mask |= GFP_KERNEL;
 
 	if (size >= cnss_pool_alloc_threshold()) {
-
-		for (i = 0; i < cnss_prealloc_pool_size; i++) {
-			if (cnss_pools[i].size >= size && cnss_pools[i].mp) {
-				mem = mempool_alloc(cnss_pools[i].mp, gfp_mask);
-				if (mem)
-					break;
+		start = cnss_pool_size_index(size);
+		for (i = start; i < cnss_prealloc_pool_size; i++) {
+			if (!cnss_pools[i].mp)
+				continue;
+
+			mem = mempool_alloc(cnss_pools[i].mp, gfp_mask);
+			if (mem) {
+				cnss_pool_account_alloc(i, size, i != start);
+				break;
 			}
 		}
 	}
 
 	if (!mem && size >= cnss_pool_alloc_threshold()) {
+		atomic64_inc(&cnss_pool_alloc_fail);
 		pr_debug("cnss_prealloc: not available for size %zu, flag %x\n",
 			 size, gfp_mask);
 	}
@@ -349,6 +493,7 @@ int wcnss_prealloc_put(void *mem)
 	i = cnss_pool_get_index(mem);
 	if (i >= 0 && i < cnss_prealloc_pool_size && cnss_pools[i].mp) {
 		mempool_free(mem, cnss_pools[i].mp);
+		atomic_dec(&cnss_pools[i].stats.in_use);
 		return 1;
 	}
 
@@ -364,6 +509,53 @@ EXPORT_SYMBOL(wcnss_prealloc_check_memory_leak);
 int wcnss_pre_alloc_reset(void) { return -EOPNOTSUPP; }
 EXPORT_SYMBOL(wcnss_pre_alloc_reset);
 
+/**
+ * cnss_prealloc_stats_show() - Show usage of the memory pools
+ * @s: seq file
+ * @data: unused
+ *
+ * Internal fragmentation is the share of the handed out pool memory which
+ * was not requested by the callers.
+ *
+ * Return: 0
+ */
+static int cnss_prealloc_stats_show(struct seq_file *s, void *data)
+{
+	struct cnss_pool *pool;
+	u64 alloc, pool_bytes, req_bytes;
+	int i;
+
+	if (!cnss_pools)
+		return 0;
+
+	seq_printf(s, "%-16s %8s %8s %8s %8s %12s %10s %6s\n",
+		   "name", "size", "reserve", "in_use", "peak", "alloc",
+		   "fallback", "frag%");
+
+	for (i = 0; i < cnss_prealloc_pool_size; i++) {
+		pool = &cnss_pools[i];
+		alloc = atomic64_read(&pool->stats.alloc);
+		req_bytes = atomic64_read(&pool->stats.req_bytes);
+		pool_bytes = alloc * pool->size;
+
+		seq_printf(s, "%-16s %8zu %8d %8d %8d %12llu %10lld %6llu\n",
+			   pool->name, pool->size,
+			   pool->mp ? pool->mp->min_nr : 0,
+			   atomic_read(&pool->stats.in_use),
+			   atomic_read(&pool->stats.peak), alloc,
+			   atomic64_read(&pool->stats.fallback),
+			   pool_bytes ?
+			   div64_u64((pool_bytes - req_bytes) * 100,
+				     pool_bytes) : 0);
+	}
+
+	seq_printf(s, "alloc failures: %lld\n",
+		   atomic64_read(&cnss_pool_alloc_fail));
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(cnss_prealloc_stats);
+
 /**
  * cnss_prealloc_is_valid_dt_node_found - Check if valid device tree node
  *                                        present
@@ -393,12 +585,16 @@ static int __init cnss_prealloc_init(void)
 	if (!cnss_prealloc_is_valid_dt_node_found())
 		return -ENODEV;
 
+	cnss_prealloc_debugfs = debugfs_create_dir("cnss_prealloc", NULL);
+	debugfs_create_file("stats", 0400, cnss_prealloc_debugfs, NULL,
+			    &cnss_prealloc_stats_fops);
+
 	return 0;
 }
 
 static void __exit cnss_prealloc_exit(void)
 {
-	return;
+	debugfs_remove_recursive(cnss_prealloc_debugfs);
 }
 
 module_init(cnss_prealloc_init);
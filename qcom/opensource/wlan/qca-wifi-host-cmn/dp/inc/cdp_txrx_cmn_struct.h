@@ -1154,6 +1154,8 @@ typedef QDF_STATUS(*ol_txrx_get_tsf_time)(void *osif_dev, uint64_t input_time,
  * frames This function pointer is set by the txrx SW
  * perform host-side transmit operations based on
  * whether a HL or LL host/target interface is in use.
+ * @tx.tx_list: transmit a list of data frames with a single TCL head
+ * pointer update; the frames which could not be sent are returned
  * @tx.flow_control_cb: the transmit flow control
  * function that is registered by the
  * OSIF which is called from txrx to
@@ -1201,6 +1203,7 @@ struct ol_txrx_ops {
 	struct {
 		ol_txrx_tx_fp         tx;
 		ol_txrx_tx_fast_fp    tx_fast;
+		ol_txrx_tx_fp         tx_list;
 		ol_txrx_tx_exc_fp     tx_exception;
 		ol_txrx_tx_free_ext_fp tx_free_ext;
 		ol_txrx_completion_fp tx_comp;
@@ -1235,11 +1238,13 @@ struct ol_txrx_ops {
  * struct ol_txrx_hardtart_ctxt - handlers for dp tx path
  * @tx: normal tx function
  * @tx_fast: fast tx function
+ * @tx_list: tx function for a list of nbufs, returns the unsent nbufs
  * @tx_exception: exception tx function
  */
 struct ol_txrx_hardtart_ctxt {
 	ol_txrx_tx_fp         tx;
 	ol_txrx_tx_fast_fp    tx_fast;
+	ol_txrx_tx_fp         tx_list;
 	ol_txrx_tx_exc_fp     tx_exception;
 };
 
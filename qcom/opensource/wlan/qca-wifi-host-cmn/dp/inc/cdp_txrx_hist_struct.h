@@ -78,6 +78,35 @@ enum cdp_hist_types {
 	CDP_HIST_TYPE_MAX,
 };
 
+/*
+ * Log-linear histogram: values below CDP_HIST_HDR_SUB_BUCKETS get a bucket
+ * each, every further power of two range is split in CDP_HIST_HDR_SUB_BUCKETS
+ * linear sub buckets, bounding the relative bucket width to 25%. Values of
+ * 2^(CDP_HIST_HDR_MAX_MSB + 1) and above land in the last bucket.
+ */
+#define CDP_HIST_HDR_SUB_BITS 2
+#define CDP_HIST_HDR_SUB_BUCKETS (1 << CDP_HIST_HDR_SUB_BITS)
+#define CDP_HIST_HDR_MAX_MSB 19
+#define CDP_HIST_HDR_BUCKETS \
+	((CDP_HIST_HDR_MAX_MSB - CDP_HIST_HDR_SUB_BITS + 2) * \
+	 CDP_HIST_HDR_SUB_BUCKETS)
+
+/**
+ * enum cdp_hist_percentile - Percentiles reported for a histogram
+ * @CDP_HIST_P50: 50th percentile
+ * @CDP_HIST_P90: 90th percentile
+ * @CDP_HIST_P99: 99th percentile
+ * @CDP_HIST_P999: 99.9th percentile
+ * @CDP_HIST_PERCENTILE_MAX: Max enumeration
+ */
+enum cdp_hist_percentile {
+	CDP_HIST_P50,
+	CDP_HIST_P90,
+	CDP_HIST_P99,
+	CDP_HIST_P999,
+	CDP_HIST_PERCENTILE_MAX,
+};
+
 /**
  * struct cdp_hist_bucket - Histogram Bucket
  * @hist_type: Histogram type
@@ -88,17 +117,32 @@ struct cdp_hist_bucket {
 	uint64_t freq[CDP_HIST_BUCKET_MAX];
 };
 
+/**
+ * struct cdp_hist_hdr - Log-linear histogram of a stats type
+ * @freq: Frequency of the log-linear buckets
+ * @pct: Percentiles of the samples, computed when the histogram is read
+ */
+struct cdp_hist_hdr {
+	uint64_t freq[CDP_HIST_HDR_BUCKETS];
+	uint32_t pct[CDP_HIST_PERCENTILE_MAX];
+};
+
 /**
  * struct cdp_hist_stats - Histogram of a stats type
  * @hist: Frequency distribution
  * @max: Max frequency
  * @min: Minimum frequency
  * @avg: Average frequency
+ * @hdr: Log-linear histogram counted per sample instead of @hist, NULL if
+ *	 the owner of the stats did not attach one
  */
 struct cdp_hist_stats {
 	struct cdp_hist_bucket hist;
 	int max;
 	int min;
 	int avg;
+#ifdef DP_HIST_PERCENTILE
+	struct cdp_hist_hdr *hdr;
+#endif
 };
 #endif /* _CDP_TXRX_HIST_STRUCT_H_ */
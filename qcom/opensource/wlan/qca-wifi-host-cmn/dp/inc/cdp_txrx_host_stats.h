@@ -840,6 +840,10 @@ cdp_get_scan_spcl_vap_stats(ol_txrx_soc_handle soc,
  * @peer_mac: peer mac address
  * @delay_stats: user allocated buffer for peer delay stats
  *
+ * With DP_HIST_PERCENTILE the hdr of each histogram in @delay_stats must be
+ * NULL, or point to a struct cdp_hist_hdr to fill with the log-linear
+ * buckets and percentiles of the peer.
+ *
  * Return: status Success/Failure
  */
 static inline QDF_STATUS
@@ -21,6 +21,7 @@
 #include <dp_internal.h>
 #include "dp_rings.h"
 #include <dp_htt.h>
+#include "dp_tx.h"
 #include "dp_be.h"
 #include "dp_be_tx.h"
 #include "dp_be_rx.h"
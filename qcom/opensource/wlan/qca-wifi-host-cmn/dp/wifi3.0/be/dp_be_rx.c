@@ -336,6 +336,8 @@ uint32_t dp_rx_process_be(struct dp_intr *int_ctx,
 	uint32_t l3_pad;
 	uint8_t link_id = 0;
 	uint16_t buf_size;
+	uint64_t reap_start_ts;
+	uint64_t reap_end_ts;
 
 	DP_HIST_INIT();
 
@@ -371,6 +373,7 @@ more_data:
 	peer_ext_stats = 0;
 	rx_pdev = NULL;
 	tid_stats = NULL;
+	reap_start_ts = dp_rx_reap_prof_ts();
 
 	dp_pkt_get_timestamp(&current_time);
 
@@ -596,6 +599,7 @@ more_data:
 done:
 	dp_rx_srng_access_end(int_ctx, soc, hal_ring_hdl);
 	qdf_dsb();
+	reap_end_ts = dp_rx_reap_prof_ts();
 
 	dp_rx_per_core_stats_update(soc, reo_ring_num, num_rx_bufs_reaped);
 
@@ -1000,6 +1004,9 @@ done:
 	if (qdf_likely(txrx_peer))
 		dp_txrx_peer_unref_delete(txrx_ref_handle, DP_MOD_ID_RX);
 
+	dp_rx_reap_prof_update(soc, reo_ring_num, reap_start_ts, reap_end_ts,
+			       num_rx_bufs_reaped);
+
 	/*
 	 * If we are processing in near-full condition, there are 3 scenario
 	 * 1) Ring entries has reached critical state
@@ -1860,50 +1860,25 @@ void dp_tx_nbuf_unmap_be(struct dp_soc *soc,
 }
 
 #ifdef QCA_DP_TX_NBUF_LIST_FREE
-qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
-			      qdf_nbuf_t nbuf)
+/**
+ * dp_tx_fast_desc_prepare_be() - Allocate and map a Tx descriptor for the
+ *				  fast transmit path
+ * @soc: DP soc handle
+ * @vdev: DP vdev handle
+ * @nbuf: skb
+ * @desc_pool_id: Tx descriptor pool id
+ * @xmit_type: xmit type of the skb
+ *
+ * Return: Tx descriptor on success, NULL on failure
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_fast_desc_prepare_be(struct dp_soc *soc, struct dp_vdev *vdev,
+			   qdf_nbuf_t nbuf, uint16_t desc_pool_id,
+			   uint8_t xmit_type)
 {
-	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
-	struct dp_vdev *vdev = NULL;
-	struct dp_pdev *pdev = NULL;
+	struct dp_pdev *pdev = vdev->pdev;
 	struct dp_tx_desc_s *tx_desc;
-	uint16_t desc_pool_id;
-	uint16_t pkt_len;
 	qdf_dma_addr_t paddr;
-	QDF_STATUS status = QDF_STATUS_E_RESOURCES;
-	uint8_t cached_desc[HAL_TX_DESC_LEN_BYTES] = { 0 };
-	hal_ring_handle_t hal_ring_hdl = NULL;
-	uint32_t *hal_tx_desc_cached;
-	void *hal_tx_desc;
-	uint8_t tid = HTT_TX_EXT_TID_INVALID;
-	uint8_t xmit_type = qdf_nbuf_get_vdev_xmit_type(nbuf);
-	uint8_t sawf_tid = HTT_TX_EXT_TID_INVALID;
-
-	if (qdf_unlikely(vdev_id >= MAX_VDEV_CNT))
-		return nbuf;
-
-	vdev = soc->vdev_id_map[vdev_id];
-	if (qdf_unlikely(!vdev))
-		return nbuf;
-
-	desc_pool_id = qdf_nbuf_get_queue_mapping(nbuf) & DP_TX_QUEUE_MASK;
-
-	pkt_len = qdf_nbuf_headlen(nbuf);
-	DP_STATS_INC_PKT(vdev, tx_i[xmit_type].rcvd, 1, pkt_len);
-	DP_STATS_INC(vdev, tx_i[xmit_type].rcvd_in_fast_xmit_flow, 1);
-	DP_STATS_INC(vdev, tx_i[xmit_type].rcvd_per_core[desc_pool_id], 1);
-
-	pdev = vdev->pdev;
-	if (dp_tx_limit_check(vdev, nbuf))
-		return nbuf;
-
-	if (qdf_unlikely(vdev->skip_sw_tid_classification
-				& DP_TXRX_HLOS_TID_OVERRIDE_ENABLED)) {
-		tid = qdf_nbuf_get_priority(nbuf);
-
-		if (tid >= DP_TX_INVALID_QOS_TAG)
-			tid = HTT_TX_EXT_TID_INVALID;
-	}
 
 	tx_desc = dp_tx_desc_alloc(soc, desc_pool_id);
 
@@ -1912,7 +1887,7 @@ qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		DP_STATS_INC(vdev,
 			     tx_i[xmit_type].dropped.desc_na_exc_alloc_fail.num,
 			     1);
-		return nbuf;
+		return NULL;
 	}
 
 	dp_tx_outstanding_inc(pdev);
@@ -1921,10 +1896,10 @@ qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	tx_desc->nbuf = nbuf;
 	tx_desc->frm_type = dp_tx_frm_std;
 	tx_desc->tx_encap_type = vdev->tx_encap_type;
-	tx_desc->vdev_id = vdev_id;
+	tx_desc->vdev_id = vdev->vdev_id;
 	tx_desc->pdev = pdev;
 	tx_desc->pkt_offset = 0;
-	tx_desc->length = pkt_len;
+	tx_desc->length = qdf_nbuf_headlen(nbuf);
 	tx_desc->flags |= pdev->tx_fast_flag;
 
 	tx_desc->nbuf->fast_recycled = 1;
@@ -1937,12 +1912,42 @@ qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		/* Handle failure */
 		dp_err("qdf_nbuf_map failed");
 		DP_STATS_INC(vdev, tx_i[xmit_type].dropped.dma_error, 1);
-		goto release_desc;
+		dp_tx_desc_release(soc, tx_desc, desc_pool_id);
+		return NULL;
 	}
 
 	tx_desc->dma_addr = paddr;
 
-	hal_tx_desc_cached = (void *)cached_desc;
+	return tx_desc;
+}
+
+/**
+ * dp_tx_fast_desc_fill_be() - Fill the cached TCL descriptor for the fast
+ *			       transmit path
+ * @soc: DP soc handle
+ * @vdev: DP vdev handle
+ * @tx_desc: Tx descriptor
+ * @hal_tx_desc_cached: cached TCL descriptor to fill
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_fast_desc_fill_be(struct dp_soc *soc, struct dp_vdev *vdev,
+			struct dp_tx_desc_s *tx_desc,
+			uint32_t *hal_tx_desc_cached)
+{
+	qdf_nbuf_t nbuf = tx_desc->nbuf;
+	uint8_t tid = HTT_TX_EXT_TID_INVALID;
+	uint8_t sawf_tid = HTT_TX_EXT_TID_INVALID;
+
+	if (qdf_unlikely(vdev->skip_sw_tid_classification
+				& DP_TXRX_HLOS_TID_OVERRIDE_ENABLED)) {
+		tid = qdf_nbuf_get_priority(nbuf);
+
+		if (tid >= DP_TX_INVALID_QOS_TAG)
+			tid = HTT_TX_EXT_TID_INVALID;
+	}
+
 	hal_tx_desc_cached[0] = (uint32_t)tx_desc->dma_addr;
 	hal_tx_desc_cached[1] = tx_desc->id <<
 		TCL_DATA_CMD_BUF_ADDR_INFO_SW_BUFFER_COOKIE_LSB;
@@ -1976,6 +1981,47 @@ qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		hal_tx_desc_cached[6] = vdev->bss_ast_idx |
 			((vdev->bss_ast_hash & 0xF) <<
 			 TCL_DATA_CMD_CACHE_SET_NUM_LSB);
+}
+
+qdf_nbuf_t dp_tx_fast_send_be(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+			      qdf_nbuf_t nbuf)
+{
+	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
+	struct dp_vdev *vdev = NULL;
+	struct dp_tx_desc_s *tx_desc;
+	uint16_t desc_pool_id;
+	uint16_t pkt_len;
+	QDF_STATUS status = QDF_STATUS_E_RESOURCES;
+	uint8_t cached_desc[HAL_TX_DESC_LEN_BYTES] = { 0 };
+	hal_ring_handle_t hal_ring_hdl = NULL;
+	uint32_t *hal_tx_desc_cached;
+	void *hal_tx_desc;
+	uint8_t xmit_type = qdf_nbuf_get_vdev_xmit_type(nbuf);
+
+	if (qdf_unlikely(vdev_id >= MAX_VDEV_CNT))
+		return nbuf;
+
+	vdev = soc->vdev_id_map[vdev_id];
+	if (qdf_unlikely(!vdev))
+		return nbuf;
+
+	desc_pool_id = qdf_nbuf_get_queue_mapping(nbuf) & DP_TX_QUEUE_MASK;
+
+	pkt_len = qdf_nbuf_headlen(nbuf);
+	DP_STATS_INC_PKT(vdev, tx_i[xmit_type].rcvd, 1, pkt_len);
+	DP_STATS_INC(vdev, tx_i[xmit_type].rcvd_in_fast_xmit_flow, 1);
+	DP_STATS_INC(vdev, tx_i[xmit_type].rcvd_per_core[desc_pool_id], 1);
+
+	if (dp_tx_limit_check(vdev, nbuf))
+		return nbuf;
+
+	tx_desc = dp_tx_fast_desc_prepare_be(soc, vdev, nbuf, desc_pool_id,
+					     xmit_type);
+	if (qdf_unlikely(!tx_desc))
+		return nbuf;
+
+	hal_tx_desc_cached = (void *)cached_desc;
+	dp_tx_fast_desc_fill_be(soc, vdev, tx_desc, hal_tx_desc_cached);
 
 	hal_ring_hdl = dp_tx_get_hal_ring_hdl(soc, desc_pool_id);
 
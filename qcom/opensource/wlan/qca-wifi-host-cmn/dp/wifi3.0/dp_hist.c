@@ -211,6 +211,30 @@ static int dp_hist_find_bucket_idx(int16_t *bucket_array, int value)
 	return idx;
 }
 
+/**
+ * dp_hist_get_buckets() - Get the bucket boundaries of a histogram type
+ * @hist_type: Histogram type
+ *
+ * Return: Bucket array or NULL for an unknown type
+ */
+static int16_t *dp_hist_get_buckets(enum cdp_hist_types hist_type)
+{
+	switch (hist_type) {
+	case CDP_HIST_TYPE_SW_ENQEUE_DELAY:
+		return &dp_hist_sw_enq_dbucket[0];
+	case CDP_HIST_TYPE_HW_COMP_DELAY:
+		return &dp_hist_fw2hw_dbucket[0];
+	case CDP_HIST_TYPE_REAP_STACK:
+		return &dp_hist_reap2stack_bucket[0];
+	case CDP_HIST_TYPE_HW_TX_COMP_DELAY:
+		return &dp_hist_hw_tx_comp_dbucket[0];
+	case CDP_HIST_TYPE_DELAY_PERCENTILE:
+		return &dp_hist_delay_percentile_dbucket[0];
+	default:
+		return NULL;
+	}
+}
+
 /**
  * dp_hist_fill_buckets() - Fill the histogram frequency buckets
  * @hist_bucket: Histogram bukcets
@@ -220,55 +244,248 @@ static int dp_hist_find_bucket_idx(int16_t *bucket_array, int value)
  */
 static void dp_hist_fill_buckets(struct cdp_hist_bucket *hist_bucket, int value)
 {
-	enum cdp_hist_types hist_type;
-	int idx = CDP_HIST_BUCKET_MAX;
+	int16_t *bucket_array;
 
 	if (qdf_unlikely(!hist_bucket))
 		return;
 
-	hist_type = hist_bucket->hist_type;
+	bucket_array = dp_hist_get_buckets(hist_bucket->hist_type);
+	if (qdf_unlikely(!bucket_array))
+		return;
 
-	/* Identify the bucket the bucket and update. */
-	switch (hist_type) {
-	case CDP_HIST_TYPE_SW_ENQEUE_DELAY:
-		idx =  dp_hist_find_bucket_idx(&dp_hist_sw_enq_dbucket[0],
-					       value);
-		break;
-	case CDP_HIST_TYPE_HW_COMP_DELAY:
-		idx =  dp_hist_find_bucket_idx(&dp_hist_fw2hw_dbucket[0],
-					       value);
-		break;
-	case CDP_HIST_TYPE_REAP_STACK:
-		idx =  dp_hist_find_bucket_idx(
-				&dp_hist_reap2stack_bucket[0], value);
-		break;
-	case CDP_HIST_TYPE_HW_TX_COMP_DELAY:
-		idx =  dp_hist_find_bucket_idx(
-				&dp_hist_hw_tx_comp_dbucket[0], value);
-		break;
-	case CDP_HIST_TYPE_DELAY_PERCENTILE:
-		idx =  dp_hist_find_bucket_idx(
-				&dp_hist_delay_percentile_dbucket[0], value);
-		break;
-	default:
-		break;
+	hist_bucket->freq[dp_hist_find_bucket_idx(bucket_array, value)]++;
+}
+
+#ifdef DP_HIST_PERCENTILE
+/* Percentiles of enum cdp_hist_percentile, in per mille */
+static const uint16_t dp_hist_percentile_pm[CDP_HIST_PERCENTILE_MAX] = {
+	500, 900, 990, 999};
+
+/**
+ * dp_hist_hdr_idx() - Get the log-linear bucket of a value
+ * @value: Frequency value
+ *
+ * Return: The log-linear bucket index
+ */
+static inline uint32_t dp_hist_hdr_idx(uint32_t value)
+{
+	uint32_t msb, shift;
+
+	if (value < CDP_HIST_HDR_SUB_BUCKETS)
+		return value;
+
+	msb = qdf_fls(value) - 1;
+	if (msb > CDP_HIST_HDR_MAX_MSB)
+		return CDP_HIST_HDR_BUCKETS - 1;
+
+	shift = msb - CDP_HIST_HDR_SUB_BITS;
+
+	return ((shift + 1) << CDP_HIST_HDR_SUB_BITS) +
+	       ((value >> shift) & (CDP_HIST_HDR_SUB_BUCKETS - 1));
+}
+
+/**
+ * dp_hist_hdr_lower() - Get the lowest value of a log-linear bucket
+ * @idx: Log-linear bucket index
+ *
+ * Return: The lowest value counted in the bucket
+ */
+static uint32_t dp_hist_hdr_lower(uint32_t idx)
+{
+	uint32_t shift;
+
+	if (idx < CDP_HIST_HDR_SUB_BUCKETS)
+		return idx;
+
+	shift = (idx >> CDP_HIST_HDR_SUB_BITS) - 1;
+
+	return (CDP_HIST_HDR_SUB_BUCKETS +
+		(idx & (CDP_HIST_HDR_SUB_BUCKETS - 1))) << shift;
+}
+
+/**
+ * dp_hist_hdr_upper() - Get the highest value of a log-linear bucket
+ * @idx: Log-linear bucket index
+ *
+ * Return: The highest value counted in the bucket
+ */
+static uint32_t dp_hist_hdr_upper(uint32_t idx)
+{
+	if (idx < CDP_HIST_HDR_SUB_BUCKETS)
+		return idx;
+
+	if (idx == CDP_HIST_HDR_BUCKETS - 1)
+		return UINT_MAX;
+
+	return dp_hist_hdr_lower(idx) +
+	       (1 << ((idx >> CDP_HIST_HDR_SUB_BITS) - 1)) - 1;
+}
+
+/**
+ * dp_hist_hdr_update() - Count a value in the log-linear histogram
+ * @hist_stats: Histogram stats
+ * @value: Frequency value
+ *
+ * Return: true if the value was counted, false if no log-linear histogram
+ *	   is attached to @hist_stats
+ */
+static inline bool dp_hist_hdr_update(struct cdp_hist_stats *hist_stats,
+				      int value)
+{
+	if (!hist_stats->hdr)
+		return false;
+
+	hist_stats->hdr->freq[dp_hist_hdr_idx(QDF_MAX(value, 0))]++;
+
+	return true;
+}
+
+/**
+ * dp_hist_hdr_accumulate() - Accumulate the log-linear histogram of src
+ * @src_hist_stats: Source histogram stats
+ * @dst_hist_stats: Destination histogram stats
+ *
+ * Each log-linear bucket of src is counted in the frequency bucket of dst
+ * holding its lowest value, so counts may shift by one bucket for samples
+ * close to a frequency bucket boundary. The log-linear buckets are also
+ * added to dst when dst has a log-linear histogram attached.
+ *
+ * Return: true if src has samples in its log-linear histogram
+ */
+static bool dp_hist_hdr_accumulate(struct cdp_hist_stats *src_hist_stats,
+				   struct cdp_hist_stats *dst_hist_stats)
+{
+	struct cdp_hist_hdr *src_hdr = src_hist_stats->hdr;
+	struct cdp_hist_hdr *dst_hdr = dst_hist_stats->hdr;
+	int16_t *bucket_array;
+	bool hist_stats_valid = false;
+	uint32_t idx;
+	int bucket;
+
+	if (!src_hdr)
+		return false;
+
+	bucket_array = dp_hist_get_buckets(dst_hist_stats->hist.hist_type);
+
+	for (idx = 0; idx < CDP_HIST_HDR_BUCKETS; idx++) {
+		if (!src_hdr->freq[idx])
+			continue;
+
+		hist_stats_valid = true;
+		if (dst_hdr)
+			dst_hdr->freq[idx] += src_hdr->freq[idx];
+
+		if (qdf_unlikely(!bucket_array))
+			continue;
+
+		bucket = dp_hist_find_bucket_idx(bucket_array,
+						 QDF_MIN(dp_hist_hdr_lower(idx),
+							 (uint32_t)INT_MAX));
+		dst_hist_stats->hist.freq[bucket] += src_hdr->freq[idx];
 	}
 
-	if (idx == CDP_HIST_BUCKET_MAX)
+	return hist_stats_valid;
+}
+
+/**
+ * dp_hist_hdr_copy() - Copy the log-linear histogram of src
+ * @src_hist_stats: Source histogram stats
+ * @dst_hist_stats: Destination histogram stats
+ *
+ * Return: void
+ */
+static void dp_hist_hdr_copy(struct cdp_hist_stats *src_hist_stats,
+			     struct cdp_hist_stats *dst_hist_stats)
+{
+	if (dst_hist_stats->hdr)
+		qdf_mem_zero(dst_hist_stats->hdr->freq,
+			     sizeof(dst_hist_stats->hdr->freq));
+
+	dp_hist_hdr_accumulate(src_hist_stats, dst_hist_stats);
+}
+
+void dp_hist_compute_percentiles(struct cdp_hist_stats *hist_stats)
+{
+	struct cdp_hist_hdr *hdr = hist_stats->hdr;
+	uint64_t total = 0, cumul = 0, rank;
+	uint32_t idx;
+	uint8_t pct;
+
+	if (!hdr)
 		return;
 
-	hist_bucket->freq[idx]++;
+	qdf_mem_zero(hdr->pct, sizeof(hdr->pct));
+
+	for (idx = 0; idx < CDP_HIST_HDR_BUCKETS; idx++)
+		total += hdr->freq[idx];
+
+	if (!total)
+		return;
+
+	idx = 0;
+	for (pct = 0; pct < CDP_HIST_PERCENTILE_MAX; pct++) {
+		rank = qdf_do_div(total * dp_hist_percentile_pm[pct] + 999,
+				  1000);
+		while (idx < CDP_HIST_HDR_BUCKETS - 1 &&
+		       cumul + hdr->freq[idx] < rank)
+			cumul += hdr->freq[idx++];
+
+		hdr->pct[pct] = QDF_MIN(dp_hist_hdr_upper(idx),
+					(uint32_t)hist_stats->max);
+	}
+}
+
+void dp_hist_set_hdr(struct cdp_hist_stats *hist_stats,
+		     struct cdp_hist_hdr *hdr)
+{
+	if (hdr)
+		qdf_mem_zero(hdr, sizeof(*hdr));
+
+	hist_stats->hdr = hdr;
+}
+
+struct cdp_hist_hdr *dp_hist_hdr_alloc(void)
+{
+	return qdf_mem_malloc(sizeof(struct cdp_hist_hdr));
+}
+
+void dp_hist_hdr_free(struct cdp_hist_hdr *hdr)
+{
+	if (hdr)
+		qdf_mem_free(hdr);
+}
+#else
+static inline bool dp_hist_hdr_update(struct cdp_hist_stats *hist_stats,
+				      int value)
+{
+	return false;
+}
+
+static inline bool
+dp_hist_hdr_accumulate(struct cdp_hist_stats *src_hist_stats,
+		       struct cdp_hist_stats *dst_hist_stats)
+{
+	return false;
 }
 
+static inline void dp_hist_hdr_copy(struct cdp_hist_stats *src_hist_stats,
+				    struct cdp_hist_stats *dst_hist_stats)
+{
+}
+#endif /* DP_HIST_PERCENTILE */
+
 void dp_hist_update_stats(struct cdp_hist_stats *hist_stats, int value)
 {
 	if (qdf_unlikely(!hist_stats))
 		return;
 
 	/*
-	 * Fill the histogram buckets according to the delay
+	 * Fill the histogram buckets according to the delay. With a
+	 * log-linear histogram attached only its bucket is counted, the
+	 * frequency buckets are derived from it when the stats are read.
 	 */
-	dp_hist_fill_buckets(&hist_stats->hist, value);
+	if (!dp_hist_hdr_update(hist_stats, value))
+		dp_hist_fill_buckets(&hist_stats->hist, value);
 
 	/*
 	 * Compute the min, max and average. Average computed is weighted
@@ -294,6 +511,7 @@ void dp_copy_hist_stats(struct cdp_hist_stats *src_hist_stats,
 	for (index = 0; index < CDP_HIST_BUCKET_MAX; index++)
 		dst_hist_stats->hist.freq[index] =
 			src_hist_stats->hist.freq[index];
+	dp_hist_hdr_copy(src_hist_stats, dst_hist_stats);
 	dst_hist_stats->min = src_hist_stats->min;
 	dst_hist_stats->max = src_hist_stats->max;
 	dst_hist_stats->avg = src_hist_stats->avg;
@@ -310,6 +528,10 @@ void dp_accumulate_hist_stats(struct cdp_hist_stats *src_hist_stats,
 		if (src_hist_stats->hist.freq[index])
 			hist_stats_valid = 1;
 	}
+
+	if (dp_hist_hdr_accumulate(src_hist_stats, dst_hist_stats))
+		hist_stats_valid = 1;
+
 	/*
 	 * If at least one hist-bucket has non-zero count,
 	 * proceed with the detailed calculation.
@@ -64,6 +64,69 @@ void dp_accumulate_hist_stats(struct cdp_hist_stats *src_hist_stats,
 void dp_copy_hist_stats(struct cdp_hist_stats *src_hist_stats,
 			struct cdp_hist_stats *dst_hist_stats);
 
+#ifdef DP_HIST_PERCENTILE
+/**
+ * dp_hist_set_hdr() - Attach a log-linear histogram to the histogram stats
+ * @hist_stats: Hist stats object
+ * @hdr: Log-linear histogram to count the samples in, NULL to detach
+ *
+ * Samples are counted in @hdr instead of the frequency buckets, which are
+ * derived from it when the stats are copied or accumulated. The caller owns
+ * the memory of @hdr, it is cleared here.
+ *
+ * Return: void
+ */
+void dp_hist_set_hdr(struct cdp_hist_stats *hist_stats,
+		     struct cdp_hist_hdr *hdr);
+
+/**
+ * dp_hist_compute_percentiles() - Compute the percentiles of a histogram
+ * @hist_stats: Hist stats object
+ *
+ * Meant for the read side, once the stats are accumulated. A percentile is
+ * reported as the highest value of the log-linear bucket it falls in,
+ * capped to the max value seen. Nothing is done without a log-linear
+ * histogram attached.
+ *
+ * Return: void
+ */
+void dp_hist_compute_percentiles(struct cdp_hist_stats *hist_stats);
+
+/**
+ * dp_hist_hdr_alloc() - Allocate a log-linear histogram
+ *
+ * Return: The histogram, NULL on failure
+ */
+struct cdp_hist_hdr *dp_hist_hdr_alloc(void);
+
+/**
+ * dp_hist_hdr_free() - Free a log-linear histogram
+ * @hdr: Histogram from dp_hist_hdr_alloc(), may be NULL
+ *
+ * Return: void
+ */
+void dp_hist_hdr_free(struct cdp_hist_hdr *hdr);
+#else
+static inline void dp_hist_set_hdr(struct cdp_hist_stats *hist_stats,
+				   struct cdp_hist_hdr *hdr)
+{
+}
+
+static inline
+void dp_hist_compute_percentiles(struct cdp_hist_stats *hist_stats)
+{
+}
+
+static inline struct cdp_hist_hdr *dp_hist_hdr_alloc(void)
+{
+	return NULL;
+}
+
+static inline void dp_hist_hdr_free(struct cdp_hist_hdr *hdr)
+{
+}
+#endif /* DP_HIST_PERCENTILE */
+
 const char *dp_hist_tx_hw_delay_str(uint8_t index);
 const char *dp_hist_delay_percentile_str(uint8_t index);
 #endif /* __DP_HIST_H_ */
@@ -3162,11 +3162,59 @@ uint32_t dp_reo_status_ring_handler(struct dp_intr *int_ctx,
 				    struct dp_soc *soc);
 #endif
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+/**
+ * dp_vdev_stats_aggr_init() - Set up the vdev stats aggregate cache
+ * @soc: DP SOC handle
+ * @vdev: DP VDEV handle
+ *
+ * The cache is left disabled if it is disabled in the soc config or if
+ * its memory cannot be allocated.
+ *
+ * Return: None
+ */
+void dp_vdev_stats_aggr_init(struct dp_soc *soc, struct dp_vdev *vdev);
+
+/**
+ * dp_vdev_stats_aggr_deinit() - Release the vdev stats aggregate cache
+ * @vdev: DP VDEV handle
+ *
+ * Return: None
+ */
+void dp_vdev_stats_aggr_deinit(struct dp_vdev *vdev);
+
+/**
+ * dp_vdev_stats_aggr_invalidate() - Force the next aggregation to walk peers
+ * @vdev: DP VDEV handle
+ *
+ * Return: None
+ */
+void dp_vdev_stats_aggr_invalidate(struct dp_vdev *vdev);
+#else
+static inline void dp_vdev_stats_aggr_init(struct dp_soc *soc,
+					   struct dp_vdev *vdev)
+{
+}
+
+static inline void dp_vdev_stats_aggr_deinit(struct dp_vdev *vdev)
+{
+}
+
+static inline void dp_vdev_stats_aggr_invalidate(struct dp_vdev *vdev)
+{
+}
+#endif
+
 /**
  * dp_aggregate_vdev_stats() - Consolidate stats at VDEV level
  * @vdev: DP VDEV handle
  * @vdev_stats: aggregate statistics
  * @xmit_type: xmit type of packet - MLD/Link
+ *
+ * With WLAN_DP_VDEV_STATS_AGGR_CACHE, an aggregate of the same @xmit_type
+ * taken less than dp_vdev_stats_aggr_cache_ms ago is returned instead of
+ * walking the vdev peers again, so the stats read can be that old.
+ *
  * return: void
  */
 void dp_aggregate_vdev_stats(struct dp_vdev *vdev,
@@ -4795,6 +4795,7 @@ static QDF_STATUS dp_vdev_attach_wifi3(struct cdp_soc_t *cdp_soc,
 
 	qdf_spinlock_create(&vdev->peer_list_lock);
 	TAILQ_INIT(&vdev->peer_list);
+	dp_vdev_stats_aggr_init(soc, vdev);
 	dp_peer_multipass_list_init(vdev);
 	if ((soc->intr_mode == DP_INTR_POLL) &&
 	    wlan_cfg_get_num_contexts(soc->wlan_cfg_ctx) != 0) {
@@ -4883,15 +4884,18 @@ static inline void dp_vdev_fetch_tx_handler(struct dp_vdev *vdev,
 					    struct ol_txrx_hardtart_ctxt *ctx)
 {
 	/* Enable vdev_id check only for ap, if flag is enabled */
-	if (vdev->mesh_vdev)
+	if (vdev->mesh_vdev) {
 		ctx->tx = dp_tx_send_mesh;
-	else if ((wlan_cfg_is_tx_per_pkt_vdev_id_check_enabled(soc->wlan_cfg_ctx)) &&
+		ctx->tx_list = dp_tx_send_list_mesh;
+	} else if ((wlan_cfg_is_tx_per_pkt_vdev_id_check_enabled(soc->wlan_cfg_ctx)) &&
 		 (vdev->opmode == wlan_op_mode_ap)) {
 		ctx->tx = dp_tx_send_vdev_id_check;
 		ctx->tx_fast = dp_tx_send_vdev_id_check;
+		ctx->tx_list = dp_tx_send_list_vdev_id_check;
 	} else {
 		ctx->tx = dp_tx_send;
 		ctx->tx_fast = soc->arch_ops.dp_tx_send_fast;
+		ctx->tx_list = dp_tx_send_list;
 	}
 
 	/* Avoid check in regular exception Path */
@@ -4918,6 +4922,7 @@ static inline void dp_vdev_register_tx_handler(struct dp_vdev *vdev,
 
 	txrx_ops->tx.tx = ctx.tx;
 	txrx_ops->tx.tx_fast = ctx.tx_fast;
+	txrx_ops->tx.tx_list = ctx.tx_list;
 	txrx_ops->tx.tx_exception = ctx.tx_exception;
 
 	dp_info("Configure tx_vdev_id_chk_handler Feature Flag: %d and mode:%d for vdev_id:%d",
@@ -6384,6 +6389,7 @@ void dp_vdev_unref_delete(struct dp_soc *soc, struct dp_vdev *vdev,
 
 free_vdev:
 	qdf_spinlock_destroy(&vdev->peer_list_lock);
+	dp_vdev_stats_aggr_deinit(vdev);
 
 	qdf_spin_lock_bh(&soc->inactive_vdev_list_lock);
 	TAILQ_FOREACH(tmp_vdev, &soc->inactive_vdev_list,
@@ -6415,6 +6421,22 @@ free_vdev:
 
 qdf_export_symbol(dp_vdev_unref_delete);
 
+/**
+ * dp_peer_free_rcu() - Free the peer memory after an RCU grace period
+ * @rcu: RCU head of the peer
+ *
+ * dp_peer_find_hash_find() walks the peer hash without taking a lock,
+ * so the peer memory must stay valid until those readers are done.
+ *
+ * Return: None
+ */
+static void dp_peer_free_rcu(qdf_rcu_head_t *rcu)
+{
+	struct dp_peer *peer = qdf_container_of(rcu, struct dp_peer, rcu);
+
+	qdf_mem_free(peer);
+}
+
 void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 {
 	struct dp_vdev *vdev = peer->vdev;
@@ -6480,7 +6502,7 @@ void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 		dp_txrx_peer_detach(soc, peer);
 		dp_cfg_event_record_peer_evt(soc, DP_CFG_EVENT_PEER_UNREF_DEL,
 					     peer, vdev, 0);
-		qdf_mem_free(peer);
+		qdf_call_rcu(&peer->rcu, dp_peer_free_rcu);
 
 		/*
 		 * Decrement ref count taken at peer create
@@ -6920,6 +6942,113 @@ bool dp_check_pdev_exists(struct dp_soc *soc, struct dp_pdev *data)
 	return false;
 }
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+void dp_vdev_stats_aggr_init(struct dp_soc *soc, struct dp_vdev *vdev)
+{
+	qdf_spinlock_create(&vdev->stats_aggr.lock);
+	qdf_mem_zero(vdev->stats_aggr.valid, sizeof(vdev->stats_aggr.valid));
+	vdev->stats_aggr.stats = NULL;
+	vdev->stats_aggr.max_age_ms =
+		wlan_cfg_get_vdev_stats_aggr_cache_ms(soc->wlan_cfg_ctx);
+	if (!vdev->stats_aggr.max_age_ms)
+		return;
+
+	vdev->stats_aggr.stats =
+		qdf_mem_malloc(DP_XMIT_TYPE_MAX *
+			       sizeof(*vdev->stats_aggr.stats));
+	if (!vdev->stats_aggr.stats)
+		dp_info("vdev %u stats aggregate cache disabled",
+			vdev->vdev_id);
+}
+
+void dp_vdev_stats_aggr_deinit(struct dp_vdev *vdev)
+{
+	qdf_mem_free(vdev->stats_aggr.stats);
+	vdev->stats_aggr.stats = NULL;
+	qdf_spinlock_destroy(&vdev->stats_aggr.lock);
+}
+
+void dp_vdev_stats_aggr_invalidate(struct dp_vdev *vdev)
+{
+	qdf_spin_lock_bh(&vdev->stats_aggr.lock);
+	qdf_mem_zero(vdev->stats_aggr.valid, sizeof(vdev->stats_aggr.valid));
+	qdf_spin_unlock_bh(&vdev->stats_aggr.lock);
+}
+
+/**
+ * dp_vdev_stats_aggr_get() - Get a recent aggregate of the vdev stats
+ * @vdev: DP VDEV handle
+ * @vdev_stats: buffer filled with the cached aggregate
+ * @xmit_type: xmit type of the aggregate
+ *
+ * Each xmit type has its own entry, so readers of different types do not
+ * evict each other. A hit returns stats up to max_age_ms old.
+ *
+ * Return: true if @vdev_stats was filled from the cache
+ */
+static bool dp_vdev_stats_aggr_get(struct dp_vdev *vdev,
+				   struct cdp_vdev_stats *vdev_stats,
+				   enum dp_pkt_xmit_type xmit_type)
+{
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	bool hit = false;
+
+	if (!vdev->stats_aggr.stats)
+		return false;
+
+	qdf_spin_lock_bh(&vdev->stats_aggr.lock);
+	if (vdev->stats_aggr.valid[xmit_type] &&
+	    now_ms - vdev->stats_aggr.ts_ms[xmit_type] <
+	    vdev->stats_aggr.max_age_ms) {
+		qdf_mem_copy(vdev_stats, &vdev->stats_aggr.stats[xmit_type],
+			     sizeof(*vdev_stats));
+		hit = true;
+	}
+	qdf_spin_unlock_bh(&vdev->stats_aggr.lock);
+
+	return hit;
+}
+
+/**
+ * dp_vdev_stats_aggr_set() - Cache a fresh aggregate of the vdev stats
+ * @vdev: DP VDEV handle
+ * @vdev_stats: aggregate just computed
+ * @xmit_type: xmit type of the aggregate
+ *
+ * Return: None
+ */
+static void dp_vdev_stats_aggr_set(struct dp_vdev *vdev,
+				   struct cdp_vdev_stats *vdev_stats,
+				   enum dp_pkt_xmit_type xmit_type)
+{
+	if (!vdev->stats_aggr.stats)
+		return;
+
+	qdf_spin_lock_bh(&vdev->stats_aggr.lock);
+	qdf_mem_copy(&vdev->stats_aggr.stats[xmit_type], vdev_stats,
+		     sizeof(*vdev_stats));
+	vdev->stats_aggr.ts_ms[xmit_type] =
+		qdf_system_ticks_to_msecs(qdf_system_ticks());
+	vdev->stats_aggr.valid[xmit_type] = true;
+	qdf_spin_unlock_bh(&vdev->stats_aggr.lock);
+}
+#else
+static inline bool
+dp_vdev_stats_aggr_get(struct dp_vdev *vdev,
+		       struct cdp_vdev_stats *vdev_stats,
+		       enum dp_pkt_xmit_type xmit_type)
+{
+	return false;
+}
+
+static inline void
+dp_vdev_stats_aggr_set(struct dp_vdev *vdev,
+		       struct cdp_vdev_stats *vdev_stats,
+		       enum dp_pkt_xmit_type xmit_type)
+{
+}
+#endif
+
 void dp_aggregate_vdev_stats(struct dp_vdev *vdev,
 			     struct cdp_vdev_stats *vdev_stats,
 			     enum dp_pkt_xmit_type xmit_type)
@@ -6927,14 +7056,18 @@ void dp_aggregate_vdev_stats(struct dp_vdev *vdev,
 	if (!vdev || !vdev->pdev)
 		return;
 
-	dp_update_vdev_ingress_stats(vdev);
+	if (!dp_vdev_stats_aggr_get(vdev, vdev_stats, xmit_type)) {
+		dp_update_vdev_ingress_stats(vdev);
 
-	dp_copy_vdev_stats_to_tgt_buf(vdev_stats,
-					    &vdev->stats, xmit_type);
-	dp_vdev_iterate_peer(vdev, dp_update_vdev_stats, vdev_stats,
-			     DP_MOD_ID_GENERIC_STATS);
+		dp_copy_vdev_stats_to_tgt_buf(vdev_stats,
+					      &vdev->stats, xmit_type);
+		dp_vdev_iterate_peer(vdev, dp_update_vdev_stats, vdev_stats,
+				     DP_MOD_ID_GENERIC_STATS);
 
-	dp_update_vdev_rate_stats(vdev_stats, &vdev->stats);
+		dp_update_vdev_rate_stats(vdev_stats, &vdev->stats);
+
+		dp_vdev_stats_aggr_set(vdev, vdev_stats, xmit_type);
+	}
 
 #if defined(FEATURE_PERPKT_INFO) && WDI_EVENT_ENABLE
 	dp_wdi_event_handler(WDI_EVENT_UPDATE_DP_STATS, vdev->pdev->soc,
@@ -7260,6 +7393,8 @@ dp_txrx_host_peer_stats_clr(struct dp_soc *soc,
 			DP_STATS_CLR(tgt_peer);
 			txrx_peer = tgt_peer->txrx_peer;
 			dp_txrx_peer_stats_clr(txrx_peer);
+			/* MLD peer may sit on a vdev not walked by the caller */
+			dp_vdev_stats_aggr_invalidate(tgt_peer->vdev);
 		}
 	}
 
@@ -7358,6 +7493,7 @@ dp_txrx_host_stats_clr(struct dp_vdev *vdev, struct dp_soc *soc)
 		DP_STATS_CLR(var_vdev);
 		dp_vdev_iterate_peer(var_vdev, dp_txrx_host_peer_stats_clr,
 				     NULL, DP_MOD_ID_GENERIC_STATS);
+		dp_vdev_stats_aggr_invalidate(var_vdev);
 	}
 
 	dp_srng_clear_ring_usage_wm_stats(soc);
@@ -9722,6 +9858,7 @@ dp_txrx_reset_peer_stats(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	DP_STATS_CLR(peer);
 	dp_txrx_peer_stats_clr(peer->txrx_peer);
+	dp_vdev_stats_aggr_invalidate(peer->vdev);
 
 	if (IS_MLO_DP_MLD_PEER(peer)) {
 		uint8_t i;
@@ -9738,6 +9875,7 @@ dp_txrx_reset_peer_stats(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 			DP_STATS_CLR(link_peer);
 			dp_monitor_peer_reset_stats(link_peer_soc, link_peer);
+			dp_vdev_stats_aggr_invalidate(link_peer->vdev);
 		}
 
 		dp_release_link_peers_ref(&link_peers_info, DP_MOD_ID_CDP);
@@ -9765,6 +9903,7 @@ dp_txrx_reset_peer_stats(struct cdp_soc_t *soc, uint8_t vdev_id,
 	DP_STATS_CLR(peer);
 	dp_txrx_peer_stats_clr(peer->txrx_peer);
 	dp_monitor_peer_reset_stats((struct dp_soc *)soc, peer);
+	dp_vdev_stats_aggr_invalidate(peer->vdev);
 
 	dp_peer_unref_delete(peer, DP_MOD_ID_CDP);
 
@@ -10277,6 +10416,7 @@ static QDF_STATUS dp_txrx_dump_stats(struct cdp_soc_t *psoc, uint16_t value,
 
 	case CDP_RX_RING_STATS:
 		dp_print_per_ring_stats(soc);
+		dp_rx_reap_prof_print(soc);
 		break;
 
 	case CDP_TXRX_TSO_STATS:
@@ -10555,6 +10695,10 @@ QDF_STATUS dp_txrx_clear_dump_stats(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 		dp_pdev_clear_tx_delay_stats(soc);
 		break;
 
+	case CDP_RX_RING_STATS:
+		dp_rx_reap_prof_clear(soc);
+		break;
+
 	default:
 		status = QDF_STATUS_E_INVAL;
 		break;
@@ -11744,6 +11888,7 @@ static void dp_pause_tx_hardstart(struct dp_soc *soc)
 
 	ctxt.tx = &dp_tx_drop;
 	ctxt.tx_fast = &dp_tx_drop;
+	ctxt.tx_list = &dp_tx_drop;
 	ctxt.tx_exception = &dp_tx_exc_drop;
 
 	for (i = 0; i < MAX_PDEV_CNT; i++) {
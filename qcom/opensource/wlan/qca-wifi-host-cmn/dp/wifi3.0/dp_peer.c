@@ -352,8 +352,16 @@ static QDF_STATUS dp_peer_find_map_attach(struct dp_soc *soc)
 #define DP_AST_HASH_LOAD_MULT  2
 #define DP_AST_HASH_LOAD_SHIFT 0
 
+/* log2 of the initial number of peer hash bins */
+#define DP_PEER_HASH_MIN_IDX_BITS 4
+/*
+ * Number of lockless walks of a bin which changed under the lookup, after
+ * which the bin is walked under peer_hash_lock
+ */
+#define DP_PEER_HASH_FIND_RETRIES 2
+
 static inline uint32_t
-dp_peer_find_hash_index(struct dp_soc *soc,
+dp_peer_find_hash_index(struct dp_peer_hash_table *tbl,
 			union dp_align_mac_addr *mac_addr)
 {
 	uint32_t index;
@@ -363,21 +371,359 @@ dp_peer_find_hash_index(struct dp_soc *soc,
 		mac_addr->align2.bytes_cd ^
 		mac_addr->align2.bytes_ef;
 
-	index ^= index >> soc->peer_hash.idx_bits;
-	index &= soc->peer_hash.mask;
+	index ^= index >> tbl->idx_bits;
+	index &= tbl->mask;
 	return index;
 }
 
+/**
+ * dp_peer_hash_table_alloc() - allocate a peer hash table
+ * @soc: soc handle
+ * @idx_bits: log2 of the number of bins
+ * @gen: dp_peer::hash_next slot linking the bins of the table
+ *
+ * Return: peer hash table, NULL on allocation failure
+ */
+static struct dp_peer_hash_table *
+dp_peer_hash_table_alloc(struct dp_soc *soc, uint32_t idx_bits, uint8_t gen)
+{
+	struct dp_peer_hash_table *tbl;
+	uint32_t hash_elems = 1 << idx_bits;
+
+	tbl = qdf_mem_malloc(sizeof(*tbl) +
+			     hash_elems * sizeof(tbl->bins[0]));
+	if (!tbl)
+		return NULL;
+
+	tbl->mask = hash_elems - 1;
+	tbl->idx_bits = idx_bits;
+	tbl->gen = gen;
+	tbl->soc = soc;
+
+	return tbl;
+}
+
+
+/**
+ * dp_peer_hash_link() - append a peer to its bin of a peer hash table
+ * @tbl: peer hash table
+ * @peer: peer to be added
+ *
+ * Caller must hold peer_hash_lock.
+ *
+ * Return: none
+ */
+static void
+dp_peer_hash_link(struct dp_peer_hash_table *tbl, struct dp_peer *peer)
+{
+	struct dp_peer **pprev;
+
+	pprev = &tbl->bins[dp_peer_find_hash_index(tbl, &peer->mac_addr)];
+	while (*pprev)
+		pprev = &(*pprev)->hash_next[tbl->gen];
+
+	peer->hash_next[tbl->gen] = NULL;
+	qdf_rcu_assign_pointer(*pprev, peer);
+}
+
+/**
+ * dp_peer_hash_unlink() - remove a peer from a peer hash table
+ * @tbl: peer hash table
+ * @peer: peer to be removed
+ *
+ * The hash_next of the removed peer is left intact, so that lockless
+ * readers standing on it can still finish walking the bin.
+ * Caller must hold peer_hash_lock.
+ *
+ * Return: true if the peer was found in the table
+ */
+static bool
+dp_peer_hash_unlink(struct dp_peer_hash_table *tbl, struct dp_peer *peer)
+{
+	struct dp_peer **pprev;
+
+	pprev = &tbl->bins[dp_peer_find_hash_index(tbl, &peer->mac_addr)];
+	while (*pprev && *pprev != peer)
+		pprev = &(*pprev)->hash_next[tbl->gen];
+
+	if (!*pprev)
+		return false;
+
+	qdf_rcu_assign_pointer(*pprev, peer->hash_next[tbl->gen]);
+	return true;
+}
+
+static void dp_peer_hash_table_free_rcu(qdf_rcu_head_t *rcu);
+
+/**
+ * dp_peer_hash_resize() - move the peers to a hash table of a new size
+ * @soc: soc handle
+ * @idx_bits: log2 of the number of bins of the new table
+ *
+ * The new table links the peers through the other hash_next slot, so
+ * readers still walking the old table see it unchanged. The old table is
+ * freed after an RCU grace period and no other resize is done before
+ * that, the load factor is checked again once the old table is freed.
+ * Bins are rehashed in order, which keeps peers with the same MAC
+ * address in the order they were added.
+ * Caller must hold peer_hash_lock.
+ *
+ * Return: none
+ */
+static void dp_peer_hash_resize(struct dp_soc *soc, uint32_t idx_bits)
+{
+	struct dp_peer_hash_table *old_tbl = soc->peer_hash.tbl;
+	struct dp_peer_hash_table *new_tbl;
+	struct dp_peer *peer;
+	uint32_t i;
+
+	if (qdf_atomic_read(&soc->peer_hash.resize_pending))
+		return;
+
+	new_tbl = dp_peer_hash_table_alloc(soc, idx_bits,
+					   (old_tbl->gen + 1) %
+					   DP_PEER_HASH_GENS);
+	if (!new_tbl)
+		return;
+
+	for (i = 0; i <= old_tbl->mask; i++) {
+		for (peer = old_tbl->bins[i]; peer;
+		     peer = peer->hash_next[old_tbl->gen])
+			dp_peer_hash_link(new_tbl, peer);
+	}
+
+	qdf_atomic_set(&soc->peer_hash.resize_pending, 1);
+	qdf_rcu_assign_pointer(soc->peer_hash.tbl, new_tbl);
+	qdf_call_rcu(&old_tbl->rcu, dp_peer_hash_table_free_rcu);
+	soc->peer_hash.resize_cnt++;
+
+	dp_peer_info("%pK: peer hash resized %u -> %u bins for %u peers",
+		     soc, old_tbl->mask + 1, new_tbl->mask + 1,
+		     soc->peer_hash.num_peers);
+}
+
+/**
+ * dp_peer_hash_check_resize() - grow or shrink the peer hash on load
+ * @soc: soc handle
+ *
+ * The table is doubled when there are more peers than bins and halved
+ * when less than a quarter of the bins would be used.
+ * Caller must hold peer_hash_lock.
+ *
+ * Return: none
+ */
+static inline void dp_peer_hash_check_resize(struct dp_soc *soc)
+{
+	struct dp_peer_hash_table *tbl = soc->peer_hash.tbl;
+	uint32_t num_bins = tbl->mask + 1;
+
+	if (soc->peer_hash.num_peers > num_bins &&
+	    tbl->idx_bits < soc->peer_hash.max_idx_bits)
+		dp_peer_hash_resize(soc, tbl->idx_bits + 1);
+	else if (soc->peer_hash.num_peers < (num_bins >> 2) &&
+		 tbl->idx_bits > soc->peer_hash.min_idx_bits)
+		dp_peer_hash_resize(soc, tbl->idx_bits - 1);
+}
+
+/**
+ * dp_peer_hash_table_free_rcu() - free a peer hash table replaced by resize
+ * @rcu: RCU head of the table
+ *
+ * Return: none
+ */
+static void dp_peer_hash_table_free_rcu(qdf_rcu_head_t *rcu)
+{
+	struct dp_peer_hash_table *tbl =
+		qdf_container_of(rcu, struct dp_peer_hash_table, rcu);
+	struct dp_soc *soc = tbl->soc;
+
+	qdf_mem_free(tbl);
+
+	/*
+	 * Peers added or removed while the resize was pending did not
+	 * resize the table, check the load factor again now.
+	 */
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	qdf_atomic_set(&soc->peer_hash.resize_pending, 0);
+	if (soc->peer_hash.tbl)
+		dp_peer_hash_check_resize(soc);
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+}
+
+/**
+ * dp_peer_hash_add_link_peer() - add a peer to the soc peer hash
+ * @soc: soc handle
+ * @peer: peer to be added
+ *
+ * Return: none
+ */
+static void dp_peer_hash_add_link_peer(struct dp_soc *soc,
+				       struct dp_peer *peer)
+{
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+
+	if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer, DP_MOD_ID_CONFIG))) {
+		dp_err("unable to get peer ref at MAP mac: "QDF_MAC_ADDR_FMT,
+		       QDF_MAC_ADDR_REF(peer->mac_addr.raw));
+		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+		return;
+	}
+
+	/*
+	 * It is important to add the new peer at the tail of the peer list
+	 * with the bin index.  Together with having the hash_find function
+	 * search from head to tail, this ensures that if two entries with
+	 * the same MAC address are stored, the one added first will be
+	 * found first.
+	 */
+	dp_peer_hash_link(soc->peer_hash.tbl, peer);
+	soc->peer_hash.num_peers++;
+	dp_peer_hash_check_resize(soc);
+
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+}
+
+/**
+ * dp_peer_hash_remove_link_peer() - remove a peer from the soc peer hash
+ * @soc: soc handle
+ * @peer: peer to be removed
+ *
+ * Return: none
+ */
+static void dp_peer_hash_remove_link_peer(struct dp_soc *soc,
+					  struct dp_peer *peer)
+{
+	bool found;
+
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+
+	found = dp_peer_hash_unlink(soc->peer_hash.tbl, peer);
+	QDF_ASSERT(found);
+	if (found) {
+		soc->peer_hash.num_peers--;
+		/* make the unlink visible before lookups can see the change */
+		qdf_wmb();
+		qdf_atomic_inc(&soc->peer_hash.seq);
+		dp_peer_hash_check_resize(soc);
+	}
+
+	dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+}
+
+/**
+ * dp_peer_hash_table_attach() - allocate the soc peer hash
+ * @soc: soc handle
+ *
+ * The table starts small and is grown up to the size needed for
+ * max_peers as peers get added.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS dp_peer_hash_table_attach(struct dp_soc *soc)
+{
+	uint32_t hash_elems;
+
+	/* upper bound of the peer MAC address -> peer object hash table */
+	hash_elems = soc->max_peers;
+	hash_elems *= DP_PEER_HASH_LOAD_MULT;
+	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
+
+	soc->peer_hash.max_idx_bits = dp_log2_ceil(hash_elems);
+	soc->peer_hash.min_idx_bits = QDF_MIN(DP_PEER_HASH_MIN_IDX_BITS,
+					      soc->peer_hash.max_idx_bits);
+	soc->peer_hash.num_peers = 0;
+	soc->peer_hash.resize_cnt = 0;
+	qdf_atomic_init(&soc->peer_hash.seq);
+	qdf_atomic_init(&soc->peer_hash.resize_pending);
+
+	soc->peer_hash.tbl =
+		dp_peer_hash_table_alloc(soc, soc->peer_hash.min_idx_bits, 0);
+	if (!soc->peer_hash.tbl)
+		return QDF_STATUS_E_NOMEM;
+
+	qdf_spinlock_create(&soc->peer_hash_lock);
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_peer_hash_table_detach() - free the soc peer hash
+ * @soc: soc handle
+ *
+ * Return: none
+ */
+static void dp_peer_hash_table_detach(struct dp_soc *soc)
+{
+	if (soc->peer_hash.tbl) {
+		/*
+		 * peers and replaced tables may still be pending RCU free,
+		 * freeing a replaced table may start one more resize.
+		 */
+		do {
+			qdf_rcu_barrier();
+		} while (qdf_atomic_read(&soc->peer_hash.resize_pending));
+		qdf_mem_free(soc->peer_hash.tbl);
+		soc->peer_hash.tbl = NULL;
+		qdf_spinlock_destroy(&soc->peer_hash_lock);
+	}
+}
+
+/**
+ * dp_peer_find_hash_find_locked() - look up a link peer under peer_hash_lock
+ * @soc: soc handle
+ * @mac_addr: aligned peer MAC address
+ * @vdev_id: vdev id, DP_VDEV_ALL to match any vdev
+ * @mod_id: id of module requesting the reference
+ *
+ * Fallback of the lockless lookup when peers keep being added and removed
+ * while the bin is walked. Peers in the hash hold a reference which is
+ * only dropped under the lock, so peer->vdev can be read before taking
+ * the reference.
+ *
+ * Return: peer with a reference held, NULL if not found
+ */
+static struct dp_peer *
+dp_peer_find_hash_find_locked(struct dp_soc *soc,
+			      union dp_align_mac_addr *mac_addr,
+			      uint8_t vdev_id, enum dp_mod_id mod_id)
+{
+	struct dp_peer_hash_table *tbl;
+	struct dp_peer *peer;
+	uint32_t index;
+
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	tbl = soc->peer_hash.tbl;
+	index = dp_peer_find_hash_index(tbl, mac_addr);
+	for (peer = tbl->bins[index]; peer; peer = peer->hash_next[tbl->gen]) {
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
+		    ((peer->vdev->vdev_id == vdev_id) ||
+		     (vdev_id == DP_VDEV_ALL))) {
+			/* take peer reference before returning */
+			if (dp_peer_get_ref(soc, peer, mod_id) !=
+						QDF_STATUS_SUCCESS)
+				peer = NULL;
+
+			break;
+		}
+	}
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+
+	return peer;
+}
+
 struct dp_peer *dp_peer_find_hash_find(
 				struct dp_soc *soc, uint8_t *peer_mac_addr,
 				int mac_addr_is_aligned, uint8_t vdev_id,
 				enum dp_mod_id mod_id)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
-	uint32_t index;
+	struct dp_peer_hash_table *tbl;
 	struct dp_peer *peer;
+	uint32_t index;
+	uint32_t seq;
+	uint8_t retries = 0;
 
-	if (!soc->peer_hash.bins)
+	if (!soc->peer_hash.tbl)
 		return NULL;
 
 	if (mac_addr_is_aligned) {
@@ -388,23 +734,51 @@ struct dp_peer *dp_peer_find_hash_find(
 			peer_mac_addr, QDF_MAC_ADDR_SIZE);
 		mac_addr = &local_mac_addr_aligned;
 	}
-	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
-		    ((peer->vdev->vdev_id == vdev_id) ||
-		     (vdev_id == DP_VDEV_ALL))) {
-			/* take peer reference before returning */
+
+	qdf_rcu_read_lock();
+	do {
+		seq = qdf_atomic_read(&soc->peer_hash.seq);
+		qdf_rmb();
+
+		tbl = qdf_rcu_dereference(soc->peer_hash.tbl);
+		index = dp_peer_find_hash_index(tbl, mac_addr);
+		for (peer = qdf_rcu_dereference(tbl->bins[index]); peer;
+		     peer = qdf_rcu_dereference(peer->hash_next[tbl->gen])) {
+			if (dp_peer_find_mac_addr_cmp(mac_addr,
+						      &peer->mac_addr))
+				continue;
+
+			/*
+			 * peer->vdev is only stable while a reference is
+			 * held, a peer which is being deleted is skipped.
+			 */
 			if (dp_peer_get_ref(soc, peer, mod_id) !=
 						QDF_STATUS_SUCCESS)
-				peer = NULL;
+				continue;
+
+			if (peer->vdev->vdev_id == vdev_id ||
+			    vdev_id == DP_VDEV_ALL) {
+				qdf_rcu_read_unlock();
+				return peer;
+			}
 
-			qdf_spin_unlock_bh(&soc->peer_hash_lock);
-			return peer;
+			dp_peer_unref_delete(peer, mod_id);
 		}
-	}
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
-	return NULL; /* failure */
+
+		/*
+		 * A peer removed and added back while being walked over
+		 * can cut the walk short, retry if the table changed.
+		 */
+		qdf_rmb();
+		if (seq == qdf_atomic_read(&soc->peer_hash.seq)) {
+			qdf_rcu_read_unlock();
+			return NULL; /* failure */
+		}
+	} while (++retries < DP_PEER_HASH_FIND_RETRIES);
+	qdf_rcu_read_unlock();
+
+	/* The table keeps changing under us, walk it under the lock */
+	return dp_peer_find_hash_find_locked(soc, mac_addr, vdev_id, mod_id);
 }
 
 qdf_export_symbol(dp_peer_find_hash_find);
@@ -418,11 +792,7 @@ qdf_export_symbol(dp_peer_find_hash_find);
  */
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
-	if (soc->peer_hash.bins) {
-		qdf_mem_free(soc->peer_hash.bins);
-		soc->peer_hash.bins = NULL;
-		qdf_spinlock_destroy(&soc->peer_hash_lock);
-	}
+	dp_peer_hash_table_detach(soc);
 
 	if (soc->arch_ops.mlo_peer_find_hash_detach)
 		soc->arch_ops.mlo_peer_find_hash_detach(soc);
@@ -436,28 +806,9 @@ static void dp_peer_find_hash_detach(struct dp_soc *soc)
  */
 static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 {
-	int i, hash_elems, log2;
-
-	/* allocate the peer MAC address -> peer object hash table */
-	hash_elems = soc->max_peers;
-	hash_elems *= DP_PEER_HASH_LOAD_MULT;
-	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
-	log2 = dp_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
-
-	soc->peer_hash.mask = hash_elems - 1;
-	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
-	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
-	if (!soc->peer_hash.bins)
+	if (QDF_IS_STATUS_ERROR(dp_peer_hash_table_attach(soc)))
 		return QDF_STATUS_E_NOMEM;
 
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
-
-	qdf_spinlock_create(&soc->peer_hash_lock);
-
 	if (soc->arch_ops.mlo_peer_find_hash_attach &&
 	    (soc->arch_ops.mlo_peer_find_hash_attach(soc) !=
 			QDF_STATUS_SUCCESS)) {
@@ -469,31 +820,8 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
 	if (peer->peer_type == CDP_LINK_PEER_TYPE) {
-		qdf_spin_lock_bh(&soc->peer_hash_lock);
-
-		if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer,
-							DP_MOD_ID_CONFIG))) {
-			dp_err("fail to get peer ref:" QDF_MAC_ADDR_FMT,
-			       QDF_MAC_ADDR_REF(peer->mac_addr.raw));
-			qdf_spin_unlock_bh(&soc->peer_hash_lock);
-			return;
-		}
-
-		/*
-		 * It is important to add the new peer at the tail of
-		 * peer list with the bin index. Together with having
-		 * the hash_find function search from head to tail,
-		 * this ensures that if two entries with the same MAC address
-		 * are stored, the one added first will be found first.
-		 */
-		TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer,
-				  hash_list_elem);
-
-		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+		dp_peer_hash_add_link_peer(soc, peer);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
 		if (soc->arch_ops.mlo_peer_find_hash_add)
 			soc->arch_ops.mlo_peer_find_hash_add(soc, peer);
@@ -504,30 +832,8 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 
 void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-	struct dp_peer *tmppeer = NULL;
-	int found = 0;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-
 	if (peer->peer_type == CDP_LINK_PEER_TYPE) {
-		/* Check if tail is not empty before delete*/
-		QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
-
-		qdf_spin_lock_bh(&soc->peer_hash_lock);
-		TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index],
-			      hash_list_elem) {
-			if (tmppeer == peer) {
-				found = 1;
-				break;
-			}
-		}
-		QDF_ASSERT(found);
-		TAILQ_REMOVE(&soc->peer_hash.bins[index], peer,
-			     hash_list_elem);
-
-		dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
-		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+		dp_peer_hash_remove_link_peer(soc, peer);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
 		if (soc->arch_ops.mlo_peer_find_hash_remove)
 			soc->arch_ops.mlo_peer_find_hash_remove(soc, peer);
@@ -549,90 +855,24 @@ uint8_t dp_get_peer_link_id(struct dp_peer *peer)
 #else
 static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 {
-	int i, hash_elems, log2;
-
-	/* allocate the peer MAC address -> peer object hash table */
-	hash_elems = soc->max_peers;
-	hash_elems *= DP_PEER_HASH_LOAD_MULT;
-	hash_elems >>= DP_PEER_HASH_LOAD_SHIFT;
-	log2 = dp_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
-
-	soc->peer_hash.mask = hash_elems - 1;
-	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
-	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
-	if (!soc->peer_hash.bins)
-		return QDF_STATUS_E_NOMEM;
-
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
-
-	qdf_spinlock_create(&soc->peer_hash_lock);
-	return QDF_STATUS_SUCCESS;
+	return dp_peer_hash_table_attach(soc);
 }
 
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
-	if (soc->peer_hash.bins) {
-		qdf_mem_free(soc->peer_hash.bins);
-		soc->peer_hash.bins = NULL;
-		qdf_spinlock_destroy(&soc->peer_hash_lock);
-	}
+	dp_peer_hash_table_detach(soc);
 }
 
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-
-	if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer, DP_MOD_ID_CONFIG))) {
-		dp_err("unable to get peer ref at MAP mac: "QDF_MAC_ADDR_FMT,
-		       QDF_MAC_ADDR_REF(peer->mac_addr.raw));
-		qdf_spin_unlock_bh(&soc->peer_hash_lock);
-		return;
-	}
-
-	/*
-	 * It is important to add the new peer at the tail of the peer list
-	 * with the bin index.  Together with having the hash_find function
-	 * search from head to tail, this ensures that if two entries with
-	 * the same MAC address are stored, the one added first will be
-	 * found first.
-	 */
-	TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer, hash_list_elem);
-
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	dp_peer_hash_add_link_peer(soc, peer);
 }
 
 void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 {
-	unsigned index;
-	struct dp_peer *tmppeer = NULL;
-	int found = 0;
-
-	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
-	/* Check if tail is not empty before delete*/
-	QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
-
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (tmppeer == peer) {
-			found = 1;
-			break;
-		}
-	}
-	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->peer_hash.bins[index], peer, hash_list_elem);
-
-	dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	dp_peer_hash_remove_link_peer(soc, peer);
 }
 
-
 #endif/* WLAN_FEATURE_11BE_MLO */
 
 void dp_peer_vdev_list_add(struct dp_soc *soc, struct dp_vdev *vdev,
@@ -3454,6 +3694,83 @@ dp_rx_sec_ind_handler(struct dp_soc *soc, uint16_t peer_id,
 }
 
 #ifdef QCA_PEER_EXT_STATS
+#ifdef DP_HIST_PERCENTILE
+/**
+ * dp_peer_delay_hdr_alloc() - Allocate the log-linear delay histograms of a
+ *			       peer
+ * @delay_stats: Peer delay stats
+ *
+ * The log-linear histograms are kept out of struct dp_peer_delay_stats so
+ * that their memory is only paid for when percentiles are enabled.
+ *
+ * Return: QDF_STATUS_SUCCESS on success
+ */
+static QDF_STATUS
+dp_peer_delay_hdr_alloc(struct dp_peer_delay_stats *delay_stats)
+{
+	delay_stats->delay_hdr =
+			qdf_mem_malloc(sizeof(struct dp_peer_delay_hdr));
+	if (!delay_stats->delay_hdr)
+		return QDF_STATUS_E_NOMEM;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_peer_delay_hdr_free() - Free the log-linear delay histograms of a peer
+ * @delay_stats: Peer delay stats
+ *
+ * Return: void
+ */
+static void dp_peer_delay_hdr_free(struct dp_peer_delay_stats *delay_stats)
+{
+	qdf_mem_free(delay_stats->delay_hdr);
+	delay_stats->delay_hdr = NULL;
+}
+
+/**
+ * dp_peer_delay_hdr_attach() - Attach the log-linear delay histograms of a
+ *				peer to its delay stats
+ * @delay_stats: Peer delay stats
+ *
+ * Return: void
+ */
+static void dp_peer_delay_hdr_attach(struct dp_peer_delay_stats *delay_stats)
+{
+	struct dp_peer_delay_hdr *hdr = delay_stats->delay_hdr;
+	struct cdp_delay_tid_stats *tid_stats;
+	uint8_t tid, ctx_id;
+
+	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
+		for (ctx_id = 0; ctx_id < CDP_MAX_TXRX_CTX; ctx_id++) {
+			tid_stats = &delay_stats->delay_tid_stats[tid][ctx_id];
+			dp_hist_set_hdr(&tid_stats->tx_delay.tx_swq_delay,
+					&hdr->tx_swq_delay[tid][ctx_id]);
+			dp_hist_set_hdr(&tid_stats->tx_delay.hwtx_delay,
+					&hdr->hwtx_delay[tid][ctx_id]);
+			dp_hist_set_hdr(&tid_stats->rx_delay.to_stack_delay,
+					&hdr->to_stack_delay[tid][ctx_id]);
+		}
+	}
+}
+#else
+static inline QDF_STATUS
+dp_peer_delay_hdr_alloc(struct dp_peer_delay_stats *delay_stats)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline void
+dp_peer_delay_hdr_free(struct dp_peer_delay_stats *delay_stats)
+{
+}
+
+static inline void
+dp_peer_delay_hdr_attach(struct dp_peer_delay_stats *delay_stats)
+{
+}
+#endif /* DP_HIST_PERCENTILE */
+
 QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
 					 struct dp_txrx_peer *txrx_peer)
 {
@@ -3477,6 +3794,14 @@ QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
 		return QDF_STATUS_E_NOMEM;
 	}
 
+	if (dp_peer_delay_hdr_alloc(txrx_peer->delay_stats) !=
+	    QDF_STATUS_SUCCESS) {
+		dp_err("Peer delay histograms alloc failed!!");
+		qdf_mem_free(txrx_peer->delay_stats);
+		txrx_peer->delay_stats = NULL;
+		return QDF_STATUS_E_NOMEM;
+	}
+
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		for (ctx_id = 0; ctx_id < CDP_MAX_TXRX_CTX; ctx_id++) {
 			struct cdp_delay_tx_stats *tx_delay =
@@ -3492,6 +3817,7 @@ QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
 				     CDP_HIST_TYPE_REAP_STACK);
 		}
 	}
+	dp_peer_delay_hdr_attach(txrx_peer->delay_stats);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -3510,15 +3836,19 @@ void dp_peer_delay_stats_ctx_dealloc(struct dp_soc *soc,
 	if (!txrx_peer->delay_stats)
 		return;
 
+	dp_peer_delay_hdr_free(txrx_peer->delay_stats);
 	qdf_mem_free(txrx_peer->delay_stats);
 	txrx_peer->delay_stats = NULL;
 }
 
 void dp_peer_delay_stats_ctx_clr(struct dp_txrx_peer *txrx_peer)
 {
-	if (txrx_peer->delay_stats)
-		qdf_mem_zero(txrx_peer->delay_stats,
-			     sizeof(struct dp_peer_delay_stats));
+	if (!txrx_peer->delay_stats)
+		return;
+
+	qdf_mem_zero(txrx_peer->delay_stats->delay_tid_stats,
+		     sizeof(txrx_peer->delay_stats->delay_tid_stats));
+	dp_peer_delay_hdr_attach(txrx_peer->delay_stats);
 }
 #endif
 
@@ -874,6 +874,70 @@ void dp_soc_interrupt_detach(struct cdp_soc_t *txrx_soc)
 		    DP_MON_INVALID_LMAC_ID);
 }
 
+#ifdef HIF_NAPI_DIM
+/**
+ * dp_intr_moderation_update() - Program the interrupt thresholds of the
+ *				 tx completion and rx rings of an interrupt
+ *				 context
+ * @ctx: DP interrupt context
+ * @timer_us: interrupt timer threshold in microseconds
+ * @batch_cnt: interrupt batch counter threshold in ring entries
+ *
+ * Called by HIF when the callback is registered, before the interrupts
+ * of the context are enabled, and then from the NAPI poll of the context.
+ *
+ * Return: None
+ */
+static void dp_intr_moderation_update(void *ctx, uint32_t timer_us,
+				      uint32_t batch_cnt)
+{
+	struct dp_intr *int_ctx = (struct dp_intr *)ctx;
+	struct dp_soc *soc = int_ctx->soc;
+	int index;
+
+	for (index = 0; index < soc->num_tx_comp_rings; index++) {
+		if (!(1 << wlan_cfg_get_wbm_ring_num_for_index(soc->wlan_cfg_ctx,
+								index) &
+		      int_ctx->tx_ring_mask))
+			continue;
+
+		hal_srng_dst_set_intr_moderation(soc->tx_comp_ring[index].hal_srng,
+						 timer_us, batch_cnt);
+	}
+
+	for (index = 0; index < soc->num_reo_dest_rings; index++) {
+		if (!(int_ctx->rx_ring_mask & (1 << index)))
+			continue;
+
+		hal_srng_dst_set_intr_moderation(soc->reo_dest_ring[index].hal_srng,
+						 timer_us, batch_cnt);
+	}
+}
+
+/**
+ * dp_soc_intr_moderation_attach() - Let HIF moderate the interrupts of the
+ *				     tx completion and rx rings
+ * @soc: DP soc handle
+ * @int_ctx: DP interrupt context
+ *
+ * Return: None
+ */
+static void dp_soc_intr_moderation_attach(struct dp_soc *soc,
+					  struct dp_intr *int_ctx)
+{
+	if (!(int_ctx->tx_ring_mask | int_ctx->rx_ring_mask))
+		return;
+
+	hif_register_ext_group_moderation_cb(soc->hif_handle, int_ctx,
+					     dp_intr_moderation_update);
+}
+#else
+static inline void dp_soc_intr_moderation_attach(struct dp_soc *soc,
+						 struct dp_intr *int_ctx)
+{
+}
+#endif
+
 QDF_STATUS dp_soc_interrupt_attach(struct cdp_soc_t *txrx_soc)
 {
 	struct dp_soc *soc = (struct dp_soc *)txrx_soc;
@@ -973,6 +1037,9 @@ QDF_STATUS dp_soc_interrupt_attach(struct cdp_soc_t *txrx_soc)
 				num_irq, irq_id_map, dp_service_srngs_wrapper,
 				&soc->intr_ctx[i], "dp_intr",
 				HIF_EXEC_NAPI_TYPE, napi_scale);
+			if (!ret)
+				dp_soc_intr_moderation_attach(soc,
+							      &soc->intr_ctx[i]);
 		}
 
 		dp_debug(" int ctx %u num_irq %u irq_id_map %u %u",
@@ -2298,6 +2365,56 @@ static inline void dp_reo_desc_deferred_freelist_destroy(struct dp_soc *soc)
 }
 #endif /* !WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY */
 
+#ifdef WLAN_DP_REO_QDESC_CACHE
+/**
+ * dp_reo_qdesc_cache_create() - Initialize the cache of mapped REO QDESCs
+ * @soc: Datapath soc handle
+ *
+ * Return: void
+ */
+static void dp_reo_qdesc_cache_create(struct dp_soc *soc)
+{
+	qdf_spinlock_create(&soc->reo_qdesc_cache_lock);
+	qdf_list_create(&soc->reo_qdesc_cache, REO_QDESC_CACHE_SIZE);
+	soc->reo_qdesc_cache_init = true;
+}
+
+/**
+ * dp_reo_qdesc_cache_destroy() - unmap and free the cached REO QDESCs
+ * @soc: Datapath soc handle
+ *
+ * Return: void
+ */
+static void dp_reo_qdesc_cache_destroy(struct dp_soc *soc)
+{
+	struct reo_qdesc_cache_node *desc;
+
+	qdf_spin_lock_bh(&soc->reo_qdesc_cache_lock);
+	soc->reo_qdesc_cache_init = false;
+	while (qdf_list_remove_front(&soc->reo_qdesc_cache,
+	       (qdf_list_node_t **)&desc) == QDF_STATUS_SUCCESS) {
+		qdf_mem_unmap_nbytes_single(soc->osdev,
+					    desc->hw_qdesc_paddr,
+					    QDF_DMA_BIDIRECTIONAL,
+					    desc->hw_qdesc_alloc_size);
+		qdf_mem_free(desc->hw_qdesc_vaddr_unaligned);
+		qdf_mem_free(desc);
+	}
+	qdf_spin_unlock_bh(&soc->reo_qdesc_cache_lock);
+
+	qdf_list_destroy(&soc->reo_qdesc_cache);
+	qdf_spinlock_destroy(&soc->reo_qdesc_cache_lock);
+}
+#else
+static inline void dp_reo_qdesc_cache_create(struct dp_soc *soc)
+{
+}
+
+static inline void dp_reo_qdesc_cache_destroy(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_REO_QDESC_CACHE */
+
 /**
  * dp_soc_reset_txrx_ring_map() - reset tx ring map
  * @soc: DP SOC handle
@@ -2340,6 +2457,7 @@ void dp_soc_deinit(void *txrx_soc)
 
 	dp_reo_desc_freelist_destroy(soc);
 	dp_reo_desc_deferred_freelist_destroy(soc);
+	dp_reo_qdesc_cache_destroy(soc);
 
 	DEINIT_RX_HW_STATS_LOCK(soc);
 
@@ -3618,6 +3736,7 @@ void *dp_soc_init(struct dp_soc *soc, HTC_HANDLE htc_handle,
 	soc->rx.flags.defrag_timeout_check =
 		wlan_cfg_get_defrag_timeout_check(soc->wlan_cfg_ctx);
 	qdf_spinlock_create(&soc->rx.defrag.defrag_lock);
+	qdf_atomic_init(&soc->rx.defrag.pending_frags);
 
 	dp_monitor_soc_init(soc);
 
@@ -3645,6 +3764,7 @@ void *dp_soc_init(struct dp_soc *soc, HTC_HANDLE htc_handle,
 	qdf_create_work(0, &soc->htt_stats.work, htt_t2h_stats_handler, soc);
 
 	dp_reo_desc_deferred_freelist_create(soc);
+	dp_reo_qdesc_cache_create(soc);
 
 	dp_info("Mem stats: DMA = %u HEAP = %u SKB = %u",
 		qdf_dma_mem_stats_read(),
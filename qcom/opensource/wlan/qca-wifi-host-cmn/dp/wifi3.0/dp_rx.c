@@ -3541,3 +3541,34 @@ bool dp_rx_multipass_process(struct dp_txrx_peer *txrx_peer, qdf_nbuf_t nbuf,
 	return true;
 }
 #endif /* QCA_MULTIPASS_SUPPORT */
+
+#ifdef WLAN_DP_RX_REAP_PROFILE
+void dp_rx_reap_prof_print(struct dp_soc *soc)
+{
+	struct dp_rx_reap_prof *prof;
+	uint8_t ring;
+	uint8_t bucket;
+
+	DP_PRINT_STATS("Rx reap loop profile per ring:");
+	for (ring = 0; ring < MAX_REO_DEST_RINGS; ring++) {
+		prof = &soc->rx_reap_prof[ring];
+		if (!prof->reaps)
+			continue;
+
+		DP_PRINT_STATS("Ring %u: reaps %llu msdus %llu msdus/reap %llu",
+			       ring, prof->reaps, prof->msdus,
+			       qdf_do_div64(prof->msdus, prof->reaps));
+		DP_PRINT_STATS("Ring %u: reap ns/msdu %llu total ns/msdu %llu max reap ns %llu",
+			       ring, qdf_do_div64(prof->reap_ns, prof->msdus),
+			       qdf_do_div64(prof->total_ns, prof->msdus),
+			       prof->max_ns);
+		for (bucket = 0; bucket < DP_RX_REAP_PROF_BUCKETS; bucket++) {
+			if (!prof->batch_hist[bucket])
+				continue;
+			DP_PRINT_STATS("Ring %u: batch %u-%u: %llu", ring,
+				       1 << bucket, (2 << bucket) - 1,
+				       prof->batch_hist[bucket]);
+		}
+	}
+}
+#endif
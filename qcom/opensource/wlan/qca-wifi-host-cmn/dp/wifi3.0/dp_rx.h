@@ -1287,10 +1287,13 @@ int dp_check_paddr(struct dp_soc *dp_soc,
 			 *.Add such buffer to invalid list and free
 			 *.them when driver unload.
 			 **/
-			qdf_nbuf_unmap_nbytes_single(dp_soc->osdev,
-						     *rx_netbuf,
-						     QDF_DMA_FROM_DEVICE,
-						     rx_desc_pool->buf_size);
+			if (!qdf_nbuf_page_pool_unmap(dp_soc->osdev,
+						      *rx_netbuf,
+						      rx_desc_pool->buf_size))
+				qdf_nbuf_unmap_nbytes_single(dp_soc->osdev,
+							     *rx_netbuf,
+							     QDF_DMA_FROM_DEVICE,
+							     rx_desc_pool->buf_size);
 			qdf_nbuf_queue_add(&dp_soc->invalid_buf_queue,
 					   *rx_netbuf);
 		}
@@ -1323,10 +1326,12 @@ int dp_check_paddr(struct dp_soc *dp_soc,
 	} while (nbuf_retry < MAX_RETRY);
 
 	if ((*rx_netbuf)) {
-		qdf_nbuf_unmap_nbytes_single(dp_soc->osdev,
-					     *rx_netbuf,
-					     QDF_DMA_FROM_DEVICE,
-					     rx_desc_pool->buf_size);
+		if (!qdf_nbuf_page_pool_unmap(dp_soc->osdev, *rx_netbuf,
+					      rx_desc_pool->buf_size))
+			qdf_nbuf_unmap_nbytes_single(dp_soc->osdev,
+						     *rx_netbuf,
+						     QDF_DMA_FROM_DEVICE,
+						     rx_desc_pool->buf_size);
 		qdf_nbuf_queue_add(&dp_soc->invalid_buf_queue,
 				   *rx_netbuf);
 	}
@@ -2778,6 +2783,14 @@ void dp_rx_nbuf_unmap(struct dp_soc *soc,
 	rx_desc_pool = &soc->rx_desc_buf[rx_desc->pool_id];
 	dp_ipa_reo_ctx_buf_mapping_lock(soc, reo_ring_num);
 
+	/* page pool nbufs skip the smmu maps, the pool keeps the dma map */
+	if (qdf_nbuf_page_pool_unmap(soc->osdev, rx_desc->nbuf,
+				     rx_desc_pool->buf_size)) {
+		rx_desc->unmapped = 1;
+		dp_ipa_reo_ctx_buf_mapping_unlock(soc, reo_ring_num);
+		return;
+	}
+
 	dp_audio_smmu_unmap(soc->osdev,
 			    QDF_NBUF_CB_PADDR(rx_desc->nbuf),
 			    rx_desc_pool->buf_size);
@@ -2798,6 +2811,10 @@ void dp_rx_nbuf_unmap_pool(struct dp_soc *soc,
 			   struct rx_desc_pool *rx_desc_pool,
 			   qdf_nbuf_t nbuf)
 {
+	if (qdf_nbuf_page_pool_unmap(soc->osdev, nbuf,
+				     rx_desc_pool->buf_size))
+		return;
+
 	dp_audio_smmu_unmap(soc->osdev, QDF_NBUF_CB_PADDR(nbuf),
 			    rx_desc_pool->buf_size);
 	dp_ipa_handle_rx_buf_smmu_mapping(soc, nbuf,
@@ -2832,6 +2849,96 @@ void dp_rx_nbuf_free(qdf_nbuf_t nbuf)
 }
 #endif
 
+#ifdef WLAN_DP_RX_REAP_PROFILE
+/**
+ * dp_rx_reap_prof_ts() - Get timestamp for rx reap loop profiling
+ *
+ * Return: timestamp in ns
+ */
+static inline uint64_t dp_rx_reap_prof_ts(void)
+{
+	return qdf_sched_clock();
+}
+
+/**
+ * dp_rx_reap_prof_update() - Account one iteration of the rx reap loop
+ * @soc: core txrx main context
+ * @ring_id: REO destination ring id
+ * @start_ts: timestamp taken before ring access start
+ * @reap_end_ts: timestamp taken after ring access end
+ * @num_reaped: number of buffers reaped in this iteration
+ *
+ * Called once per reap iteration after the reaped MSDUs are handed to
+ * the stack, so that the per-MSDU cost includes processing and delivery.
+ *
+ * Return: None
+ */
+static inline void dp_rx_reap_prof_update(struct dp_soc *soc, uint8_t ring_id,
+					  uint64_t start_ts,
+					  uint64_t reap_end_ts,
+					  uint32_t num_reaped)
+{
+	struct dp_rx_reap_prof *prof = &soc->rx_reap_prof[ring_id];
+	uint64_t total_ns;
+	uint8_t bucket;
+
+	if (!num_reaped)
+		return;
+
+	total_ns = dp_rx_reap_prof_ts() - start_ts;
+	bucket = qdf_fls(num_reaped) - 1;
+	if (bucket >= DP_RX_REAP_PROF_BUCKETS)
+		bucket = DP_RX_REAP_PROF_BUCKETS - 1;
+
+	prof->reaps++;
+	prof->msdus += num_reaped;
+	prof->reap_ns += reap_end_ts - start_ts;
+	prof->total_ns += total_ns;
+	if (total_ns > prof->max_ns)
+		prof->max_ns = total_ns;
+	prof->batch_hist[bucket]++;
+}
+
+/**
+ * dp_rx_reap_prof_print() - Print rx reap loop profile for all REO rings
+ * @soc: core txrx main context
+ *
+ * Return: None
+ */
+void dp_rx_reap_prof_print(struct dp_soc *soc);
+
+/**
+ * dp_rx_reap_prof_clear() - Reset rx reap loop profile for all REO rings
+ * @soc: core txrx main context
+ *
+ * Return: None
+ */
+static inline void dp_rx_reap_prof_clear(struct dp_soc *soc)
+{
+	qdf_mem_zero(soc->rx_reap_prof, sizeof(soc->rx_reap_prof));
+}
+#else
+static inline uint64_t dp_rx_reap_prof_ts(void)
+{
+	return 0;
+}
+
+static inline void dp_rx_reap_prof_update(struct dp_soc *soc, uint8_t ring_id,
+					  uint64_t start_ts,
+					  uint64_t reap_end_ts,
+					  uint32_t num_reaped)
+{
+}
+
+static inline void dp_rx_reap_prof_print(struct dp_soc *soc)
+{
+}
+
+static inline void dp_rx_reap_prof_clear(struct dp_soc *soc)
+{
+}
+#endif /* WLAN_DP_RX_REAP_PROFILE */
+
 #ifdef DP_UMAC_HW_RESET_SUPPORT
 /**
  * dp_rx_desc_reuse() - Reuse the rx descriptors to fill the rx buf ring
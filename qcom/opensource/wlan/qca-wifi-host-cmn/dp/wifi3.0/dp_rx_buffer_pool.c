@@ -101,9 +101,15 @@ void dp_rx_buffer_pool_nbuf_free(struct dp_soc *soc, qdf_nbuf_t nbuf, u8 mac_id)
 	rx_desc_pool = &soc->rx_desc_buf[mac_id];
 	buff_pool = &soc->rx_buff_pool[mac_id];
 
+	/*
+	 * A page pool nbuf goes back to its page pool, which recycles the
+	 * page with its DMA mapping. qdf_nbuf_reset() would drop PADDR and
+	 * the buffer would get mapped a second time on replenish.
+	 */
 	if (qdf_likely(qdf_nbuf_queue_head_qlen(&buff_pool->emerg_nbuf_q) >=
 		       DP_RX_BUFFER_POOL_SIZE) ||
-	    !buff_pool->is_initialized)
+	    !buff_pool->is_initialized ||
+	    qdf_nbuf_page_pool_owned(soc->osdev, nbuf))
 		return qdf_nbuf_free(nbuf);
 
 	qdf_nbuf_reset(nbuf, RX_BUFFER_RESERVATION,
@@ -111,13 +117,129 @@ void dp_rx_buffer_pool_nbuf_free(struct dp_soc *soc, qdf_nbuf_t nbuf, u8 mac_id)
 	qdf_nbuf_queue_head_enqueue_tail(&buff_pool->emerg_nbuf_q, nbuf);
 }
 
+#ifdef WLAN_DP_RX_PAGE_POOL
+/**
+ * dp_rx_refill_buff_pool_pp_init() - Create the page pool backing the RX
+ *				      refill buffer pool
+ * @soc: SoC handle
+ * @buff_pool: RX refill buffer pool
+ * @rx_desc_pool: RX descriptor pool the buffers are posted to
+ *
+ * The pages keep their DMA mapping while they are recycled between the
+ * network stack and the refill buffer pool. IPA maps rx buffers into its
+ * own SMMU context on every refill, so page pool buffers are not used
+ * with IPA.
+ *
+ * Return: None
+ */
+static void
+dp_rx_refill_buff_pool_pp_init(struct dp_soc *soc,
+			       struct rx_refill_buff_pool *buff_pool,
+			       struct rx_desc_pool *rx_desc_pool)
+{
+	buff_pool->page_pool = NULL;
+	if (wlan_cfg_is_ipa_enabled(soc->wlan_cfg_ctx))
+		return;
+
+	buff_pool->page_pool =
+		qdf_page_pool_create(soc->osdev, buff_pool->max_bufq_len,
+				     RX_BUFFER_RESERVATION +
+				     rx_desc_pool->buf_size);
+	if (buff_pool->page_pool)
+		dp_info("RX refill buffer pool is backed by a page pool");
+}
+
+static void
+dp_rx_refill_buff_pool_pp_deinit(struct rx_refill_buff_pool *buff_pool)
+{
+	qdf_page_pool_destroy(buff_pool->page_pool);
+	buff_pool->page_pool = NULL;
+}
+
+static inline qdf_nbuf_t
+dp_rx_refill_buff_pool_pp_alloc(struct rx_refill_buff_pool *buff_pool,
+				struct rx_desc_pool *rx_desc_pool)
+{
+	if (!buff_pool->page_pool)
+		return NULL;
+
+	return qdf_nbuf_page_pool_alloc(buff_pool->page_pool,
+					rx_desc_pool->buf_size,
+					RX_BUFFER_RESERVATION);
+}
+#else
+static inline void
+dp_rx_refill_buff_pool_pp_init(struct dp_soc *soc,
+			       struct rx_refill_buff_pool *buff_pool,
+			       struct rx_desc_pool *rx_desc_pool)
+{
+}
+
+static inline void
+dp_rx_refill_buff_pool_pp_deinit(struct rx_refill_buff_pool *buff_pool)
+{
+}
+
+static inline qdf_nbuf_t
+dp_rx_refill_buff_pool_pp_alloc(struct rx_refill_buff_pool *buff_pool,
+				struct rx_desc_pool *rx_desc_pool)
+{
+	return NULL;
+}
+#endif
+
+/**
+ * dp_rx_refill_buff_pool_nbuf_alloc() - Allocate a DMA mapped RX buffer
+ *					 for the RX refill buffer pool
+ * @soc: SoC handle
+ * @buff_pool: RX refill buffer pool
+ * @rx_desc_pool: RX descriptor pool the buffer is posted to
+ *
+ * Buffers come from the page pool when there is one, they are mapped
+ * already. Otherwise a buffer is allocated and mapped here.
+ *
+ * Return: nbuf or NULL on failure
+ */
+static qdf_nbuf_t
+dp_rx_refill_buff_pool_nbuf_alloc(struct dp_soc *soc,
+				  struct rx_refill_buff_pool *buff_pool,
+				  struct rx_desc_pool *rx_desc_pool)
+{
+	qdf_device_t dev = soc->osdev;
+	qdf_nbuf_t nbuf;
+	QDF_STATUS ret;
+
+	nbuf = dp_rx_refill_buff_pool_pp_alloc(buff_pool, rx_desc_pool);
+	if (!nbuf) {
+		nbuf = qdf_nbuf_alloc(dev, rx_desc_pool->buf_size,
+				      RX_BUFFER_RESERVATION,
+				      rx_desc_pool->buf_alignment, FALSE);
+		if (qdf_unlikely(!nbuf))
+			return NULL;
+
+		ret = qdf_nbuf_map_nbytes_single(dev, nbuf,
+						 QDF_DMA_FROM_DEVICE,
+						 rx_desc_pool->buf_size);
+		if (qdf_unlikely(QDF_IS_STATUS_ERROR(ret))) {
+			qdf_nbuf_free(nbuf);
+			return NULL;
+		}
+	}
+
+	dp_audio_smmu_map(dev,
+			  qdf_mem_paddr_from_dmaaddr(dev,
+						     QDF_NBUF_CB_PADDR(nbuf)),
+			  QDF_NBUF_CB_PADDR(nbuf),
+			  rx_desc_pool->buf_size);
+
+	return nbuf;
+}
+
 void dp_rx_refill_buff_pool_enqueue(struct dp_soc *soc)
 {
 	struct rx_desc_pool *rx_desc_pool;
 	struct rx_refill_buff_pool *buff_pool;
-	qdf_device_t dev;
 	qdf_nbuf_t nbuf;
-	QDF_STATUS ret;
 	int count, i;
 	uint16_t num_refill;
 	uint16_t total_num_refill;
@@ -127,7 +249,6 @@ void dp_rx_refill_buff_pool_enqueue(struct dp_soc *soc)
 	if (!soc)
 		return;
 
-	dev = soc->osdev;
 	buff_pool = &soc->rx_refill_buff_pool;
 	rx_desc_pool = &soc->rx_desc_buf[0];
 	if (!buff_pool->is_initialized)
@@ -149,27 +270,11 @@ void dp_rx_refill_buff_pool_enqueue(struct dp_soc *soc)
 
 		count = 0;
 		for (i = 0; i < num_refill; i++) {
-			nbuf = qdf_nbuf_alloc(dev, rx_desc_pool->buf_size,
-					      RX_BUFFER_RESERVATION,
-					      rx_desc_pool->buf_alignment,
-					      FALSE);
+			nbuf = dp_rx_refill_buff_pool_nbuf_alloc(soc, buff_pool,
+								 rx_desc_pool);
 			if (qdf_unlikely(!nbuf))
 				continue;
 
-			ret = qdf_nbuf_map_nbytes_single(dev, nbuf,
-							 QDF_DMA_FROM_DEVICE,
-							 rx_desc_pool->buf_size);
-			if (qdf_unlikely(QDF_IS_STATUS_ERROR(ret))) {
-				qdf_nbuf_free(nbuf);
-				continue;
-			}
-
-			dp_audio_smmu_map(dev,
-					  qdf_mem_paddr_from_dmaaddr(dev,
-								     QDF_NBUF_CB_PADDR(nbuf)),
-					  QDF_NBUF_CB_PADDR(nbuf),
-					  rx_desc_pool->buf_size);
-
 			buff_pool->buf_elem[head++] = nbuf;
 			head &= (buff_pool->max_bufq_len - 1);
 			count++;
@@ -264,6 +369,12 @@ dp_rx_buffer_pool_nbuf_map(struct dp_soc *soc,
 	QDF_STATUS ret = QDF_STATUS_SUCCESS;
 
 	if (!QDF_NBUF_CB_PADDR((nbuf_frag_info_t->virt_addr).nbuf)) {
+		/* page pool pages keep the mapping of their pool */
+		if (qdf_nbuf_page_pool_map(soc->osdev,
+					   (nbuf_frag_info_t->virt_addr).nbuf,
+					   rx_desc_pool->buf_size))
+			return ret;
+
 		ret = qdf_nbuf_map_nbytes_single(soc->osdev,
 						 (nbuf_frag_info_t->virt_addr).nbuf,
 						 QDF_DMA_FROM_DEVICE,
@@ -285,7 +396,6 @@ static void dp_rx_refill_buff_pool_init(struct dp_soc *soc, u8 mac_id)
 	struct rx_desc_pool *rx_desc_pool = &soc->rx_desc_buf[mac_id];
 	qdf_nbuf_t nbuf;
 	struct rx_refill_buff_pool *buff_pool = &soc->rx_refill_buff_pool;
-	QDF_STATUS ret;
 	uint16_t head = 0;
 	int i;
 
@@ -309,27 +419,14 @@ static void dp_rx_refill_buff_pool_init(struct dp_soc *soc, u8 mac_id)
 	buff_pool->dp_pdev = dp_get_pdev_for_lmac_id(soc, 0);
 	buff_pool->tail = 0;
 
+	dp_rx_refill_buff_pool_pp_init(soc, buff_pool, rx_desc_pool);
+
 	for (i = 0; i < (buff_pool->max_bufq_len - 1); i++) {
-		nbuf = qdf_nbuf_alloc(soc->osdev, rx_desc_pool->buf_size,
-				      RX_BUFFER_RESERVATION,
-				      rx_desc_pool->buf_alignment, FALSE);
+		nbuf = dp_rx_refill_buff_pool_nbuf_alloc(soc, buff_pool,
+							 rx_desc_pool);
 		if (!nbuf)
 			continue;
 
-		ret = qdf_nbuf_map_nbytes_single(soc->osdev, nbuf,
-						 QDF_DMA_FROM_DEVICE,
-						 rx_desc_pool->buf_size);
-		if (qdf_unlikely(QDF_IS_STATUS_ERROR(ret))) {
-			qdf_nbuf_free(nbuf);
-			continue;
-		}
-
-		dp_audio_smmu_map(soc->osdev,
-				  qdf_mem_paddr_from_dmaaddr(soc->osdev,
-							     QDF_NBUF_CB_PADDR(nbuf)),
-				  QDF_NBUF_CB_PADDR(nbuf),
-				  rx_desc_pool->buf_size);
-
 		buff_pool->buf_elem[head] = nbuf;
 		head++;
 	}
@@ -391,11 +488,18 @@ static void dp_rx_refill_buff_pool_deinit(struct dp_soc *soc, u8 mac_id)
 		return;
 
 	while ((nbuf = dp_rx_refill_buff_pool_dequeue_nbuf(soc))) {
+		if (qdf_nbuf_page_pool_unmap(soc->osdev, nbuf,
+					     rx_desc_pool->buf_size)) {
+			qdf_nbuf_free(nbuf);
+			count++;
+			continue;
+		}
+
 		dp_audio_smmu_unmap(soc->osdev,
 				    QDF_NBUF_CB_PADDR(nbuf),
 				    rx_desc_pool->buf_size);
 		qdf_nbuf_unmap_nbytes_single(soc->osdev, nbuf,
-					     QDF_DMA_BIDIRECTIONAL,
+					     QDF_DMA_FROM_DEVICE,
 					     rx_desc_pool->buf_size);
 		qdf_nbuf_free(nbuf);
 		count++;
@@ -404,6 +508,7 @@ static void dp_rx_refill_buff_pool_deinit(struct dp_soc *soc, u8 mac_id)
 	dp_info("Rx refill buffers freed during deinit %u head: %u, tail: %u",
 		count, buff_pool->head, buff_pool->tail);
 
+	dp_rx_refill_buff_pool_pp_deinit(buff_pool);
 	qdf_mem_free(buff_pool->buf_elem);
 	buff_pool->is_initialized = false;
 }
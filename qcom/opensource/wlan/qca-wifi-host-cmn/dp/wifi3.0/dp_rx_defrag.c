@@ -197,6 +197,7 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 
 		TAILQ_REMOVE(&soc->rx.defrag.waitlist, waitlist_elem,
 			     defrag_waitlist_elem);
+		waitlist_elem->on_waitlist = false;
 		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
 
 		/* Move to temp list and clean-up later */
@@ -249,14 +250,25 @@ void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
 	dp_debug("Adding TID %u to waitlist for peer %pK with peer_id = %d ",
 		 tid, txrx_peer, txrx_peer->peer_id);
 
-	/* TODO: use LIST macros instead of TAIL macros */
+	/*
+	 * All entries share the same timeout, so appending at the tail keeps
+	 * the waitlist sorted by expiry and the flush only has to look at
+	 * the head. A TID re-armed for a new sequence is moved to the tail.
+	 */
 	qdf_spin_lock_bh(&psoc->rx.defrag.defrag_lock);
+	if (waitlist_elem->on_waitlist) {
+		TAILQ_REMOVE(&psoc->rx.defrag.waitlist, waitlist_elem,
+			     defrag_waitlist_elem);
+		DP_STATS_DEC(psoc, rx.rx_frag_wait, 1);
+	}
+
 	if (TAILQ_EMPTY(&psoc->rx.defrag.waitlist))
 		psoc->rx.defrag.next_flush_ms =
 			waitlist_elem->defrag_timeout_ms;
 
 	TAILQ_INSERT_TAIL(&psoc->rx.defrag.waitlist, waitlist_elem,
 			  defrag_waitlist_elem);
+	waitlist_elem->on_waitlist = true;
 	DP_STATS_INC(psoc, rx.rx_frag_wait, 1);
 	qdf_spin_unlock_bh(&psoc->rx.defrag.defrag_lock);
 }
@@ -267,7 +279,6 @@ void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *txrx_peer,
 	struct dp_pdev *pdev = txrx_peer->vdev->pdev;
 	struct dp_soc *soc = pdev->soc;
 	struct dp_rx_tid_defrag *waitlist_elm;
-	struct dp_rx_tid_defrag *tmp;
 
 	dp_debug("Removing TID %u to waitlist for peer %pK peer_id = %d ",
 		 tid, txrx_peer, txrx_peer->peer_id);
@@ -277,35 +288,46 @@ void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *txrx_peer,
 		qdf_assert_always(0);
 	}
 
-	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(waitlist_elm, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		struct dp_txrx_peer *peer_on_waitlist;
+	waitlist_elm = &txrx_peer->rx_tid[tid];
 
-		/* get address of current peer */
-		peer_on_waitlist = waitlist_elm->defrag_peer;
-
-		/* Ensure it is TID for same peer */
-		if (peer_on_waitlist == txrx_peer && waitlist_elm->tid == tid) {
-			TAILQ_REMOVE(&soc->rx.defrag.waitlist,
-				     waitlist_elm, defrag_waitlist_elem);
-			DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
-		}
+	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
+	if (waitlist_elm->on_waitlist) {
+		TAILQ_REMOVE(&soc->rx.defrag.waitlist,
+			     waitlist_elm, defrag_waitlist_elem);
+		waitlist_elm->on_waitlist = false;
+		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
 	}
 	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
 }
 
+/**
+ * dp_rx_defrag_frag_bitmap_reset() - Release the fragment accounting of a TID
+ * @soc: DP SOC
+ * @rx_tid: defrag state of the TID
+ *
+ * Return: None
+ */
+static void dp_rx_defrag_frag_bitmap_reset(struct dp_soc *soc,
+					   struct dp_rx_tid_defrag *rx_tid)
+{
+	if (!rx_tid->frag_bitmap)
+		return;
+
+	qdf_atomic_sub(qdf_get_hweight16(rx_tid->frag_bitmap),
+		       &soc->rx.defrag.pending_frags);
+	rx_tid->frag_bitmap = 0;
+}
+
 QDF_STATUS
 dp_rx_defrag_fraglist_insert(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 			     qdf_nbuf_t *head_addr, qdf_nbuf_t *tail_addr,
 			     qdf_nbuf_t frag, uint8_t *all_frag_present)
 {
 	struct dp_soc *soc = txrx_peer->vdev->pdev->soc;
-	qdf_nbuf_t next;
 	qdf_nbuf_t prev = NULL;
 	qdf_nbuf_t cur;
-	uint16_t head_fragno, cur_fragno, next_fragno;
-	uint8_t last_morefrag = 1, count = 0;
+	uint16_t head_fragno, cur_fragno, tail_fragno;
+	uint8_t last_morefrag = 1;
 	struct dp_rx_tid_defrag *rx_tid = &txrx_peer->rx_tid[tid];
 	uint8_t *rx_desc_info;
 
@@ -318,15 +340,29 @@ dp_rx_defrag_fraglist_insert(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 	cur_fragno = dp_rx_frag_get_mpdu_frag_number(soc, rx_desc_info);
 
 	dp_debug("cur_fragno %d", cur_fragno);
+	if (cur_fragno >= DP_RX_DEFRAG_MAX_FRAGS) {
+		dp_rx_nbuf_free(frag);
+		goto insert_fail;
+	}
+
 	/* If this is the first fragment */
 	if (!(*head_addr)) {
+		dp_rx_defrag_frag_bitmap_reset(soc, rx_tid);
 		*head_addr = *tail_addr = frag;
 		qdf_nbuf_set_next(*tail_addr, NULL);
 		rx_tid->curr_frag_num = cur_fragno;
+		rx_tid->frag_bitmap = BIT(cur_fragno);
+		qdf_atomic_inc(&soc->rx.defrag.pending_frags);
 
 		goto insert_done;
 	}
 
+	/* Duplicate fragment */
+	if (rx_tid->frag_bitmap & BIT(cur_fragno)) {
+		dp_rx_nbuf_free(frag);
+		goto insert_fail;
+	}
+
 	/* In sequence fragment */
 	if (cur_fragno > rx_tid->curr_frag_num) {
 		qdf_nbuf_set_next(*tail_addr, frag);
@@ -340,12 +376,8 @@ dp_rx_defrag_fraglist_insert(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 		head_fragno = dp_rx_frag_get_mpdu_frag_number(soc,
 							      rx_desc_info);
 
-		if (cur_fragno == head_fragno) {
-			dp_rx_nbuf_free(frag);
-			goto insert_fail;
-		} else if (head_fragno > cur_fragno) {
+		if (head_fragno > cur_fragno) {
 			qdf_nbuf_set_next(frag, cur);
-			cur = frag;
 			*head_addr = frag; /* head pointer to be updated */
 		} else {
 			while ((cur_fragno > head_fragno) && cur) {
@@ -360,43 +392,26 @@ dp_rx_defrag_fraglist_insert(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 				}
 			}
 
-			if (cur_fragno == head_fragno) {
-				dp_rx_nbuf_free(frag);
-				goto insert_fail;
-			}
-
 			qdf_nbuf_set_next(prev, frag);
 			qdf_nbuf_set_next(frag, cur);
 		}
 	}
 
-	next = qdf_nbuf_next(*head_addr);
+	rx_tid->frag_bitmap |= BIT(cur_fragno);
+	qdf_atomic_inc(&soc->rx.defrag.pending_frags);
 
 	rx_desc_info = qdf_nbuf_data(*tail_addr);
 	last_morefrag = dp_rx_frag_get_more_frag_bit(soc, rx_desc_info);
 
-	/* TODO: optimize the loop */
+	/*
+	 * The list is kept sorted, so all fragments are present once the
+	 * tail has no more-frag bit and every fragment number up to the
+	 * tail one is set in the bitmap.
+	 */
 	if (!last_morefrag) {
-		/* Check if all fragments are present */
-		do {
-			rx_desc_info = qdf_nbuf_data(next);
-			next_fragno =
-				dp_rx_frag_get_mpdu_frag_number(soc,
-								rx_desc_info);
-			count++;
-
-			if (next_fragno != count)
-				break;
-
-			next = qdf_nbuf_next(next);
-		} while (next);
-
-		if (!next) {
+		tail_fragno = rx_tid->curr_frag_num;
+		if (rx_tid->frag_bitmap == (BIT(tail_fragno + 1) - 1))
 			*all_frag_present = 1;
-			return QDF_STATUS_SUCCESS;
-		} else {
-			/* revisit */
-		}
 	}
 
 insert_done:
@@ -1592,6 +1607,8 @@ void dp_rx_defrag_cleanup(struct dp_txrx_peer *txrx_peer, unsigned int tid)
 	/* Free up saved ring descriptors */
 	dp_rx_clear_saved_desc_info(txrx_peer, tid);
 
+	dp_rx_defrag_frag_bitmap_reset(txrx_peer->vdev->pdev->soc,
+				       &txrx_peer->rx_tid[tid]);
 	txrx_peer->rx_tid[tid].defrag_timeout_ms = 0;
 	txrx_peer->rx_tid[tid].curr_frag_num = 0;
 	txrx_peer->rx_tid[tid].curr_seq_num = 0;
@@ -1995,6 +2012,13 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 			qdf_spin_unlock_bh(&rx_tid->defrag_tid_lock);
 			goto discard_frag;
 		}
+		/* Do not start a new sequence while too many are pending */
+		if (qdf_atomic_read(&soc->rx.defrag.pending_frags) >=
+		    DP_RX_DEFRAG_MAX_PENDING_FRAGS) {
+			qdf_spin_unlock_bh(&rx_tid->defrag_tid_lock);
+			DP_STATS_INC(soc, rx.rx_frag_flood_drop, 1);
+			goto discard_frag;
+		}
 		dp_debug("cur rxseq %d", rxseq);
 		/* Start of a new sequence */
 		dp_rx_defrag_cleanup(txrx_peer, tid);
@@ -33,6 +33,15 @@
 	(IEEE80211_FC0_TYPE_MASK | QDF_IEEE80211_FC0_SUBTYPE_QOS)) == \
 	(IEEE80211_FC0_TYPE_DATA | QDF_IEEE80211_FC0_SUBTYPE_QOS))
 
+/* 802.11 fragment number is 4 bits wide */
+#define DP_RX_DEFRAG_MAX_FRAGS 16
+/*
+ * Max fragments held for reassembly across all peers/TIDs of a soc.
+ * New sequences are dropped beyond this so that a fragment flood cannot
+ * pin down rx buffers until the waitlist timeout.
+ */
+#define DP_RX_DEFRAG_MAX_PENDING_FRAGS 1024
+
 #define UNI_DESC_OWNER_SW 0x1
 #define UNI_DESC_BUF_TYPE_RX_MSDU_LINK 0x6
 /**
@@ -188,6 +188,12 @@ static void dp_rx_desc_nbuf_cleanup(struct dp_soc *soc,
 	while (nbuf) {
 		next = nbuf->next;
 
+		if (qdf_nbuf_page_pool_unmap(soc->osdev, nbuf, buf_size)) {
+			dp_rx_nbuf_free(nbuf);
+			nbuf = next;
+			continue;
+		}
+
 		if (!is_mon_pool)
 			dp_audio_smmu_unmap(soc->osdev,
 					    QDF_NBUF_CB_PADDR(nbuf),
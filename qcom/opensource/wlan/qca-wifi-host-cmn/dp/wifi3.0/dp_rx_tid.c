@@ -396,6 +396,110 @@ dp_rx_tid_update_wifi3(struct dp_peer *peer, int tid, uint32_t ba_window_size,
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DP_REO_QDESC_CACHE
+/**
+ * dp_reo_qdesc_cache_get() - take a mapped REO QDESC of the required size
+ *			      from the soc cache
+ * @soc: Datapath soc handle
+ * @rx_tid: rx tid whose hw_qdesc_alloc_size is set; the descriptor
+ *	    addresses are filled on success
+ *
+ * Return: true if a cached descriptor is handed out, else false
+ */
+static bool dp_reo_qdesc_cache_get(struct dp_soc *soc,
+				   struct dp_rx_tid *rx_tid)
+{
+	struct reo_qdesc_cache_node *desc;
+	bool found = false;
+
+	qdf_spin_lock_bh(&soc->reo_qdesc_cache_lock);
+	if (!soc->reo_qdesc_cache_init)
+		goto unlock;
+
+	qdf_list_for_each(&soc->reo_qdesc_cache, desc, node) {
+		if (desc->hw_qdesc_alloc_size != rx_tid->hw_qdesc_alloc_size)
+			continue;
+
+		qdf_list_remove_node(&soc->reo_qdesc_cache, &desc->node);
+		found = true;
+		DP_STATS_INC(soc, rx.reo_qdesc_cache_hit, 1);
+		break;
+	}
+unlock:
+	qdf_spin_unlock_bh(&soc->reo_qdesc_cache_lock);
+
+	if (!found)
+		return false;
+
+	rx_tid->hw_qdesc_vaddr_unaligned = desc->hw_qdesc_vaddr_unaligned;
+	rx_tid->hw_qdesc_vaddr_aligned = desc->hw_qdesc_vaddr_aligned;
+	rx_tid->hw_qdesc_paddr = desc->hw_qdesc_paddr;
+	qdf_mem_free(desc);
+
+	return true;
+}
+
+/**
+ * dp_reo_qdesc_cache_put() - keep a REO QDESC no longer referenced by HW
+ *			      mapped in the soc cache
+ * @soc: Datapath soc handle
+ * @vaddr_unaligned: allocated address of the descriptor
+ * @paddr: DMA address of the descriptor
+ * @alloc_size: mapped size of the descriptor
+ *
+ * Descriptors are not cached when freed descriptor tracking is enabled
+ * through qref_control_size, as it expects them to stay out of use.
+ *
+ * Return: true if cached, else false and the caller has to unmap and free
+ */
+static bool dp_reo_qdesc_cache_put(struct dp_soc *soc, void *vaddr_unaligned,
+				   qdf_dma_addr_t paddr, uint32_t alloc_size)
+{
+	struct reo_qdesc_cache_node *desc;
+
+	if (soc->wlan_cfg_ctx->qref_control_size)
+		return false;
+
+	desc = qdf_mem_malloc(sizeof(*desc));
+	if (!desc)
+		return false;
+
+	desc->hw_qdesc_vaddr_unaligned = vaddr_unaligned;
+	desc->hw_qdesc_vaddr_aligned =
+		(void *)qdf_align((unsigned long)vaddr_unaligned,
+				  hal_get_reo_qdesc_align(soc->hal_soc));
+	desc->hw_qdesc_paddr = paddr;
+	desc->hw_qdesc_alloc_size = alloc_size;
+
+	qdf_spin_lock_bh(&soc->reo_qdesc_cache_lock);
+	if (!soc->reo_qdesc_cache_init ||
+	    qdf_list_size(&soc->reo_qdesc_cache) >= REO_QDESC_CACHE_SIZE) {
+		qdf_spin_unlock_bh(&soc->reo_qdesc_cache_lock);
+		qdf_mem_free(desc);
+		return false;
+	}
+	qdf_list_insert_front(&soc->reo_qdesc_cache, &desc->node);
+	DP_STATS_INC(soc, rx.reo_qdesc_cache_put, 1);
+	qdf_spin_unlock_bh(&soc->reo_qdesc_cache_lock);
+
+	return true;
+}
+#else
+static inline bool dp_reo_qdesc_cache_get(struct dp_soc *soc,
+					  struct dp_rx_tid *rx_tid)
+{
+	return false;
+}
+
+static inline bool dp_reo_qdesc_cache_put(struct dp_soc *soc,
+					  void *vaddr_unaligned,
+					  qdf_dma_addr_t paddr,
+					  uint32_t alloc_size)
+{
+	return false;
+}
+#endif /* WLAN_DP_REO_QDESC_CACHE */
+
 #ifdef WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY
 /**
  * dp_reo_desc_defer_free_enqueue() - enqueue REO QDESC to be freed into
@@ -459,11 +563,16 @@ static void dp_reo_desc_defer_free(struct dp_soc *soc)
 
 		DP_RX_REO_QDESC_DEFERRED_FREE_EVT(desc);
 
-		qdf_mem_unmap_nbytes_single(soc->osdev,
+		if (!dp_reo_qdesc_cache_put(soc,
+					    desc->hw_qdesc_vaddr_unaligned,
 					    desc->hw_qdesc_paddr,
-					    QDF_DMA_BIDIRECTIONAL,
-					    desc->hw_qdesc_alloc_size);
-		qdf_mem_free(desc->hw_qdesc_vaddr_unaligned);
+					    desc->hw_qdesc_alloc_size)) {
+			qdf_mem_unmap_nbytes_single(soc->osdev,
+						    desc->hw_qdesc_paddr,
+						    QDF_DMA_BIDIRECTIONAL,
+						    desc->hw_qdesc_alloc_size);
+			qdf_mem_free(desc->hw_qdesc_vaddr_unaligned);
+		}
 		qdf_mem_free(desc);
 
 		curr_ts = qdf_get_system_timestamp();
@@ -526,6 +635,7 @@ static void dp_reo_desc_free(struct dp_soc *soc, void *cb_ctxt,
 		(struct reo_desc_list_node *)cb_ctxt;
 	struct dp_rx_tid *rx_tid = &freedesc->rx_tid;
 	unsigned long curr_ts = qdf_get_system_timestamp();
+	bool flushed = true;
 
 	if ((reo_status->fl_cache_status.header.status !=
 		HAL_REO_CMD_SUCCESS) &&
@@ -534,6 +644,7 @@ static void dp_reo_desc_free(struct dp_soc *soc, void *cb_ctxt,
 		dp_peer_err("%pK: Rx tid HW desc flush failed(%d): tid %d",
 			    soc, reo_status->rx_queue_status.header.status,
 			    freedesc->rx_tid.tid);
+		flushed = false;
 	}
 	dp_peer_info("%pK: %lu hw_qdesc_paddr: %pK, tid:%d", soc,
 		     curr_ts, (void *)(rx_tid->hw_qdesc_paddr),
@@ -549,11 +660,18 @@ static void dp_reo_desc_free(struct dp_soc *soc, void *cb_ctxt,
 	add_entry_free_list(soc, rx_tid);
 
 	hal_reo_shared_qaddr_cache_clear(soc->hal_soc);
+	check_free_list_for_invalid_flush(soc);
+	/* HW may still hold a stale copy of an unflushed desc, never reuse it */
+	if (flushed &&
+	    dp_reo_qdesc_cache_put(soc, rx_tid->hw_qdesc_vaddr_unaligned,
+				   rx_tid->hw_qdesc_paddr,
+				   rx_tid->hw_qdesc_alloc_size))
+		goto out;
+
 	qdf_mem_unmap_nbytes_single(soc->osdev,
 				    rx_tid->hw_qdesc_paddr,
 				    QDF_DMA_BIDIRECTIONAL,
 				    rx_tid->hw_qdesc_alloc_size);
-	check_free_list_for_invalid_flush(soc);
 
 	*(uint32_t *)rx_tid->hw_qdesc_vaddr_unaligned = 0;
 	qdf_mem_free(rx_tid->hw_qdesc_vaddr_unaligned);
@@ -592,14 +710,24 @@ dp_rx_tid_setup_error_process(uint32_t tid_bitmap, struct dp_peer *peer)
 		if (!rx_tid->hw_qdesc_vaddr_unaligned)
 			continue;
 
-		if (dp_reo_desc_addr_chk(rx_tid->hw_qdesc_paddr) ==
-		    QDF_STATUS_SUCCESS)
+		/* hw_qdesc_paddr is cleared when the desc failed to map */
+		if (rx_tid->hw_qdesc_paddr &&
+		    dp_reo_desc_addr_chk(rx_tid->hw_qdesc_paddr) ==
+		    QDF_STATUS_SUCCESS) {
+			if (dp_reo_qdesc_cache_put(soc,
+					rx_tid->hw_qdesc_vaddr_unaligned,
+					rx_tid->hw_qdesc_paddr,
+					rx_tid->hw_qdesc_alloc_size))
+				goto reset;
+
 			qdf_mem_unmap_nbytes_single(
 				soc->osdev,
 				rx_tid->hw_qdesc_paddr,
 				QDF_DMA_BIDIRECTIONAL,
 				rx_tid->hw_qdesc_alloc_size);
+		}
 		qdf_mem_free(rx_tid->hw_qdesc_vaddr_unaligned);
+reset:
 		rx_tid->hw_qdesc_vaddr_unaligned = NULL;
 		rx_tid->hw_qdesc_paddr = 0;
 	}
@@ -619,6 +747,8 @@ dp_single_rx_tid_setup(struct dp_peer *peer, int tid,
 	uint32_t alloc_tries = 0, ret;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 	struct dp_txrx_peer *txrx_peer;
+	uint64_t setup_ts = qdf_get_log_timestamp_usecs();
+	bool cached;
 
 	rx_tid->delba_tx_status = 0;
 	rx_tid->ppdu_id_2k = 0;
@@ -648,6 +778,15 @@ dp_single_rx_tid_setup(struct dp_peer *peer, int tid,
 	 */
 	rx_tid->hw_qdesc_alloc_size = hw_qdesc_size;
 
+	/* Descriptors of departed peers are kept mapped, reuse one of them
+	 * to skip the allocation and DMA mapping.
+	 */
+	cached = dp_reo_qdesc_cache_get(soc, rx_tid);
+	if (cached) {
+		hw_qdesc_vaddr = rx_tid->hw_qdesc_vaddr_aligned;
+		goto qdesc_init;
+	}
+
 try_desc_alloc:
 	rx_tid->hw_qdesc_vaddr_unaligned =
 		qdf_mem_malloc(rx_tid->hw_qdesc_alloc_size);
@@ -687,6 +826,7 @@ try_desc_alloc:
 	}
 	rx_tid->hw_qdesc_vaddr_aligned = hw_qdesc_vaddr;
 
+qdesc_init:
 	txrx_peer = dp_get_txrx_peer(peer);
 
 	/* TODO: Ensure that sec_type is set before ADDBA is received.
@@ -716,6 +856,15 @@ try_desc_alloc:
 		hw_qdesc_vaddr, rx_tid->hw_qdesc_paddr, hal_pn_type,
 		vdev->vdev_stats_id);
 
+	if (cached) {
+		qdf_mem_dma_sync_single_for_device(soc->osdev,
+						   rx_tid->hw_qdesc_paddr,
+						   rx_tid->hw_qdesc_alloc_size,
+						   QDF_DMA_BIDIRECTIONAL);
+		add_entry_alloc_list(soc, rx_tid, peer, hw_qdesc_vaddr);
+		goto done;
+	}
+
 	ret = qdf_mem_map_nbytes_single(soc->osdev, hw_qdesc_vaddr,
 					QDF_DMA_BIDIRECTIONAL,
 					rx_tid->hw_qdesc_alloc_size,
@@ -723,6 +872,8 @@ try_desc_alloc:
 
 	if (!ret)
 		add_entry_alloc_list(soc, rx_tid, peer, hw_qdesc_vaddr);
+	else
+		rx_tid->hw_qdesc_paddr = 0;
 
 	if (dp_reo_desc_addr_chk(rx_tid->hw_qdesc_paddr) !=
 			QDF_STATUS_SUCCESS || ret) {
@@ -738,6 +889,11 @@ try_desc_alloc:
 		}
 	}
 
+done:
+	DP_STATS_INC(soc, rx.reo_qdesc_setup, 1);
+	DP_STATS_INC(soc, rx.reo_qdesc_setup_us,
+		     qdf_get_log_timestamp_usecs() - setup_ts);
+
 	return QDF_STATUS_SUCCESS;
 
 error:
@@ -1199,6 +1355,8 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 			rx_tid_defrag->defrag_timeout_ms = 0;
 			rx_tid_defrag->defrag_waitlist_elem.tqe_next = NULL;
 			rx_tid_defrag->defrag_waitlist_elem.tqe_prev = NULL;
+			rx_tid_defrag->on_waitlist = false;
+			rx_tid_defrag->frag_bitmap = 0;
 			rx_tid_defrag->base.head = NULL;
 			rx_tid_defrag->base.tail = NULL;
 			rx_tid_defrag->tid = tid;
@@ -1241,6 +1399,8 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 		rx_tid_defrag->defrag_timeout_ms = 0;
 		rx_tid_defrag->defrag_waitlist_elem.tqe_next = NULL;
 		rx_tid_defrag->defrag_waitlist_elem.tqe_prev = NULL;
+		rx_tid_defrag->on_waitlist = false;
+		rx_tid_defrag->frag_bitmap = 0;
 		rx_tid_defrag->defrag_peer = peer->txrx_peer;
 	}
 }
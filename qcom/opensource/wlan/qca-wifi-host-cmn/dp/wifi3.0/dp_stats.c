@@ -21,6 +21,7 @@
 #include "dp_peer.h"
 #include "dp_types.h"
 #include "dp_tx.h"
+#include "dp_tx_desc.h"
 #include "dp_internal.h"
 #include "htt_stats.h"
 #include "htt_ppdu_stats.h"
@@ -6024,6 +6025,44 @@ dp_print_wbm2sw_ring_stats_from_hal(struct dp_pdev *pdev)
 }
 #endif
 
+#if defined(WLAN_DP_TX_DESC_PCPU_CACHE) && \
+	!defined(QCA_LL_TX_FLOW_CONTROL_V2)
+/**
+ * dp_print_tx_desc_pcpu_cache_stats() - Print per-CPU Tx desc cache stats
+ * @soc: DP soc handle
+ *
+ * Return: None
+ */
+static void dp_print_tx_desc_pcpu_cache_stats(struct dp_soc *soc)
+{
+	struct dp_tx_desc_pool_s *tx_desc_pool;
+	struct dp_tx_desc_pcpu_cache *cache;
+	uint8_t desc_pool_id;
+	int cpu;
+
+	DP_PRINT_STATS("Tx desc per-CPU cache (hit/miss/flush/steal/cached):");
+	for (desc_pool_id = 0;
+	     desc_pool_id < wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
+	     desc_pool_id++) {
+		tx_desc_pool = dp_get_tx_desc_pool(soc, desc_pool_id);
+		for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+			cache = &tx_desc_pool->pcpu_cache[cpu];
+			if (!cache->hit && !cache->miss && !cache->count)
+				continue;
+
+			DP_PRINT_STATS("	pool %u cpu %d: %u %u %u %u %u",
+				       desc_pool_id, cpu, cache->hit,
+				       cache->miss, cache->flush,
+				       cache->steal, cache->count);
+		}
+	}
+}
+#else
+static inline void dp_print_tx_desc_pcpu_cache_stats(struct dp_soc *soc)
+{
+}
+#endif
+
 /*
  * Format is:
  * [0 18 1728, 1 15 1222, 2 24 1969,...]
@@ -6135,6 +6174,8 @@ static inline void dp_print_tx_ring_stats(struct dp_soc *soc)
 			       soc->stats.tx.tcl_enq[i]);
 		DP_PRINT_STATS("TX completions reaped from ring %u: %u",
 			       i, soc->stats.tx.tx_comp[i]);
+		DP_PRINT_STATS("Batched HP updates to SW2TCL%u: %u", i + 1,
+			       soc->stats.tx.tcl_batch_doorbell[i]);
 	}
 }
 
@@ -6248,7 +6289,7 @@ void dp_print_soc_tx_stats(struct dp_soc *soc)
 	     desc_pool_id++) {
 		tx_desc_pool = dp_get_tx_desc_pool(soc, desc_pool_id);
 		soc->stats.tx.desc_in_use +=
-			tx_desc_pool->num_allocated;
+			dp_tx_desc_pool_get_num_allocated(tx_desc_pool);
 		tx_desc_pool = dp_get_spcl_tx_desc_pool(soc, desc_pool_id);
 		soc->stats.tx.desc_in_use +=
 			tx_desc_pool->num_allocated;
@@ -6256,6 +6297,7 @@ void dp_print_soc_tx_stats(struct dp_soc *soc)
 
 	DP_PRINT_STATS("Tx Descriptors In Use = %u",
 		       soc->stats.tx.desc_in_use);
+	dp_print_tx_desc_pcpu_cache_stats(soc);
 	DP_PRINT_STATS("Tx Invalid peer:");
 	DP_PRINT_STATS("	Packets = %llu",
 		       soc->stats.tx.tx_invalid_peer.num);
@@ -6450,10 +6492,12 @@ void dp_print_soc_tx_stats(struct dp_soc *soc)
 	     desc_pool_id < wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
 	     desc_pool_id++)
 		soc->stats.tx.desc_in_use +=
-			soc->tx_desc[desc_pool_id].num_allocated;
+			dp_tx_desc_pool_get_num_allocated(
+					&soc->tx_desc[desc_pool_id]);
 
 	DP_PRINT_STATS("Tx Descriptors In Use = %u",
 		       soc->stats.tx.desc_in_use);
+	dp_print_tx_desc_pcpu_cache_stats(soc);
 	DP_PRINT_STATS("Tx Invalid peer:");
 	DP_PRINT_STATS("	Packets = %llu",
 		       soc->stats.tx.tx_invalid_peer.num);
@@ -6840,6 +6884,30 @@ static void dp_print_jitter_stats(struct dp_peer *peer, struct dp_pdev *pdev)
 #endif /* WLAN_PEER_JITTER */
 
 #ifdef QCA_PEER_EXT_STATS
+#ifdef DP_HIST_PERCENTILE
+/**
+ * dp_print_hist_percentiles() - Print the percentiles of a delay histogram
+ * @hstats: Histogram stats
+ *
+ * Return: void
+ */
+static void dp_print_hist_percentiles(struct cdp_hist_stats *hstats)
+{
+	if (!hstats->hdr)
+		return;
+
+	DP_PRINT_STATS("P50 = %u P90 = %u P99 = %u P99.9 = %u\n",
+		       hstats->hdr->pct[CDP_HIST_P50],
+		       hstats->hdr->pct[CDP_HIST_P90],
+		       hstats->hdr->pct[CDP_HIST_P99],
+		       hstats->hdr->pct[CDP_HIST_P999]);
+}
+#else
+static inline void dp_print_hist_percentiles(struct cdp_hist_stats *hstats)
+{
+}
+#endif
+
 /**
  * dp_print_hist_stats() - Print delay histogram
  * @hstats: Histogram stats
@@ -6881,6 +6949,7 @@ static void dp_print_hist_stats(struct cdp_hist_stats *hstats,
 		DP_PRINT_STATS("Min = %u", hstats->min);
 		DP_PRINT_STATS("Max = %u", hstats->max);
 		DP_PRINT_STATS("Avg = %u\n", hstats->avg);
+		dp_print_hist_percentiles(hstats);
 	}
 }
 
@@ -6951,6 +7020,9 @@ static void dp_accumulate_delay_tid_stats(struct dp_soc *soc,
 {
 	uint8_t ring_id;
 
+	/* frequency buckets are derived per histogram type */
+	dst_hstats->hist.hist_type = mode;
+
 	if (wlan_cfg_get_dp_soc_nss_cfg(soc->wlan_cfg_ctx)) {
 		struct cdp_delay_tid_stats *dstats =
 				&stats[tid][0];
@@ -6973,6 +7045,7 @@ static void dp_accumulate_delay_tid_stats(struct dp_soc *soc,
 		if (src_hstats)
 			dp_copy_hist_stats(src_hstats, dst_hstats);
 
+		dp_hist_compute_percentiles(dst_hstats);
 		return;
 	}
 
@@ -6998,6 +7071,8 @@ static void dp_accumulate_delay_tid_stats(struct dp_soc *soc,
 		if (src_hstats)
 			dp_accumulate_hist_stats(src_hstats, dst_hstats);
 	}
+
+	dp_hist_compute_percentiles(dst_hstats);
 }
 
 /**
@@ -7013,6 +7088,7 @@ static void dp_peer_print_tx_delay_stats(struct dp_pdev *pdev,
 	struct dp_peer_delay_stats *delay_stats;
 	struct dp_soc *soc = NULL;
 	struct cdp_hist_stats hist_stats;
+	struct cdp_hist_hdr *hist_hdr;
 	uint8_t tid;
 
 	if (!peer || !peer->txrx_peer)
@@ -7029,10 +7105,12 @@ static void dp_peer_print_tx_delay_stats(struct dp_pdev *pdev,
 	if (!delay_stats)
 		return;
 
+	hist_hdr = dp_hist_hdr_alloc();
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		DP_PRINT_STATS("----TID: %d----", tid);
 		DP_PRINT_STATS("Software Enqueue Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_SW_ENQEUE_DELAY);
+		dp_hist_set_hdr(&hist_stats, hist_hdr);
 		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
 					      &hist_stats, tid,
 					      CDP_HIST_TYPE_SW_ENQEUE_DELAY);
@@ -7040,11 +7118,13 @@ static void dp_peer_print_tx_delay_stats(struct dp_pdev *pdev,
 
 		DP_PRINT_STATS("Hardware Transmission Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_HW_COMP_DELAY);
+		dp_hist_set_hdr(&hist_stats, hist_hdr);
 		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
 					      &hist_stats, tid,
 					      CDP_HIST_TYPE_HW_COMP_DELAY);
 		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_HW_COMP_DELAY);
 	}
+	dp_hist_hdr_free(hist_hdr);
 }
 
 /**
@@ -7060,6 +7140,7 @@ static void dp_peer_print_rx_delay_stats(struct dp_pdev *pdev,
 	struct dp_peer_delay_stats *delay_stats;
 	struct dp_soc *soc = NULL;
 	struct cdp_hist_stats hist_stats;
+	struct cdp_hist_hdr *hist_hdr;
 	uint8_t tid;
 
 	if (!peer || !peer->txrx_peer)
@@ -7076,15 +7157,18 @@ static void dp_peer_print_rx_delay_stats(struct dp_pdev *pdev,
 	if (!delay_stats)
 		return;
 
+	hist_hdr = dp_hist_hdr_alloc();
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		DP_PRINT_STATS("----TID: %d----", tid);
 		DP_PRINT_STATS("Rx Reap2stack Deliver Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_REAP_STACK);
+		dp_hist_set_hdr(&hist_stats, hist_hdr);
 		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
 					      &hist_stats, tid,
 					      CDP_HIST_TYPE_REAP_STACK);
 		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_REAP_STACK);
 	}
+	dp_hist_hdr_free(hist_hdr);
 }
 
 #else
@@ -8448,6 +8532,8 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("RX frag wait: %d", soc->stats.rx.rx_frag_wait);
 	DP_PRINT_STATS("RX frag err: %d", soc->stats.rx.rx_frag_err);
 	DP_PRINT_STATS("RX frag OOR: %d", soc->stats.rx.rx_frag_oor);
+	DP_PRINT_STATS("RX frag flood drop: %d",
+		       soc->stats.rx.rx_frag_flood_drop);
 
 	DP_PRINT_STATS("RX HP out_of_sync: %d", soc->stats.rx.hp_oos2);
 	DP_PRINT_STATS("RX Ring Near Full: %d", soc->stats.rx.near_full);
@@ -8528,6 +8614,13 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	DP_PRINT_STATS("REO Error(0-14):%s", reo_error);
 	DP_PRINT_STATS("REO CMD SEND FAIL: %d",
 		       soc->stats.rx.err.reo_cmd_send_fail);
+	DP_PRINT_STATS("REO qdesc setup: %u avg %llu us cache hit %u put %u",
+		       soc->stats.rx.reo_qdesc_setup,
+		       soc->stats.rx.reo_qdesc_setup ?
+		       qdf_do_div(soc->stats.rx.reo_qdesc_setup_us,
+				  soc->stats.rx.reo_qdesc_setup) : 0,
+		       soc->stats.rx.reo_qdesc_cache_hit,
+		       soc->stats.rx.reo_qdesc_cache_put);
 
 	DP_PRINT_STATS("Rx BAR frames:%d", soc->stats.rx.bar_frame);
 	DP_PRINT_STATS("Rxdma2rel route drop:%d",
@@ -1548,6 +1548,20 @@ void dp_vdev_peer_stats_update_protocol_cnt_tx(struct dp_vdev *vdev_hdl,
 }
 #endif
 
+static inline void
+dp_flush_tcp_hp(struct dp_soc *soc, uint8_t ring_id)
+{
+	hal_ring_handle_t hal_ring_hdl =
+		dp_tx_get_hal_ring_hdl(soc, ring_id);
+
+	if (dp_tx_hal_ring_access_start(soc, hal_ring_hdl)) {
+		dp_err("Fillmore: SRNG access start failed");
+		return;
+	}
+
+	dp_tx_ring_access_end_wrapper(soc, hal_ring_hdl, 0);
+}
+
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 void dp_tx_update_stats(struct dp_soc *soc,
 			struct dp_tx_desc_s *tx_desc,
@@ -1571,6 +1585,10 @@ dp_tx_attempt_coalescing(struct dp_soc *soc, struct dp_vdev *vdev,
 	QDF_STATUS status;
 	int ret;
 
+	/* dp_tx_send_list() writes the HP once for the whole burst */
+	if (msdu_info->list_more)
+		return 1;
+
 	if (!swlm->is_enabled)
 		return msdu_info->skip_hp_update;
 
@@ -1617,20 +1635,6 @@ dp_tx_is_hp_update_required(uint32_t i, struct dp_tx_msdu_info_s *msdu_info)
 		msdu_info->skip_hp_update = 0;
 }
 
-static inline void
-dp_flush_tcp_hp(struct dp_soc *soc, uint8_t ring_id)
-{
-	hal_ring_handle_t hal_ring_hdl =
-		dp_tx_get_hal_ring_hdl(soc, ring_id);
-
-	if (dp_tx_hal_ring_access_start(soc, hal_ring_hdl)) {
-		dp_err("Fillmore: SRNG access start failed");
-		return;
-	}
-
-	dp_tx_ring_access_end_wrapper(soc, hal_ring_hdl, 0);
-}
-
 static inline void
 dp_tx_check_and_flush_hp(struct dp_soc *soc,
 			 QDF_STATUS status,
@@ -4277,8 +4281,20 @@ static inline void dp_vdev_tx_mark_to_fw(qdf_nbuf_t nbuf, struct dp_vdev *vdev)
 }
 #endif
 
-qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
-		      qdf_nbuf_t nbuf)
+/**
+ * __dp_tx_send() - Transmit a frame on a given VAP
+ * @soc_hdl: DP soc handle
+ * @vdev_id: id of DP vdev handle
+ * @nbuf: skb
+ * @more: more frames of the same burst follow, skip the TCL HP update
+ * @ring_id: TCL ring the frame was steered to
+ *
+ * Return: NULL on success,
+ *         nbuf when it fails to send
+ */
+static inline qdf_nbuf_t __dp_tx_send(struct cdp_soc_t *soc_hdl,
+				      uint8_t vdev_id, qdf_nbuf_t nbuf,
+				      bool more, uint8_t *ring_id)
 {
 	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
 	uint16_t peer_id = HTT_INVALID_PEER;
@@ -4340,6 +4356,7 @@ qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	DP_STATS_INC(vdev,
 		     tx_i[xmit_type].rcvd_per_core[msdu_info.tx_queue.desc_pool_id],
 		     1);
+	*ring_id = msdu_info.tx_queue.ring_id & DP_TX_QUEUE_MASK;
 
 	/*
 	 * TCL H/W supports 2 DSCP-TID mapping tables.
@@ -4456,6 +4473,7 @@ send_single:
 	 * prepare direct-buffer type TCL descriptor and enqueue to TCL
 	 * SRNG. There is no need to setup a MSDU extension descriptor.
 	 */
+	msdu_info.list_more = more;
 	nbuf = dp_tx_send_msdu_single_wrapper(vdev, nbuf, &msdu_info,
 					      peer_id, end_nbuf);
 	return nbuf;
@@ -4469,6 +4487,66 @@ send_multiple:
 	return nbuf;
 }
 
+qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+		      qdf_nbuf_t nbuf)
+{
+	uint8_t ring_id;
+
+	return __dp_tx_send(soc_hdl, vdev_id, nbuf, false, &ring_id);
+}
+
+qdf_nbuf_t dp_tx_send_list(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+			   qdf_nbuf_t nbuf_list)
+{
+	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
+	uint8_t hp_pending = DP_TX_INVALID_RING_ID;
+	qdf_nbuf_queue_t unsent;
+	qdf_nbuf_t nbuf = nbuf_list;
+	qdf_nbuf_t next;
+	uint8_t ring_id;
+
+	qdf_nbuf_queue_init(&unsent);
+
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+		ring_id = DP_TX_INVALID_RING_ID;
+
+		/*
+		 * Only the last frame of the list writes the TCL HP, the
+		 * earlier ones just advance the cached HP. A ring left with
+		 * an unwritten HP is flushed as soon as the burst moves to a
+		 * different ring or the list ends.
+		 */
+		nbuf = __dp_tx_send(soc_hdl, vdev_id, nbuf, !!next, &ring_id);
+		if (nbuf) {
+			qdf_nbuf_queue_add(&unsent, nbuf);
+		} else {
+			if (hp_pending != DP_TX_INVALID_RING_ID &&
+			    hp_pending != ring_id) {
+				dp_flush_tcp_hp(soc, hp_pending);
+				DP_STATS_INC(soc,
+					     tx.tcl_batch_doorbell[hp_pending],
+					     1);
+			}
+
+			hp_pending = next ? ring_id : DP_TX_INVALID_RING_ID;
+			if (!next)
+				DP_STATS_INC(soc,
+					     tx.tcl_batch_doorbell[ring_id], 1);
+		}
+
+		nbuf = next;
+	}
+
+	if (hp_pending != DP_TX_INVALID_RING_ID) {
+		dp_flush_tcp_hp(soc, hp_pending);
+		DP_STATS_INC(soc, tx.tcl_batch_doorbell[hp_pending], 1);
+	}
+
+	return qdf_nbuf_queue_first(&unsent);
+}
+
 qdf_nbuf_t dp_tx_send_vdev_id_check(struct cdp_soc_t *soc_hdl,
 				    uint8_t vdev_id, qdf_nbuf_t nbuf)
 {
@@ -4501,6 +4579,79 @@ qdf_nbuf_t dp_tx_send_vdev_id_check(struct cdp_soc_t *soc_hdl,
 	return dp_tx_send(soc_hdl, vdev_id, nbuf);
 }
 
+qdf_nbuf_t dp_tx_send_list_vdev_id_check(struct cdp_soc_t *soc_hdl,
+					 uint8_t vdev_id, qdf_nbuf_t nbuf_list)
+{
+	struct dp_soc *soc = cdp_soc_t_to_dp_soc(soc_hdl);
+	struct dp_vdev *vdev = NULL;
+	qdf_nbuf_queue_t unsent;
+	qdf_nbuf_queue_t checked;
+	qdf_nbuf_t nbuf = nbuf_list;
+	qdf_nbuf_t next;
+	uint8_t xmit_type;
+
+	if (qdf_unlikely(vdev_id >= MAX_VDEV_CNT))
+		return nbuf_list;
+
+	vdev = soc->vdev_id_map[vdev_id];
+	if (qdf_unlikely(!vdev))
+		return nbuf_list;
+
+	qdf_nbuf_queue_init(&unsent);
+	qdf_nbuf_queue_init(&checked);
+
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		if (qdf_unlikely(dp_tx_per_pkt_vdev_id_check(nbuf, vdev)
+				== QDF_STATUS_E_FAILURE)) {
+			xmit_type = qdf_nbuf_get_vdev_xmit_type(nbuf);
+			DP_STATS_INC(vdev,
+				     tx_i[xmit_type].dropped.fail_per_pkt_vdev_id_check,
+				     1);
+			qdf_nbuf_queue_add(&unsent, nbuf);
+		} else {
+			qdf_nbuf_queue_add(&checked, nbuf);
+		}
+
+		nbuf = next;
+	}
+
+	nbuf = dp_tx_send_list(soc_hdl, vdev_id, qdf_nbuf_queue_first(&checked));
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_queue_add(&unsent, nbuf);
+		nbuf = next;
+	}
+
+	return qdf_nbuf_queue_first(&unsent);
+}
+
+qdf_nbuf_t dp_tx_send_list_mesh(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+				qdf_nbuf_t nbuf_list)
+{
+	qdf_nbuf_queue_t unsent;
+	qdf_nbuf_t nbuf = nbuf_list;
+	qdf_nbuf_t next;
+
+	qdf_nbuf_queue_init(&unsent);
+
+	/* Mesh frames carry per frame meta headers, send them one by one */
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		nbuf = dp_tx_send_mesh(soc_hdl, vdev_id, nbuf);
+		if (nbuf)
+			qdf_nbuf_queue_add(&unsent, nbuf);
+
+		nbuf = next;
+	}
+
+	return qdf_nbuf_queue_first(&unsent);
+}
+
 #ifdef UMAC_SUPPORT_PROXY_ARP
 /**
  * dp_tx_proxy_arp() - Tx proxy arp handler
@@ -6423,6 +6574,98 @@ dp_tx_comp_process_desc_list_fast(struct dp_soc *soc,
 	dp_tx_desc_free_list(pool, head_desc, tail_desc, fast_desc_count);
 }
 
+/**
+ * struct dp_tx_comp_batch - Simple completions accumulated over a run of
+ *			     descriptors of the same peer and pdev
+ * @txrx_peer: peer of the run
+ * @pdev: pdev of the run
+ * @num_pkts: packets completed for @txrx_peer
+ * @num_failed: packets of @num_pkts not acked
+ * @bytes: bytes completed for @txrx_peer
+ * @num_outstanding: descriptors to drop from the outstanding count of @pdev
+ */
+struct dp_tx_comp_batch {
+	struct dp_txrx_peer *txrx_peer;
+	struct dp_pdev *pdev;
+	uint32_t num_pkts;
+	uint32_t num_failed;
+	uint64_t bytes;
+	uint32_t num_outstanding;
+};
+
+/**
+ * dp_tx_comp_batch_flush_peer() - Apply the accumulated peer basic stats
+ * @batch: completion batch
+ *
+ * Must be called before the reference on @batch->txrx_peer is dropped.
+ *
+ * Return: None
+ */
+static inline void dp_tx_comp_batch_flush_peer(struct dp_tx_comp_batch *batch)
+{
+	struct dp_txrx_peer *txrx_peer = batch->txrx_peer;
+
+	if (!batch->num_pkts)
+		return;
+
+#ifdef QCA_VDEV_STATS_HW_OFFLOAD_SUPPORT
+	if (!txrx_peer->hw_txrx_stats_en)
+#endif
+	{
+		DP_PEER_STATS_FLAT_INC_PKT(txrx_peer, comp_pkt,
+					   batch->num_pkts, batch->bytes);
+		DP_PEER_STATS_FLAT_INC(txrx_peer, tx_failed,
+				       batch->num_failed);
+	}
+
+	batch->num_pkts = 0;
+	batch->num_failed = 0;
+	batch->bytes = 0;
+}
+
+/**
+ * dp_tx_comp_batch_flush_pdev() - Apply the accumulated outstanding count
+ * @batch: completion batch
+ *
+ * Return: None
+ */
+static inline void dp_tx_comp_batch_flush_pdev(struct dp_tx_comp_batch *batch)
+{
+	if (!batch->num_outstanding)
+		return;
+
+	dp_tx_outstanding_sub(batch->pdev, batch->num_outstanding);
+	batch->num_outstanding = 0;
+}
+
+/**
+ * dp_tx_comp_batch_add() - Account a simple completion in the batch
+ * @batch: completion batch
+ * @txrx_peer: peer of the descriptor, NULL if not found
+ * @desc: tx descriptor
+ *
+ * Return: None
+ */
+static inline void dp_tx_comp_batch_add(struct dp_tx_comp_batch *batch,
+					struct dp_txrx_peer *txrx_peer,
+					struct dp_tx_desc_s *desc)
+{
+	if (qdf_unlikely(batch->pdev != desc->pdev)) {
+		dp_tx_comp_batch_flush_pdev(batch);
+		batch->pdev = desc->pdev;
+	}
+	batch->num_outstanding++;
+
+	if (qdf_unlikely(!txrx_peer))
+		return;
+
+	batch->txrx_peer = txrx_peer;
+	batch->num_pkts++;
+	batch->bytes += desc->length;
+	if (desc->tx_status != HAL_TX_TQM_RR_FRAME_ACKED)
+		batch->num_failed++;
+}
+
 void
 dp_tx_comp_process_desc_list(struct dp_soc *soc,
 			     struct dp_tx_desc_s *comp_head, uint8_t ring_id)
@@ -6434,6 +6677,7 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 	uint16_t peer_id = DP_INVALID_PEER;
 	dp_txrx_ref_handle txrx_ref_handle = NULL;
 	qdf_nbuf_queue_head_t h;
+	struct dp_tx_comp_batch batch = {0};
 
 	desc = comp_head;
 
@@ -6444,6 +6688,7 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 		dp_tx_prefetch_next_nbuf_data(next);
 
 		if (peer_id != desc->peer_id) {
+			dp_tx_comp_batch_flush_peer(&batch);
 			if (txrx_peer)
 				dp_txrx_peer_unref_delete(txrx_ref_handle,
 							  DP_MOD_ID_TX_COMP);
@@ -6484,15 +6729,12 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 		}
 
 		if (qdf_likely(desc->flags & DP_TX_DESC_FLAG_SIMPLE)) {
-			struct dp_pdev *pdev = desc->pdev;
-
-			if (qdf_likely(txrx_peer))
-				dp_tx_update_peer_basic_stats(txrx_peer,
-							      desc->length,
-							      desc->tx_status,
-							      false);
-			qdf_assert(pdev);
-			dp_tx_outstanding_dec(pdev);
+			qdf_assert(desc->pdev);
+			/*
+			 * Peer stats and outstanding counts are applied once
+			 * per run of descriptors instead of per descriptor
+			 */
+			dp_tx_comp_batch_add(&batch, txrx_peer, desc);
 			/*
 			 * Calling a QDF WRAPPER here is creating significant
 			 * performance impact so avoided the wrapper call here
@@ -6516,6 +6758,8 @@ dp_tx_comp_process_desc_list(struct dp_soc *soc,
 		dp_tx_desc_release(soc, desc, desc->pool_id);
 		desc = next;
 	}
+	dp_tx_comp_batch_flush_pdev(&batch);
+	dp_tx_comp_batch_flush_peer(&batch);
 	dp_tx_nbuf_dev_kfree_list(&h);
 	if (txrx_peer)
 		dp_txrx_peer_unref_delete(txrx_ref_handle, DP_MOD_ID_TX_COMP);
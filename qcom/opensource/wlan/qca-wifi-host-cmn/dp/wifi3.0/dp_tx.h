@@ -101,6 +101,7 @@ do {                                                           \
 	#endif /* TX_PER_VDEV_DESC_POOL */
 #endif /* TX_PER_PDEV_DESC_POOL */
 #define DP_TX_QUEUE_MASK 0x3
+#define DP_TX_INVALID_RING_ID 0xFF
 
 #define MAX_CDP_SEC_TYPE 12
 
@@ -209,6 +210,7 @@ struct dp_tx_queue {
  * @gsn: global sequence for reinjected mcast packets
  * @vdev_id : vdev_id for reinjected mcast packets
  * @skip_hp_update : Skip HP update for TSO segments and update in last segment
+ * @list_more: more frames of a dp_tx_send_list() burst follow this one
  * @buf_len:
  * @payload_addr:
  * @driver_ingress_ts: driver ingress timestamp
@@ -240,6 +242,7 @@ struct dp_tx_msdu_info_s {
 #ifdef WLAN_DP_FEATURE_SW_LATENCY_MGR
 	uint8_t skip_hp_update;
 #endif
+	uint8_t list_more;
 #ifdef QCA_DP_TX_RMNET_OPTIMIZATION
 	uint16_t buf_len;
 	uint8_t *payload_addr;
@@ -572,6 +575,47 @@ QDF_STATUS dp_tso_soc_detach(struct cdp_soc_t *txrx_soc);
 qdf_nbuf_t dp_tx_send(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		      qdf_nbuf_t nbuf);
 
+/**
+ * dp_tx_send_list() - Transmit a list of frames on a given VAP
+ * @soc_hdl: DP soc handle
+ * @vdev_id: id of DP vdev handle
+ * @nbuf_list: list of skbs linked through qdf_nbuf_next()
+ *
+ * Each frame goes through the regular dp_tx_send() path, only the TCL HP
+ * update is deferred to the last frame of the list. Also used as the fast
+ * list handler by architectures without a batched fast path.
+ *
+ * Return: NULL when all frames were sent,
+ *         list of the frames which failed to send otherwise
+ */
+qdf_nbuf_t dp_tx_send_list(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+			   qdf_nbuf_t nbuf_list);
+
+/**
+ * dp_tx_send_list_vdev_id_check() - Transmit a list of frames on a given VAP
+ *	with the per packet vdev id check
+ * @soc_hdl: DP soc handle
+ * @vdev_id: id of DP vdev handle
+ * @nbuf_list: list of skbs linked through qdf_nbuf_next()
+ *
+ * Return: NULL when all frames were sent,
+ *         list of the frames which failed to send otherwise
+ */
+qdf_nbuf_t dp_tx_send_list_vdev_id_check(struct cdp_soc_t *soc_hdl,
+					 uint8_t vdev_id, qdf_nbuf_t nbuf_list);
+
+/**
+ * dp_tx_send_list_mesh() - Transmit a list of mesh frames on a given VAP
+ * @soc_hdl: DP soc handle
+ * @vdev_id: id of DP vdev handle
+ * @nbuf_list: list of skbs linked through qdf_nbuf_next()
+ *
+ * Return: NULL when all frames were sent,
+ *         list of the frames which failed to send otherwise
+ */
+qdf_nbuf_t dp_tx_send_list_mesh(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
+				qdf_nbuf_t nbuf_list);
+
 /**
  * dp_tx_send_vdev_id_check() - Transmit a frame on a given VAP in special
  *      case to avoid check in per-packet path.
@@ -1431,7 +1475,10 @@ static inline void
 dp_tx_ring_access_end(struct dp_soc *soc, hal_ring_handle_t hal_ring_hdl,
 		      int coalesce)
 {
-	dp_tx_hal_ring_access_end(soc, hal_ring_hdl);
+	if (coalesce)
+		dp_tx_hal_ring_access_end_reap(soc, hal_ring_hdl);
+	else
+		dp_tx_hal_ring_access_end(soc, hal_ring_hdl);
 }
 
 static inline int
@@ -1441,7 +1488,7 @@ dp_tx_attempt_coalescing(struct dp_soc *soc, struct dp_vdev *vdev,
 			 struct dp_tx_msdu_info_s *msdu_info,
 			 uint8_t ring_id)
 {
-	return 0;
+	return msdu_info->list_more;
 }
 
 #endif /* WLAN_DP_FEATURE_SW_LATENCY_MGR */
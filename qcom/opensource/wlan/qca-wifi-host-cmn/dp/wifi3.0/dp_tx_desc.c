@@ -61,6 +61,39 @@ dp_tx_desc_pool_counter_initialize(struct dp_tx_desc_pool_s *tx_desc_pool,
 	tx_desc_pool->elem_count = num_elem;
 	tx_desc_pool->num_free = num_elem;
 	tx_desc_pool->num_allocated = 0;
+#ifdef WLAN_DP_TX_DESC_PCPU_CACHE
+	qdf_mem_zero(tx_desc_pool->pcpu_cache,
+		     sizeof(tx_desc_pool->pcpu_cache));
+#endif
+}
+#endif
+
+#if defined(WLAN_DP_TX_DESC_PCPU_CACHE) && \
+	!defined(QCA_LL_TX_FLOW_CONTROL_V2)
+static void dp_tx_desc_pcpu_cache_lock_create(struct dp_tx_desc_pool_s *pool)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		qdf_spinlock_create(&pool->pcpu_cache[cpu].lock);
+}
+
+static void dp_tx_desc_pcpu_cache_lock_destroy(struct dp_tx_desc_pool_s *pool)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		qdf_spinlock_destroy(&pool->pcpu_cache[cpu].lock);
+}
+#else
+static inline void
+dp_tx_desc_pcpu_cache_lock_create(struct dp_tx_desc_pool_s *pool)
+{
+}
+
+static inline void
+dp_tx_desc_pcpu_cache_lock_destroy(struct dp_tx_desc_pool_s *pool)
+{
 }
 #endif
 
@@ -286,6 +319,7 @@ QDF_STATUS dp_tx_desc_pool_init(struct dp_soc *soc, uint8_t pool_id,
 
 	dp_tx_desc_pool_counter_initialize(tx_desc_pool, num_elem_t);
 	TX_DESC_LOCK_CREATE(&tx_desc_pool->lock);
+	dp_tx_desc_pcpu_cache_lock_create(tx_desc_pool);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -302,6 +336,7 @@ void dp_tx_desc_pool_deinit(struct dp_soc *soc, uint8_t pool_id,
 	soc->arch_ops.dp_tx_desc_pool_deinit(soc, tx_desc_pool,
 					     pool_id, spcl_tx_desc);
 	TX_DESC_POOL_MEMBER_CLEAN(tx_desc_pool);
+	dp_tx_desc_pcpu_cache_lock_destroy(tx_desc_pool);
 	TX_DESC_LOCK_DESTROY(&tx_desc_pool->lock);
 }
 
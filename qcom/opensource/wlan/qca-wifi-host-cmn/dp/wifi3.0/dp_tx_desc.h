@@ -23,6 +23,7 @@
 #include "dp_types.h"
 #include "dp_tx.h"
 #include "dp_internal.h"
+#include <qdf_defer.h>
 
 /*
  * 21 bits cookie
@@ -1015,6 +1016,201 @@ void dp_tx_prefetch_desc(struct dp_tx_desc_s *tx_desc)
 }
 #endif
 
+#ifdef WLAN_DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_tx_desc_pcpu_cache_refill() - Refill a per-CPU cache from the pool
+ * @pool: Tx descriptor pool
+ * @cache: per-CPU cache of the current CPU, lock held by the caller
+ *
+ * Move up to DP_TX_DESC_PCPU_CACHE_BATCH descriptors from the pool
+ * freelist to @cache with a single acquisition of the pool lock.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pcpu_cache_refill(struct dp_tx_desc_pool_s *pool,
+			     struct dp_tx_desc_pcpu_cache *cache)
+{
+	struct dp_tx_desc_s *head, *tail;
+	uint32_t count = 1;
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+
+	head = pool->freelist;
+
+	/* Pool is exhausted */
+	if (!head) {
+		TX_DESC_LOCK_UNLOCK(&pool->lock);
+		return;
+	}
+
+	tail = head;
+	while (count < DP_TX_DESC_PCPU_CACHE_BATCH && tail->next) {
+		tail = tail->next;
+		count++;
+	}
+
+	pool->freelist = tail->next;
+	pool->num_free -= count;
+
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+
+	tail->next = cache->freelist;
+	cache->freelist = head;
+	cache->count += count;
+}
+
+/**
+ * dp_tx_desc_pcpu_cache_flush() - Return a batch of descriptors from a
+ *				   per-CPU cache to the pool
+ * @pool: Tx descriptor pool
+ * @cache: per-CPU cache of the current CPU, lock held by the caller
+ *
+ * Caller must make sure @cache holds at least DP_TX_DESC_PCPU_CACHE_BATCH
+ * descriptors.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pcpu_cache_flush(struct dp_tx_desc_pool_s *pool,
+			    struct dp_tx_desc_pcpu_cache *cache)
+{
+	struct dp_tx_desc_s *head, *tail;
+	uint32_t count = 1;
+
+	head = cache->freelist;
+	tail = head;
+	while (count < DP_TX_DESC_PCPU_CACHE_BATCH) {
+		tail = tail->next;
+		count++;
+	}
+
+	cache->freelist = tail->next;
+	cache->count -= count;
+	cache->flush++;
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	tail->next = pool->freelist;
+	pool->freelist = head;
+	pool->num_free += count;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+
+/**
+ * dp_tx_desc_pcpu_cache_steal() - Take over the descriptors parked in the
+ *				   cache of another CPU
+ * @pool: Tx descriptor pool
+ * @cache: per-CPU cache of the current CPU, lock held by the caller
+ * @cpu: current CPU
+ *
+ * Used once the pool freelist is exhausted, so that descriptors freed on
+ * a CPU which does not transmit do not make the allocation fail. The lock
+ * of @cache is dropped while the remote cache is emptied, only one cache
+ * lock is ever held at a time.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pcpu_cache_steal(struct dp_tx_desc_pool_s *pool,
+			    struct dp_tx_desc_pcpu_cache *cache, int cpu)
+{
+	struct dp_tx_desc_pcpu_cache *remote;
+	struct dp_tx_desc_s *head = NULL, *tail;
+	uint32_t count = 0;
+	int i;
+
+	qdf_spin_unlock(&cache->lock);
+
+	for (i = 0; i < QDF_MAX_AVAILABLE_CPU; i++) {
+		if (i == cpu)
+			continue;
+
+		remote = &pool->pcpu_cache[i];
+		/* Unlocked peek, the list itself is only read under lock */
+		if (!remote->count)
+			continue;
+
+		qdf_spin_lock(&remote->lock);
+		head = remote->freelist;
+		count = remote->count;
+		remote->freelist = NULL;
+		remote->count = 0;
+		qdf_spin_unlock(&remote->lock);
+
+		if (head)
+			break;
+	}
+
+	qdf_spin_lock(&cache->lock);
+
+	if (!head)
+		return;
+
+	tail = head;
+	while (tail->next)
+		tail = tail->next;
+
+	tail->next = cache->freelist;
+	cache->freelist = head;
+	cache->count += count;
+	cache->steal++;
+}
+
+/**
+ * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: pool id
+ *
+ * The descriptor is taken from the cache of the current CPU, the pool
+ * lock is only taken when the cache has to be refilled. When the pool
+ * is exhausted the caches of the other CPUs are drained before failing.
+ *
+ * Return: Tx Descriptor or NULL
+ */
+static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
+						uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_s *tx_desc = NULL;
+	struct dp_tx_desc_pool_s *pool = NULL;
+	struct dp_tx_desc_pcpu_cache *cache;
+	int cpu;
+
+	pool = dp_get_tx_desc_pool(soc, desc_pool_id);
+
+	qdf_local_bh_disable();
+
+	cpu = qdf_get_cpu();
+	cache = &pool->pcpu_cache[cpu];
+	qdf_spin_lock(&cache->lock);
+	if (qdf_likely(cache->freelist)) {
+		cache->hit++;
+	} else {
+		cache->miss++;
+		dp_tx_desc_pcpu_cache_refill(pool, cache);
+		if (!cache->freelist)
+			dp_tx_desc_pcpu_cache_steal(pool, cache, cpu);
+
+		if (!cache->freelist) {
+			qdf_spin_unlock(&cache->lock);
+			qdf_local_bh_enable();
+			return NULL;
+		}
+	}
+
+	tx_desc = cache->freelist;
+	cache->freelist = tx_desc->next;
+	cache->count--;
+	cache->num_allocated++;
+	dp_tx_prefetch_desc(cache->freelist);
+	qdf_spin_unlock(&cache->lock);
+
+	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+
+	qdf_local_bh_enable();
+
+	return tx_desc;
+}
+#else
 /**
  * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
  * @soc: Handle to DP SoC structure
@@ -1051,6 +1247,7 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
 
 	return tx_desc;
 }
+#endif /* WLAN_DP_TX_DESC_PCPU_CACHE */
 
 static inline struct dp_tx_desc_s *dp_tx_spcl_desc_alloc(struct dp_soc *soc,
 							 uint8_t desc_pool_id)
@@ -1134,6 +1331,42 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc_multiple(
 	return h_desc;
 }
 
+#ifdef WLAN_DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: descriptor to free
+ * @desc_pool_id: ID of the free pool
+ *
+ * The descriptor is parked in the cache of the current CPU, a batch of
+ * descriptors is returned to the pool once the cache overflows.
+ */
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = NULL;
+	struct dp_tx_desc_pcpu_cache *cache;
+
+	dp_tx_desc_clear(tx_desc);
+	pool = dp_get_tx_desc_pool(soc, desc_pool_id);
+
+	qdf_local_bh_disable();
+
+	cache = &pool->pcpu_cache[qdf_get_cpu()];
+	qdf_spin_lock(&cache->lock);
+	tx_desc->next = cache->freelist;
+	cache->freelist = tx_desc;
+	cache->count++;
+	cache->num_allocated--;
+
+	if (qdf_unlikely(cache->count > DP_TX_DESC_PCPU_CACHE_SIZE))
+		dp_tx_desc_pcpu_cache_flush(pool, cache);
+	qdf_spin_unlock(&cache->lock);
+
+	qdf_local_bh_enable();
+}
+#else
 /**
  * dp_tx_desc_free() - Free a tx descriptor and attach it to free list
  * @soc: Handle to DP SoC structure
@@ -1155,6 +1388,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	pool->num_free++;
 	TX_DESC_LOCK_UNLOCK(&pool->lock);
 }
+#endif /* WLAN_DP_TX_DESC_PCPU_CACHE */
 
 static inline void
 dp_tx_spcl_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
@@ -1189,6 +1423,37 @@ dp_tx_desc_free_list(struct dp_tx_desc_pool_s *pool,
 
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 
+#if defined(WLAN_DP_TX_DESC_PCPU_CACHE) && \
+	!defined(QCA_LL_TX_FLOW_CONTROL_V2)
+/**
+ * dp_tx_desc_pool_get_num_allocated() - Get the number of used descriptors
+ * @pool: Tx descriptor pool
+ *
+ * Descriptors parked in the per-CPU caches are free and are not counted.
+ * The per-CPU counters are read without their locks, the result is a
+ * snapshot for stats.
+ *
+ * Return: number of descriptors allocated from @pool
+ */
+static inline uint32_t
+dp_tx_desc_pool_get_num_allocated(struct dp_tx_desc_pool_s *pool)
+{
+	int32_t num_allocated = pool->num_allocated;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		num_allocated += pool->pcpu_cache[cpu].num_allocated;
+
+	return num_allocated > 0 ? num_allocated : 0;
+}
+#else
+static inline uint32_t
+dp_tx_desc_pool_get_num_allocated(struct dp_tx_desc_pool_s *pool)
+{
+	return pool->num_allocated;
+}
+#endif
+
 #ifdef QCA_DP_TX_DESC_ID_CHECK
 /**
  * dp_tx_is_desc_id_valid() - check is the tx desc id valid
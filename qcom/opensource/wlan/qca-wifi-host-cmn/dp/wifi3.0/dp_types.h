@@ -221,6 +221,8 @@ enum dp_pkt_xmit_type {
 	DP_XMIT_TOTAL,
 };
 
+#define DP_XMIT_TYPE_MAX (DP_XMIT_TOTAL + 1)
+
 enum rx_pktlog_mode {
 	DP_RX_PKTLOG_DISABLED = 0,
 	DP_RX_PKTLOG_FULL,
@@ -797,6 +799,38 @@ struct dp_tx_tso_num_seg_pool_s {
 	qdf_spinlock_t lock;
 };
 
+#ifdef WLAN_DP_TX_DESC_PCPU_CACHE
+/* Max number of free descriptors held in a per-CPU Tx descriptor cache */
+#define DP_TX_DESC_PCPU_CACHE_SIZE 64
+/* Number of descriptors moved between the pool and a per-CPU cache */
+#define DP_TX_DESC_PCPU_CACHE_BATCH 32
+
+/**
+ * struct dp_tx_desc_pcpu_cache - Per-CPU cache of free Tx descriptors
+ * @lock: Protects @freelist and @count against other CPUs stealing from
+ *	  this cache, uncontended in the regular alloc/free path
+ * @freelist: Chain of free descriptors owned by this CPU
+ * @count: Number of descriptors in @freelist
+ * @num_allocated: Descriptors allocated minus descriptors freed through
+ *		   this cache, may go negative when completions run on a
+ *		   different CPU than the transmit
+ * @hit: Allocations served from the cache
+ * @miss: Allocations which had to refill the cache from the pool
+ * @flush: Bulk returns of descriptors from the cache to the pool
+ * @steal: Refills served from the cache of another CPU
+ */
+struct dp_tx_desc_pcpu_cache {
+	qdf_spinlock_t lock;
+	struct dp_tx_desc_s *freelist;
+	uint32_t count;
+	int32_t num_allocated;
+	uint32_t hit;
+	uint32_t miss;
+	uint32_t flush;
+	uint32_t steal;
+} qdf_cacheline_aligned;
+#endif
+
 /**
  * struct dp_tx_desc_pool_s - Tx Descriptor pool information
  * @elem_size: Size of each descriptor in the pool
@@ -820,6 +854,11 @@ struct dp_tx_tso_num_seg_pool_s {
  * @elem_count:
  * @num_free: Number of free descriptors
  * @lock: Lock for descriptor allocation/free from/to the pool
+ * @pcpu_cache: Per-CPU caches of free descriptors, refilled from and
+ *		returned to @freelist in bulk. Descriptors held in these
+ *		caches are neither in @num_free nor in @num_allocated, use
+ *		dp_tx_desc_pool_get_num_allocated() to read the number of
+ *		used descriptors.
  */
 struct dp_tx_desc_pool_s {
 	uint16_t elem_size;
@@ -850,6 +889,9 @@ struct dp_tx_desc_pool_s {
 	uint16_t elem_count;
 	uint32_t num_free;
 	qdf_spinlock_t lock;
+#ifdef WLAN_DP_TX_DESC_PCPU_CACHE
+	struct dp_tx_desc_pcpu_cache pcpu_cache[QDF_MAX_AVAILABLE_CPU];
+#endif
 #endif
 };
 
@@ -919,9 +961,27 @@ struct dp_reo_cmd_info {
 	TAILQ_ENTRY(dp_reo_cmd_info) reo_cmd_list_elem;
 };
 
+#ifdef DP_HIST_PERCENTILE
+/**
+ * struct dp_peer_delay_hdr - Log-linear delay histograms of a peer
+ * @tx_swq_delay: software enqueue delay per TID and ring
+ * @hwtx_delay: HW enqueue to completion delay per TID and ring
+ * @to_stack_delay: Rx reap to stack delay per TID and ring
+ */
+struct dp_peer_delay_hdr {
+	struct cdp_hist_hdr tx_swq_delay[CDP_MAX_DATA_TIDS][CDP_MAX_TXRX_CTX];
+	struct cdp_hist_hdr hwtx_delay[CDP_MAX_DATA_TIDS][CDP_MAX_TXRX_CTX];
+	struct cdp_hist_hdr to_stack_delay[CDP_MAX_DATA_TIDS]
+					  [CDP_MAX_TXRX_CTX];
+};
+#endif
+
 struct dp_peer_delay_stats {
 	struct cdp_delay_tid_stats delay_tid_stats[CDP_MAX_DATA_TIDS]
 						  [CDP_MAX_TXRX_CTX];
+#ifdef DP_HIST_PERCENTILE
+	struct dp_peer_delay_hdr *delay_hdr;
+#endif
 };
 
 /* Rx TID defrag*/
@@ -939,6 +999,10 @@ struct dp_rx_tid_defrag {
 	/* Sequence and fragments that are being processed currently */
 	uint32_t curr_seq_num;
 	uint32_t curr_frag_num;
+	/* fragment numbers of curr_seq_num held in the fragment list */
+	uint16_t frag_bitmap;
+	/* set while the TID is queued on the soc defrag waitlist */
+	bool on_waitlist;
 
 	/* TODO: Check the following while adding defragmentation support */
 	struct dp_rx_reorder_array_elem *array;
@@ -1166,6 +1230,27 @@ struct reo_desc_deferred_freelist_node {
 };
 #endif /* WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY */
 
+#ifdef WLAN_DP_REO_QDESC_CACHE
+#define REO_QDESC_CACHE_SIZE 128
+
+/**
+ * struct reo_qdesc_cache_node - freed REO queue descriptor kept mapped
+ *				 for reuse by the next rx tid setup
+ * @node: list node
+ * @hw_qdesc_vaddr_unaligned: allocated address of the descriptor
+ * @hw_qdesc_vaddr_aligned: aligned address programmed to HW
+ * @hw_qdesc_paddr: DMA address of the aligned descriptor
+ * @hw_qdesc_alloc_size: mapped size of the descriptor
+ */
+struct reo_qdesc_cache_node {
+	qdf_list_node_t node;
+	void *hw_qdesc_vaddr_unaligned;
+	void *hw_qdesc_vaddr_aligned;
+	qdf_dma_addr_t hw_qdesc_paddr;
+	uint32_t hw_qdesc_alloc_size;
+};
+#endif /* WLAN_DP_REO_QDESC_CACHE */
+
 #ifdef WLAN_FEATURE_DP_EVENT_HISTORY
 /**
  * struct reo_cmd_event_record: Elements to record for each reo command
@@ -1259,6 +1344,8 @@ struct dp_soc_stats {
 		uint32_t near_full;
 		/* Tx drops with buffer src as HAL_TX_COMP_RELEASE_SOURCE_FW */
 		uint32_t fw2wbm_tx_drop;
+		/* TCL HP updates issued by the batched send path per ring */
+		uint32_t tcl_batch_doorbell[MAX_TCL_DATA_RINGS];
 	} tx;
 
 	/* SOC level RX stats */
@@ -1280,6 +1367,8 @@ struct dp_soc_stats {
 		uint32_t rx_frag_err_len_error;
 		/* Fragments dropped due to no peer found */
 		uint32_t rx_frag_err_no_peer;
+		/* Fragments dropped as too many are pending reassembly */
+		uint32_t rx_frag_flood_drop;
 		/* No of reinjected packets */
 		uint32_t reo_reinject;
 		/* Reap loop packet limit hit */
@@ -1301,6 +1390,14 @@ struct dp_soc_stats {
 		uint32_t rx_hw_stats_requested;
 		/* Number of hw stats request timeout */
 		uint32_t rx_hw_stats_timeout;
+		/* REO queue descriptors set up */
+		uint32_t reo_qdesc_setup;
+		/* Total time spent in REO queue descriptor setup */
+		uint64_t reo_qdesc_setup_us;
+		/* REO queue descriptors taken from the mapped cache */
+		uint32_t reo_qdesc_cache_hit;
+		/* REO queue descriptors freed back to the mapped cache */
+		uint32_t reo_qdesc_cache_put;
 
 		struct {
 			/* Invalid RBM error count */
@@ -1564,6 +1661,9 @@ struct rx_refill_buff_pool {
 	struct dp_pdev *dp_pdev;
 	uint16_t max_bufq_len;
 	qdf_nbuf_t *buf_elem;
+#ifdef WLAN_DP_RX_PAGE_POOL
+	qdf_page_pool_t page_pool;
+#endif
 };
 
 #ifdef DP_TX_HW_DESC_HISTORY
@@ -1728,6 +1828,29 @@ struct dp_rx_refill_history {
 
 #endif
 
+#ifdef WLAN_DP_RX_REAP_PROFILE
+/* Reap batch sizes are bucketed by power of 2: 1, 2-3, 4-7, ... 128+ */
+#define DP_RX_REAP_PROF_BUCKETS 9
+
+/**
+ * struct dp_rx_reap_prof - per REO ring reap loop profile
+ * @reaps: number of reap iterations which reaped at least one buffer
+ * @msdus: total number of buffers reaped
+ * @reap_ns: time spent in the ring reap phase
+ * @total_ns: time spent in reap, per-MSDU processing and stack delivery
+ * @max_ns: longest single reap iteration
+ * @batch_hist: histogram of buffers reaped per iteration
+ */
+struct dp_rx_reap_prof {
+	uint64_t reaps;
+	uint64_t msdus;
+	uint64_t reap_ns;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	uint64_t batch_hist[DP_RX_REAP_PROF_BUCKETS];
+};
+#endif
+
 /**
  * enum dp_cfg_event_type - Datapath config events type
  * @DP_CFG_EVENT_VDEV_ATTACH: vdev attach
@@ -2690,6 +2813,27 @@ struct dp_rx_msdu_done_fail_desc_list {
 };
 #endif
 
+/* Number of dp_peer::hash_next slots, one per live peer hash table */
+#define DP_PEER_HASH_GENS 2
+
+/**
+ * struct dp_peer_hash_table - RCU protected peer MAC address hash table
+ * @mask: mask applied to the hash to get the bin index
+ * @idx_bits: log2 of the number of bins
+ * @gen: index of the dp_peer::hash_next slot linking the bins of this table
+ * @soc: DP soc owning the table
+ * @rcu: RCU head used to free the table once it is replaced by a resize
+ * @bins: chains of peers, searched from head to tail
+ */
+struct dp_peer_hash_table {
+	uint32_t mask;
+	uint32_t idx_bits;
+	uint8_t gen;
+	struct dp_soc *soc;
+	qdf_rcu_head_t rcu;
+	struct dp_peer *bins[];
+};
+
 /* SOC level structure for data path */
 struct dp_soc {
 	/**
@@ -2890,10 +3034,20 @@ struct dp_soc {
 	/* peer ID to peer object map (array of pointers to peer objects) */
 	struct dp_peer **peer_id_to_obj_map;
 
+	/*
+	 * Peer MAC address hash. Lookups walk @tbl under RCU only, updates
+	 * and resizes are serialized by peer_hash_lock.
+	 */
 	struct {
-		unsigned mask;
-		unsigned idx_bits;
-		TAILQ_HEAD(, dp_peer) * bins;
+		struct dp_peer_hash_table *tbl;
+		uint32_t num_peers;
+		uint32_t min_idx_bits;
+		uint32_t max_idx_bits;
+		uint32_t resize_cnt;
+		/* bumped on every unlink, lookups that miss retry on change */
+		qdf_atomic_t seq;
+		/* previous table is still visible to RCU readers */
+		qdf_atomic_t resize_pending;
 	} peer_hash;
 
 	/* rx defrag state – TBD: do we need this per radio? */
@@ -2903,6 +3057,8 @@ struct dp_soc {
 			uint32_t timeout_ms;
 			uint32_t next_flush_ms;
 			qdf_spinlock_t defrag_lock;
+			/* fragments held for reassembly across all TIDs */
+			qdf_atomic_t pending_frags;
 		} defrag;
 		struct {
 			int defrag_timeout_check;
@@ -2991,6 +3147,10 @@ struct dp_soc {
 	struct dp_mon_status_ring_history *mon_status_ring_history;
 #endif
 
+#ifdef WLAN_DP_RX_REAP_PROFILE
+	struct dp_rx_reap_prof rx_reap_prof[MAX_REO_DEST_RINGS];
+#endif
+
 #ifdef WLAN_FEATURE_DP_TX_DESC_HISTORY
 	struct dp_tx_tcl_history tx_tcl_history;
 	struct dp_tx_comp_history tx_comp_history;
@@ -3170,6 +3330,11 @@ struct dp_soc {
 	qdf_list_t reo_desc_deferred_freelist;
 	qdf_spinlock_t reo_desc_deferred_freelist_lock;
 	bool reo_desc_deferred_freelist_init;
+#endif
+#ifdef WLAN_DP_REO_QDESC_CACHE
+	qdf_list_t reo_qdesc_cache;
+	qdf_spinlock_t reo_qdesc_cache_lock;
+	bool reo_qdesc_cache_init;
 #endif
 	/* BM id for first WBM2SW  ring */
 	uint32_t wbm_sw0_bm_id;
@@ -4173,6 +4338,20 @@ struct dp_vdev {
 	/* VDEV Stats */
 	struct dp_vdev_stats stats;
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+	/*
+	 * Last peer stats aggregate of each xmit type, stats is an array of
+	 * DP_XMIT_TYPE_MAX entries, see dp_aggregate_vdev_stats()
+	 */
+	struct {
+		struct cdp_vdev_stats *stats;
+		uint32_t ts_ms[DP_XMIT_TYPE_MAX];
+		bool valid[DP_XMIT_TYPE_MAX];
+		uint32_t max_age_ms;
+		qdf_spinlock_t lock;
+	} stats_aggr;
+#endif
+
 	/* Is this a proxySTA VAP */
 	uint8_t proxysta_vdev : 1, /* Is this a proxySTA VAP */
 		wrap_vdev : 1, /* Is this a QWRAP AP VAP */
@@ -5073,6 +5252,10 @@ struct dp_peer {
 	TAILQ_ENTRY(dp_peer) peer_list_elem;
 	/* node in the hash table bin's list of peers */
 	TAILQ_ENTRY(dp_peer) hash_list_elem;
+	/* next peer in soc peer hash bin, one slot per table generation */
+	struct dp_peer *hash_next[DP_PEER_HASH_GENS];
+	/* deferred free of the peer after lockless hash readers are done */
+	qdf_rcu_head_t rcu;
 
 	/* TID structures pointer */
 	struct dp_rx_tid *rx_tid;
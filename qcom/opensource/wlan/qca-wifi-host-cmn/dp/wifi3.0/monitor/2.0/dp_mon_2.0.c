@@ -100,6 +100,61 @@ dp_mon_get_free_desc_list(struct dp_soc *soc,
 	return count;
 }
 
+QDF_STATUS dp_mon_frag_recycle_put(struct dp_mon_desc_pool *mon_desc_pool,
+				   qdf_frag_t frag)
+{
+	struct dp_mon_frag_recycle *recycle = &mon_desc_pool->recycle;
+
+	qdf_spin_lock_bh(&recycle->lock);
+	if (qdf_unlikely(recycle->count >= DP_MON_FRAG_RECYCLE_MAX)) {
+		qdf_spin_unlock_bh(&recycle->lock);
+		return QDF_STATUS_E_NOMEM;
+	}
+	recycle->frags[recycle->count++] = frag;
+	qdf_spin_unlock_bh(&recycle->lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_mon_frag_recycle_get() - Get a stashed monitor buffer
+ * @mon_desc_pool: mon desc pool
+ *
+ * Return: frag, NULL if the stash is empty
+ */
+static inline qdf_frag_t
+dp_mon_frag_recycle_get(struct dp_mon_desc_pool *mon_desc_pool)
+{
+	struct dp_mon_frag_recycle *recycle = &mon_desc_pool->recycle;
+	qdf_frag_t frag = NULL;
+
+	if (!recycle->count)
+		return NULL;
+
+	qdf_spin_lock_bh(&recycle->lock);
+	if (recycle->count)
+		frag = recycle->frags[--recycle->count];
+	qdf_spin_unlock_bh(&recycle->lock);
+
+	return frag;
+}
+
+/**
+ * dp_mon_frag_recycle_drain() - Free all stashed monitor buffers
+ * @mon_desc_pool: mon desc pool
+ *
+ * Return: None
+ */
+static void dp_mon_frag_recycle_drain(struct dp_mon_desc_pool *mon_desc_pool)
+{
+	struct dp_mon_frag_recycle *recycle = &mon_desc_pool->recycle;
+
+	qdf_spin_lock_bh(&recycle->lock);
+	while (recycle->count)
+		qdf_frag_free(recycle->frags[--recycle->count]);
+	qdf_spin_unlock_bh(&recycle->lock);
+}
+
 static inline QDF_STATUS
 dp_mon_frag_alloc_and_map(struct dp_soc *dp_soc,
 			  struct dp_mon_desc *mon_desc,
@@ -107,8 +162,10 @@ dp_mon_frag_alloc_and_map(struct dp_soc *dp_soc,
 {
 	QDF_STATUS ret = QDF_STATUS_E_FAILURE;
 
-	mon_desc->buf_addr = qdf_frag_alloc(&mon_desc_pool->pf_cache,
-					    mon_desc_pool->buf_size);
+	mon_desc->buf_addr = dp_mon_frag_recycle_get(mon_desc_pool);
+	if (!mon_desc->buf_addr)
+		mon_desc->buf_addr = qdf_frag_alloc(&mon_desc_pool->pf_cache,
+						    mon_desc_pool->buf_size);
 
 	if (!mon_desc->buf_addr) {
 		dp_mon_err("Frag alloc failed");
@@ -137,6 +194,8 @@ dp_mon_desc_pool_init(struct dp_mon_desc_pool *mon_desc_pool,
 	int desc_id;
 	/* Initialize monitor desc lock */
 	qdf_spinlock_create(&mon_desc_pool->lock);
+	qdf_spinlock_create(&mon_desc_pool->recycle.lock);
+	mon_desc_pool->recycle.count = 0;
 
 	qdf_spin_lock_bh(&mon_desc_pool->lock);
 
@@ -164,6 +223,9 @@ dp_mon_desc_pool_init(struct dp_mon_desc_pool *mon_desc_pool,
 
 void dp_mon_desc_pool_deinit(struct dp_mon_desc_pool *mon_desc_pool)
 {
+	dp_mon_frag_recycle_drain(mon_desc_pool);
+	qdf_spinlock_destroy(&mon_desc_pool->recycle.lock);
+
 	qdf_spin_lock_bh(&mon_desc_pool->lock);
 
 	mon_desc_pool->freelist = NULL;
@@ -216,6 +216,26 @@ union dp_mon_desc_list_elem_t {
 	struct dp_mon_desc mon_desc;
 };
 
+/* Max number of dropped monitor buffers kept for reuse */
+#define DP_MON_FRAG_RECYCLE_MAX 256
+
+/**
+ * struct dp_mon_frag_recycle - stash of monitor buffers dropped by the host
+ * @lock: Protection for the stash
+ * @count: number of frags in the stash
+ * @frags: stashed frags, used as a stack so that the most recently
+ *	   dropped (cache hot) buffer is reused first
+ *
+ * Holds buffers dropped on the error and flush paths only. Buffers delivered
+ * to the stack as nbuf frags are freed by the stack and are not returned
+ * here, recycling those needs the monitor buffers on a page pool.
+ */
+struct dp_mon_frag_recycle {
+	qdf_spinlock_t lock;
+	uint16_t count;
+	qdf_frag_t frags[DP_MON_FRAG_RECYCLE_MAX];
+};
+
 /**
  * struct dp_mon_desc_pool - monitor desc pool
  * @pool_size: number of descriptor in the pool
@@ -226,6 +246,8 @@ union dp_mon_desc_list_elem_t {
  * @buf_size: Buffer size
  * @buf_alignment: Buffer alignment
  * @pf_cache: page frag cache
+ * @recycle: buffers dropped on error or flush, reused on replenish before
+ *	     allocating from @pf_cache
  */
 struct dp_mon_desc_pool {
 	uint32_t pool_size;
@@ -236,6 +258,7 @@ struct dp_mon_desc_pool {
 	uint16_t buf_size;
 	uint8_t buf_alignment;
 	qdf_frag_cache_t pf_cache;
+	struct dp_mon_frag_recycle recycle;
 };
 
 /*
@@ -357,6 +380,17 @@ dp_mon_desc_pool_init(struct dp_mon_desc_pool *mon_desc_pool,
  */
 void dp_mon_desc_pool_deinit(struct dp_mon_desc_pool *mon_desc_pool);
 
+/**
+ * dp_mon_frag_recycle_put() - Stash a dropped monitor buffer for reuse
+ * @mon_desc_pool: mon desc pool the buffer was allocated for
+ * @frag: unmapped buffer, must not be referenced by any nbuf
+ *
+ * Return: QDF_STATUS_SUCCESS if stashed, QDF_STATUS_E_NOMEM if the stash is
+ *	   full and the caller still owns @frag
+ */
+QDF_STATUS dp_mon_frag_recycle_put(struct dp_mon_desc_pool *mon_desc_pool,
+				   qdf_frag_t frag);
+
 /**
  * dp_mon_desc_pool_free()- monitor descriptor pool free
  * @soc: DP soc handle
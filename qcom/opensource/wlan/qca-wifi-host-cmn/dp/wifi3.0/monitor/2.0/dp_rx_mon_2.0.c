@@ -619,6 +619,37 @@ void dp_rx_mon_set_zero(qdf_nbuf_t nbuf)
 	qdf_mem_zero(qdf_nbuf_head(nbuf), DP_RX_MON_TLV_ROOM);
 }
 
+/**
+ * dp_rx_mon_drop_frag_free() - Release a monitor buffer dropped by the host
+ * @soc: DP soc handle
+ * @addr: unmapped buffer, neither attached to an nbuf nor referenced by the
+ *	  frags of one
+ *
+ * Only buffers the host drops on error or flush come here. The buffer is
+ * kept for the next replenish of the monitor buffer ring instead of going
+ * back to the page allocator. Buffers delivered to the stack as nbuf frags
+ * are not recycled, they go back to the page allocator when the nbuf is
+ * freed.
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_mon_drop_frag_free(struct dp_soc *soc, qdf_frag_t addr)
+{
+	struct dp_mon_soc *mon_soc = soc->monitor_soc;
+	struct dp_mon_soc_be *mon_soc_be =
+			dp_get_be_mon_soc_from_dp_mon_soc(mon_soc);
+	struct dp_mon_desc_pool *rx_mon_desc_pool = &mon_soc_be->rx_desc_mon;
+
+	DP_STATS_INC(mon_soc, frag_free, 1);
+	if (QDF_IS_STATUS_SUCCESS(dp_mon_frag_recycle_put(rx_mon_desc_pool,
+							  addr))) {
+		DP_STATS_INC(mon_soc, frag_recycle, 1);
+		return;
+	}
+	qdf_frag_free(addr);
+}
+
 /**
  * dp_rx_mon_nbuf_add_rx_frag() -  Add frag to SKB
  *
@@ -871,16 +902,14 @@ dp_rx_mon_handle_mon_buf_addr(struct dp_pdev *pdev,
 
 	/* if rx hdr is not valid free pkt buffer and return */
 	if (qdf_unlikely(!rx_hdr_valid)) {
-		DP_STATS_INC(mon_soc, frag_free, 1);
-		qdf_frag_free(addr);
+		dp_rx_mon_drop_frag_free(soc, addr);
 		return num_buf_reaped;
 	}
 
 	if (qdf_unlikely(!ppdu_info->rx_hdr_rcvd[user_id])) {
 		/* WAR: RX_HDR is not received for this MPDU, drop this frame */
 		mon_pdev->rx_mon_stats.rx_hdr_not_received++;
-		DP_STATS_INC(mon_soc, frag_free, 1);
-		qdf_frag_free(addr);
+		dp_rx_mon_drop_frag_free(soc, addr);
 		return num_buf_reaped;
 	}
 
@@ -888,17 +917,15 @@ dp_rx_mon_handle_mon_buf_addr(struct dp_pdev *pdev,
 			(DP_MON_DATA_BUFFER_SIZE - DP_RX_MON_PACKET_OFFSET)) {
 		/* WAR: Invalid DMA length is received for this MPDU */
 		mon_pdev->rx_mon_stats.invalid_dma_length++;
-		DP_STATS_INC(mon_soc, frag_free, 1);
-		qdf_frag_free(addr);
+		dp_rx_mon_drop_frag_free(soc, addr);
 		return num_buf_reaped;
 	}
 
 	nbuf = qdf_nbuf_queue_last(&ppdu_info->mpdu_q[user_id]);
 	if (qdf_unlikely(!nbuf)) {
 		dp_mon_debug("nbuf is NULL");
-		DP_STATS_INC(mon_soc, frag_free, 1);
 		DP_STATS_INC(mon_soc, empty_queue, 1);
-		qdf_frag_free(addr);
+		dp_rx_mon_drop_frag_free(soc, addr);
 		return num_buf_reaped;
 	}
 
@@ -906,9 +933,8 @@ dp_rx_mon_handle_mon_buf_addr(struct dp_pdev *pdev,
 	if (mpdu_info->decap_type == DP_MON_DECAP_FORMAT_INVALID) {
 		/* decap type is invalid, drop the frame */
 		mon_pdev->rx_mon_stats.mpdu_decap_type_invalid++;
-		DP_STATS_INC(mon_soc, frag_free, 1);
 		mon_pdev->rx_mon_stats.parent_buf_free++;
-		qdf_frag_free(addr);
+		dp_rx_mon_drop_frag_free(soc, addr);
 		qdf_nbuf_queue_remove_last(&ppdu_info->mpdu_q[user_id]);
 		qdf_nbuf_free(nbuf);
 		/* if invalid decap type handling is disabled, assert */
@@ -929,9 +955,8 @@ dp_rx_mon_handle_mon_buf_addr(struct dp_pdev *pdev,
 					  4, FALSE);
 		if (qdf_unlikely(!tmp_nbuf)) {
 			dp_mon_err("nbuf is NULL");
-			DP_STATS_INC(mon_soc, frag_free, 1);
 			mon_pdev->rx_mon_stats.parent_buf_free++;
-			qdf_frag_free(addr);
+			dp_rx_mon_drop_frag_free(soc, addr);
 			/* remove this nbuf from queue */
 			qdf_nbuf_queue_remove_last(&ppdu_info->mpdu_q[user_id]);
 			qdf_nbuf_free(nbuf);
@@ -1783,7 +1808,6 @@ dp_rx_mon_flush_packet_tlv(struct dp_pdev *pdev, void *buf, uint16_t end_offset,
 	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
 	struct dp_mon_pdev_be *mon_pdev_be =
 			dp_get_be_mon_pdev_from_dp_mon_pdev(mon_pdev);
-	struct dp_mon_soc *mon_soc = soc->monitor_soc;
 	uint16_t work_done = 0;
 	qdf_frag_t addr;
 	uint8_t *rx_tlv;
@@ -1853,10 +1877,8 @@ dp_rx_mon_flush_packet_tlv(struct dp_pdev *pdev, void *buf, uint16_t end_offset,
 			dp_mon_add_to_free_desc_list(desc_list, tail, mon_desc);
 			work_done++;
 
-			if (addr) {
-				qdf_frag_free(addr);
-				DP_STATS_INC(mon_soc, frag_free, 1);
-			}
+			if (addr)
+				dp_rx_mon_drop_frag_free(soc, addr);
 		}
 
 end:
@@ -1929,8 +1951,8 @@ dp_rx_mon_flush_status_buf_queue(struct dp_pdev *pdev)
 		mon_pdev_be->status[idx] = NULL;
 		mon_pdev_be->desc_count--;
 
-		qdf_frag_free(buf);
-		DP_STATS_INC(mon_soc, frag_free, 1);
+		/* not parsed yet, so no RX_HDR frag references it */
+		dp_rx_mon_drop_frag_free(soc, buf);
 	}
 
 	if (work_done) {
@@ -1973,10 +1995,8 @@ dp_rx_mon_handle_flush_n_trucated_ppdu(struct dp_soc *soc,
 	work_done = 1;
 	work_done += dp_rx_mon_flush_packet_tlv(pdev, buf, end_offset,
 						&desc_list, &tail);
-	if (buf) {
-		qdf_frag_free(buf);
-		DP_STATS_INC(mon_soc, frag_free, 1);
-	}
+	if (buf)
+		dp_rx_mon_drop_frag_free(soc, buf);
 
 	if (desc_list)
 		dp_mon_add_desc_list_to_free_list(soc, &desc_list, &tail,
@@ -2725,6 +2745,8 @@ void dp_mon_rx_print_advanced_stats_2_0(struct dp_soc *soc,
 		       mon_soc->stats.frag_free);
 	DP_PRINT_STATS("frag_free due to empty queue= %d",
 		       mon_soc->stats.empty_queue);
+	DP_PRINT_STATS("frag_recycle (dropped bufs reused) = %d",
+		       mon_soc->stats.frag_recycle);
 	DP_PRINT_STATS("status_buf_count = %d",
 		       rx_mon_stats->status_buf_count);
 	DP_PRINT_STATS("pkt_buf_count = %d",
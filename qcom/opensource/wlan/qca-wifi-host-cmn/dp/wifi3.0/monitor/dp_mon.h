@@ -889,11 +889,14 @@ struct dp_mon_ops {
  * @frag_alloc: Number of frags allocated
  * @frag_free: Number of frags freed
  * @empty_queue: Number of frags freed due to empty queue
+ * @frag_recycle: Number of frags dropped on error or flush and kept for
+ *		  reuse on replenish
  */
 struct dp_mon_soc_stats {
 	uint32_t frag_alloc;
 	uint32_t frag_free;
 	uint32_t empty_queue;
+	uint32_t frag_recycle;
 };
 
 struct dp_mon_soc {
@@ -450,6 +450,7 @@ static void *dp_soc_init_rh(struct dp_soc *soc, HTC_HANDLE htc_handle,
 	soc->rx.flags.defrag_timeout_check =
 		wlan_cfg_get_defrag_timeout_check(soc->wlan_cfg_ctx);
 	qdf_spinlock_create(&soc->rx.defrag.defrag_lock);
+	qdf_atomic_init(&soc->rx.defrag.pending_frags);
 
 	dp_monitor_soc_init(soc);
 
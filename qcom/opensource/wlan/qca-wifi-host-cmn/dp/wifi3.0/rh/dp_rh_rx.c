@@ -1460,6 +1460,13 @@ QDF_STATUS dp_rx_defrag_store_fragment_rh(struct dp_soc *soc, qdf_nbuf_t frag)
 			qdf_spin_unlock_bh(&rx_tid->defrag_tid_lock);
 			goto discard_frag;
 		}
+		/* Do not start a new sequence while too many are pending */
+		if (qdf_atomic_read(&soc->rx.defrag.pending_frags) >=
+		    DP_RX_DEFRAG_MAX_PENDING_FRAGS) {
+			qdf_spin_unlock_bh(&rx_tid->defrag_tid_lock);
+			DP_STATS_INC(soc, rx.rx_frag_flood_drop, 1);
+			goto discard_frag;
+		}
 		dp_rx_debug("cur rxseq %d\n", rxseq);
 		/* Start of a new sequence */
 		dp_rx_defrag_cleanup(txrx_peer, tid);
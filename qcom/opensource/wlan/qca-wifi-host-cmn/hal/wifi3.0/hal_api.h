@@ -1315,6 +1315,21 @@ void hal_srng_dst_init_hp(struct hal_soc_handle *hal_soc,
 			  struct hal_srng *srng,
 			  uint32_t *vaddr);
 
+/**
+ * hal_srng_dst_set_intr_moderation() - Reprogram the interrupt thresholds
+ *					of a destination ring
+ * @hal_ring_hdl: Opaque HAL SRNG pointer
+ * @timer_us: interrupt timer threshold in microseconds, 0 to disable
+ * @batch_cnt: interrupt batch counter threshold in ring entries,
+ *	       0 to disable
+ *
+ * Must be called from the context servicing the ring.
+ *
+ * Return: None
+ */
+void hal_srng_dst_set_intr_moderation(hal_ring_handle_t hal_ring_hdl,
+				      uint32_t timer_us, uint32_t batch_cnt);
+
 /**
  * hal_srng_dst_update_hp_addr() - Update hp_addr with current HW HP value
  * @hal_soc: hal_soc handle
@@ -1966,6 +1981,23 @@ hal_srng_src_get_next_reaped(void *hal_soc, hal_ring_handle_t hal_ring_hdl)
 	return NULL;
 }
 
+/**
+ * hal_srng_src_num_reaped() - Number of reaped source ring entries
+ * @hal_soc: Opaque HAL SOC handle
+ * @hal_ring_hdl: Source ring pointer
+ *
+ * Return: number of entries hal_srng_src_get_next_reaped() can return
+ * before more entries are reaped
+ */
+static inline uint32_t
+hal_srng_src_num_reaped(void *hal_soc, hal_ring_handle_t hal_ring_hdl)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+
+	return ((srng->u.src_ring.reap_hp + srng->ring_size -
+		 srng->u.src_ring.hp) % srng->ring_size) / srng->entry_size;
+}
+
 /**
  * hal_srng_src_pending_reap_next() - Reap next entry from a source ring
  * @hal_soc: Opaque HAL SOC handle
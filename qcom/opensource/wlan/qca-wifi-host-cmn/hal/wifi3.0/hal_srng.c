@@ -1552,6 +1552,37 @@ void hal_srng_dst_init_hp(struct hal_soc_handle *hal_soc,
 
 qdf_export_symbol(hal_srng_dst_init_hp);
 
+void hal_srng_dst_set_intr_moderation(hal_ring_handle_t hal_ring_hdl,
+				      uint32_t timer_us, uint32_t batch_cnt)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t reg_val = 0;
+
+	if (!srng || srng->ring_dir != HAL_SRNG_DST_RING)
+		return;
+
+	if (srng->intr_timer_thres_us == timer_us &&
+	    srng->intr_batch_cntr_thres_entries == batch_cnt)
+		return;
+
+	srng->intr_timer_thres_us = timer_us;
+	srng->intr_batch_cntr_thres_entries = batch_cnt;
+
+	if (timer_us)
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+					       INTERRUPT_TIMER_THRESHOLD),
+				   timer_us >> 3);
+
+	if (batch_cnt)
+		reg_val |= SRNG_SM(SRNG_DST_FLD(PRODUCER_INT_SETUP,
+					       BATCH_COUNTER_THRESHOLD),
+				   batch_cnt * srng->entry_size);
+
+	SRNG_DST_REG_WRITE(srng, PRODUCER_INT_SETUP, reg_val);
+}
+
+qdf_export_symbol(hal_srng_dst_set_intr_moderation);
+
 void hal_srng_dst_update_hp_addr(struct hal_soc_handle *hal_soc,
 				 hal_ring_handle_t hal_ring_hdl)
 {
@@ -2084,6 +2084,16 @@ enum hif_exec_type {
 
 typedef uint32_t (*ext_intr_handler)(void *, uint32_t, int);
 
+/**
+ * typedef ext_intr_moderation_cb() - Program interrupt moderation of the
+ *				       rings serviced by an ext group
+ * @cb_ctx: context registered with the ext group
+ * @timer_us: interrupt timer threshold in microseconds
+ * @batch_cnt: interrupt batch counter threshold in ring entries
+ */
+typedef void (*ext_intr_moderation_cb)(void *cb_ctx, uint32_t timer_us,
+				       uint32_t batch_cnt);
+
 /**
  * hif_get_int_ctx_irq_num() - retrieve an irq num for an interrupt context id
  * @softc: hif opaque context owning the exec context
@@ -2134,6 +2144,33 @@ QDF_STATUS hif_register_ext_group(struct hif_opaque_softc *hif_ctx,
 void hif_deregister_exec_group(struct hif_opaque_softc *hif_ctx,
 				const char *context_name);
 
+#if defined(FEATURE_NAPI) && defined(HIF_NAPI_DIM)
+/**
+ * hif_register_ext_group_moderation_cb() - Register the interrupt
+ *					     moderation callback of an ext group
+ * @hif_ctx: HIF Context
+ * @cb_ctx: context the ext group was registered with
+ * @cb: callback programming the interrupt thresholds of the group rings
+ *
+ * The NAPI poll of the group adapts its budget and the interrupt
+ * thresholds of its rings to the traffic seen in the polls. @cb is called
+ * once from here to program the default level, then from the poll context
+ * whenever the thresholds are to be changed.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS hif_register_ext_group_moderation_cb(struct hif_opaque_softc *hif_ctx,
+						void *cb_ctx,
+						ext_intr_moderation_cb cb);
+#else
+static inline QDF_STATUS
+hif_register_ext_group_moderation_cb(struct hif_opaque_softc *hif_ctx,
+				     void *cb_ctx, ext_intr_moderation_cb cb)
+{
+	return QDF_STATUS_SUCCESS;
+}
+#endif
+
 void hif_update_pipe_callback(struct hif_opaque_softc *osc,
 				u_int8_t pipeid,
 				struct hif_msg_callbacks *callbacks);
@@ -157,6 +157,44 @@ void hif_record_ce_srng_desc_event(struct hif_softc *scn, int ce_id,
 }
 #endif /* HIF_CONFIG_SLUB_DEBUG_ON || HIF_CE_DEBUG_DATA_BUF */
 
+/**
+ * ce_srng_src_desc_fill() - Fill a source ring descriptor
+ * @CE_state: copy engine state
+ * @src_desc: descriptor to fill
+ * @buffer: physical address of the buffer
+ * @nbytes: number of bytes to send
+ * @transfer_id: transfer id, sent as descriptor meta data
+ * @flags: CE_SEND_FLAG_* flags
+ *
+ * Return: None
+ */
+static inline void
+ce_srng_src_desc_fill(struct CE_state *CE_state,
+		      struct ce_srng_src_desc *src_desc,
+		      qdf_dma_addr_t buffer, uint32_t nbytes,
+		      uint32_t transfer_id, uint32_t flags)
+{
+	uint64_t dma_addr = buffer;
+
+	/* Update low 32 bits source descriptor address */
+	src_desc->buffer_addr_lo = (uint32_t)(dma_addr & 0xFFFFFFFF);
+	src_desc->buffer_addr_hi = (uint32_t)((dma_addr >> 32) & 0xFF);
+
+	src_desc->meta_data = transfer_id;
+
+	/*
+	 * Set the swap bit if:
+	 * typical sends on this CE are swapped (host is big-endian)
+	 * and this send doesn't disable the swapping
+	 * (data is not bytestream)
+	 */
+	src_desc->byte_swap =
+		(((CE_state->attr_flags & CE_ATTR_BYTE_SWAP_DATA)
+		  != 0) & ((flags & CE_SEND_FLAG_SWAP_DISABLE) == 0));
+	src_desc->gather = ((flags & CE_SEND_FLAG_GATHER) != 0);
+	src_desc->nbytes = nbytes;
+}
+
 static QDF_STATUS
 ce_send_nolock_srng(struct CE_handle *copyeng,
 			   void *per_transfer_context,
@@ -171,7 +209,6 @@ ce_send_nolock_srng(struct CE_handle *copyeng,
 	struct CE_ring_state *src_ring = CE_state->src_ring;
 	unsigned int nentries_mask = src_ring->nentries_mask;
 	unsigned int write_index = src_ring->write_index;
-	uint64_t dma_addr = buffer;
 	struct hif_softc *scn = CE_state->scn;
 
 	if (Q_TARGET_ACCESS_BEGIN(scn) < 0)
@@ -198,25 +235,8 @@ ce_send_nolock_srng(struct CE_handle *copyeng,
 			return QDF_STATUS_E_INVAL;
 		}
 
-		/* Update low 32 bits source descriptor address */
-		src_desc->buffer_addr_lo =
-			(uint32_t)(dma_addr & 0xFFFFFFFF);
-		src_desc->buffer_addr_hi =
-			(uint32_t)((dma_addr >> 32) & 0xFF);
-
-		src_desc->meta_data = transfer_id;
-
-		/*
-		 * Set the swap bit if:
-		 * typical sends on this CE are swapped (host is big-endian)
-		 * and this send doesn't disable the swapping
-		 * (data is not bytestream)
-		 */
-		src_desc->byte_swap =
-			(((CE_state->attr_flags & CE_ATTR_BYTE_SWAP_DATA)
-			  != 0) & ((flags & CE_SEND_FLAG_SWAP_DISABLE) == 0));
-		src_desc->gather = ((flags & CE_SEND_FLAG_GATHER) != 0);
-		src_desc->nbytes = nbytes;
+		ce_srng_src_desc_fill(CE_state, src_desc, buffer, nbytes,
+				      transfer_id, flags);
 
 		src_ring->per_transfer_context[write_index] =
 			per_transfer_context;
@@ -240,6 +260,20 @@ ce_send_nolock_srng(struct CE_handle *copyeng,
 	return status;
 }
 
+/**
+ * ce_sendlist_send_srng() - Post a gather list to a copy engine
+ * @copyeng: copy engine handle
+ * @per_transfer_context: context returned on completion of the last item
+ * @sendlist: list of buffers to send
+ * @transfer_id: transfer id, sent as descriptor meta data
+ *
+ * All items are posted under a single ring access, so the ring head
+ * pointer is written to the target once per list instead of once per
+ * item. The list is posted only if enough ring entries are reaped for
+ * all of it, nothing is written to the ring otherwise.
+ *
+ * Return: QDF_STATUS_SUCCESS if the list is posted
+ */
 static QDF_STATUS
 ce_sendlist_send_srng(struct CE_handle *copyeng,
 		 void *per_transfer_context,
@@ -249,60 +283,93 @@ ce_sendlist_send_srng(struct CE_handle *copyeng,
 	struct ce_sendlist_s *sl = (struct ce_sendlist_s *)sendlist;
 	struct CE_state *CE_state = (struct CE_state *)copyeng;
 	struct CE_ring_state *src_ring = CE_state->src_ring;
+	unsigned int nentries_mask = src_ring->nentries_mask;
 	unsigned int num_items = sl->num_items;
-	unsigned int sw_index;
 	unsigned int write_index;
 	struct hif_softc *scn = CE_state->scn;
+	struct ce_sendlist_item *item;
+	struct ce_srng_src_desc *src_desc;
+	void *context;
+	uint32_t flags;
+	unsigned int i;
 
 	QDF_ASSERT((num_items > 0) && (num_items < src_ring->nentries));
 
 	qdf_spin_lock_bh(&CE_state->ce_index_lock);
-	sw_index = src_ring->sw_index;
-	write_index = src_ring->write_index;
+	if (Q_TARGET_ACCESS_BEGIN(scn) < 0) {
+		status = QDF_STATUS_E_FAILURE;
+		goto unlock;
+	}
 
-	if (hal_srng_src_num_avail(scn->hal_soc, src_ring->srng_ctx, false) >=
+	if (hal_srng_access_start(scn->hal_soc, src_ring->srng_ctx)) {
+		status = QDF_STATUS_E_FAILURE;
+		goto target_access_end;
+	}
+
+	/*
+	 * Probably not worth the additional complexity to support
+	 * partial sends with continuation or notification.  We expect
+	 * to use large rings and small sendlists. If we can't handle
+	 * the entire request at once, punt it back to the caller.
+	 * Entries are taken from the reaped ones, which can be fewer than
+	 * the free ones, so check those before writing any of the list.
+	 */
+	if (hal_srng_src_num_reaped(scn->hal_soc, src_ring->srng_ctx) <
 	    num_items) {
-		struct ce_sendlist_item *item;
-		int i;
-
-		/* handle all but the last item uniformly */
-		for (i = 0; i < num_items - 1; i++) {
-			item = &sl->item[i];
-			/* TBDXXX: Support extensible sendlist_types? */
-			QDF_ASSERT(item->send_type == CE_SIMPLE_BUFFER_TYPE);
-			status = ce_send_nolock_srng(copyeng,
-					CE_SENDLIST_ITEM_CTXT,
-				(qdf_dma_addr_t) item->data,
-				item->u.nbytes, transfer_id,
-				item->flags | CE_SEND_FLAG_GATHER,
-				item->user_flags);
-			QDF_ASSERT(status == QDF_STATUS_SUCCESS);
-		}
-		/* provide valid context pointer for final item */
+		hal_srng_access_end_reap(scn->hal_soc, src_ring->srng_ctx);
+		OL_ATH_CE_PKT_ERROR_COUNT_INCR(scn, CE_RING_DELTA_FAIL);
+		goto target_access_end;
+	}
+
+	write_index = src_ring->write_index;
+	for (i = 0; i < num_items; i++) {
 		item = &sl->item[i];
 		/* TBDXXX: Support extensible sendlist_types? */
 		QDF_ASSERT(item->send_type == CE_SIMPLE_BUFFER_TYPE);
-		status = ce_send_nolock_srng(copyeng, per_transfer_context,
-					(qdf_dma_addr_t) item->data,
-					item->u.nbytes,
-					transfer_id, item->flags,
-					item->user_flags);
-		QDF_ASSERT(status == QDF_STATUS_SUCCESS);
-		QDF_NBUF_UPDATE_TX_PKT_COUNT((qdf_nbuf_t)per_transfer_context,
-					QDF_NBUF_TX_PKT_CE);
-		DPTRACE(qdf_dp_trace((qdf_nbuf_t)per_transfer_context,
-			QDF_DP_TRACE_CE_PACKET_PTR_RECORD,
-			QDF_TRACE_DEFAULT_PDEV_ID,
-			(uint8_t *)(((qdf_nbuf_t)per_transfer_context)->data),
-			sizeof(((qdf_nbuf_t)per_transfer_context)->data), QDF_TX));
-	} else {
-		/*
-		 * Probably not worth the additional complexity to support
-		 * partial sends with continuation or notification.  We expect
-		 * to use large rings and small sendlists. If we can't handle
-		 * the entire request at once, punt it back to the caller.
-		 */
+
+		src_desc = hal_srng_src_get_next_reaped(scn->hal_soc,
+							src_ring->srng_ctx);
+
+		/* provide valid context pointer for final item only */
+		if (i == num_items - 1) {
+			context = per_transfer_context;
+			flags = item->flags;
+		} else {
+			context = CE_SENDLIST_ITEM_CTXT;
+			flags = item->flags | CE_SEND_FLAG_GATHER;
+		}
+
+		ce_srng_src_desc_fill(CE_state, src_desc,
+				      (qdf_dma_addr_t)item->data,
+				      item->u.nbytes, transfer_id, flags);
+		src_ring->per_transfer_context[write_index] = context;
+
+		hif_record_ce_srng_desc_event(scn, CE_state->id,
+					      HIF_CE_SRC_RING_BUFFER_POST,
+					      (union ce_srng_desc *)src_desc,
+					      context, write_index,
+					      item->u.nbytes,
+					      src_ring->srng_ctx);
+
+		write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
 	}
+
+	hal_srng_access_end(scn->hal_soc, src_ring->srng_ctx);
+	src_ring->write_index = write_index;
+
+	status = QDF_STATUS_SUCCESS;
+	QDF_NBUF_UPDATE_TX_PKT_COUNT((qdf_nbuf_t)per_transfer_context,
+				     QDF_NBUF_TX_PKT_CE);
+	DPTRACE(qdf_dp_trace((qdf_nbuf_t)per_transfer_context,
+		QDF_DP_TRACE_CE_PACKET_PTR_RECORD,
+		QDF_TRACE_DEFAULT_PDEV_ID,
+		(uint8_t *)(((qdf_nbuf_t)per_transfer_context)->data),
+		sizeof(((qdf_nbuf_t)per_transfer_context)->data),
+		QDF_TX));
+
+target_access_end:
+	Q_TARGET_ACCESS_END(scn);
+unlock:
 	qdf_spin_unlock_bh(&CE_state->ce_index_lock);
 
 	return status;
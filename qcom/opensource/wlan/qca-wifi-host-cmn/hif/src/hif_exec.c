@@ -274,6 +274,35 @@ static void hif_print_napi_latency_stats(struct HIF_CE_state *hif_state)
 }
 #endif
 
+#if defined(FEATURE_NAPI) && defined(HIF_NAPI_DIM)
+/**
+ * hif_print_napi_dim_stats() - print NAPI interrupt moderation state
+ * @hif_state: hif context
+ *
+ * return: void
+ */
+static void hif_print_napi_dim_stats(struct HIF_CE_state *hif_state)
+{
+	struct hif_exec_context *hif_ext_group;
+	int i;
+
+	for (i = 0; i < hif_state->hif_num_extgroup; i++) {
+		hif_ext_group = hif_state->hif_ext_group[i];
+		if (!hif_ext_group || hif_ext_group->type != HIF_EXEC_NAPI_TYPE)
+			continue;
+
+		QDF_TRACE(QDF_MODULE_ID_HIF, QDF_TRACE_LEVEL_INFO_HIGH,
+			  "NAPI[%d] moderation level %u changes %u",
+			  i, hif_ext_group->dim.level,
+			  hif_ext_group->dim.level_changes);
+	}
+}
+#else
+static void hif_print_napi_dim_stats(struct HIF_CE_state *hif_state)
+{
+}
+#endif
+
 /**
  * hif_clear_napi_stats() - reset NAPI stats
  * @hif_ctx: hif context
@@ -365,6 +394,7 @@ void hif_print_napi_stats(struct hif_opaque_softc *hif_ctx)
 	}
 
 	hif_print_napi_latency_stats(hif_state);
+	hif_print_napi_dim_stats(hif_state);
 }
 
 qdf_export_symbol(hif_print_napi_stats);
@@ -405,6 +435,7 @@ void hif_print_napi_stats(struct hif_opaque_softc *hif_ctx)
 	}
 
 	hif_print_napi_latency_stats(hif_state);
+	hif_print_napi_dim_stats(hif_state);
 }
 qdf_export_symbol(hif_print_napi_stats);
 #endif /* WLAN_FEATURE_RX_SOFTIRQ_TIME_LIMIT */
@@ -626,6 +657,181 @@ hif_is_force_napi_complete_required(struct hif_exec_context *hif_ext_group)
 }
 #endif
 
+#ifdef HIF_NAPI_DIM
+/* number of polls after which the moderation level is re-evaluated */
+#define HIF_NAPI_DIM_WINDOW_POLLS 64
+/* consecutive windows needed before the level is changed */
+#define HIF_NAPI_DIM_HYSTERESIS 2
+
+/**
+ * struct hif_napi_dim_profile - NAPI interrupt moderation level
+ * @timer_us: SRNG interrupt timer threshold
+ * @batch_cnt: SRNG interrupt batch counter threshold
+ * @budget_shift: right shift applied to the internal poll budget
+ * @work_low: average work per poll below which the level is lowered
+ * @work_high: average work per poll above which the level is raised
+ */
+struct hif_napi_dim_profile {
+	uint32_t timer_us;
+	uint32_t batch_cnt;
+	uint8_t budget_shift;
+	uint32_t work_low;
+	uint32_t work_high;
+};
+
+/*
+ * Level 0 interrupts on every entry and polls with a small budget, for
+ * sparse latency sensitive traffic. The last level batches interrupts and
+ * polls with the full budget for bulk traffic.
+ */
+static const struct hif_napi_dim_profile hif_napi_dim_profiles[] = {
+	{8, 1, 2, 0, 4},
+	{32, 4, 1, 2, 16},
+	{64, 16, 0, 8, 64},
+	{128, 32, 0, 32, 160},
+	{256, 64, 0, 96, UINT_MAX},
+};
+
+#define HIF_NAPI_DIM_NUM_LEVELS QDF_ARRAY_SIZE(hif_napi_dim_profiles)
+
+/**
+ * hif_exec_dim_budget() - Get the internal poll budget of the current
+ *			   moderation level
+ * @hif_ext_group: hif exec context
+ * @budget: internal budget derived from the NAPI budget
+ *
+ * Return: internal budget to poll with
+ */
+static inline int hif_exec_dim_budget(struct hif_exec_context *hif_ext_group,
+				      int budget)
+{
+	uint8_t shift =
+		hif_napi_dim_profiles[hif_ext_group->dim.level].budget_shift;
+
+	if (!budget || !hif_ext_group->moderation_cb)
+		return budget;
+
+	return QDF_MAX(budget >> shift, 1);
+}
+
+/**
+ * hif_exec_dim_program_level() - Program the rings of an exec context with
+ *				  the thresholds of a moderation level
+ * @hif_ext_group: hif exec context
+ * @level: moderation level
+ *
+ * Return: None
+ */
+static void hif_exec_dim_program_level(struct hif_exec_context *hif_ext_group,
+				       uint8_t level)
+{
+	const struct hif_napi_dim_profile *profile =
+					&hif_napi_dim_profiles[level];
+
+	hif_ext_group->dim.level = level;
+	hif_ext_group->moderation_cb(hif_ext_group->context,
+				     profile->timer_us, profile->batch_cnt);
+}
+
+/**
+ * hif_exec_dim_set_level() - Move an exec context to a moderation level
+ * @hif_ext_group: hif exec context
+ * @level: new moderation level
+ *
+ * Return: None
+ */
+static void hif_exec_dim_set_level(struct hif_exec_context *hif_ext_group,
+				   uint8_t level)
+{
+	const struct hif_napi_dim_profile *profile =
+					&hif_napi_dim_profiles[level];
+
+	hif_ext_group->dim.level_changes++;
+	hif_exec_dim_program_level(hif_ext_group, level);
+
+	hif_debug("grp %d moderation level %u timer %uus batch %u",
+		  hif_ext_group->grp_id, level, profile->timer_us,
+		  profile->batch_cnt);
+}
+
+/**
+ * hif_exec_dim_update() - Feed a poll to the interrupt moderation controller
+ * @hif_ext_group: hif exec context
+ * @work_done: work done in the poll
+ * @budget: internal budget the poll ran with
+ *
+ * The packets per poll and the share of polls consuming the whole budget
+ * are sampled over a window of polls. A busy window moves the context to
+ * a level with fewer interrupts and a larger budget, an idle one back
+ * towards per packet interrupts. A level change is only made after
+ * HIF_NAPI_DIM_HYSTERESIS windows agree on its direction.
+ *
+ * Only contexts with a moderation callback are controlled. Must be called
+ * from the poll of the context.
+ *
+ * Return: None
+ */
+static void hif_exec_dim_update(struct hif_exec_context *hif_ext_group,
+				int work_done, int budget)
+{
+	struct hif_napi_dim *dim = &hif_ext_group->dim;
+	const struct hif_napi_dim_profile *profile;
+	uint32_t avg_work;
+	int8_t dir = 0;
+
+	if (!hif_ext_group->moderation_cb)
+		return;
+
+	dim->polls++;
+	dim->work += work_done;
+	if (work_done >= budget || hif_ext_group->force_break)
+		dim->full_polls++;
+
+	if (dim->polls < HIF_NAPI_DIM_WINDOW_POLLS)
+		return;
+
+	profile = &hif_napi_dim_profiles[dim->level];
+	avg_work = dim->work / dim->polls;
+
+	/* polls running out of budget more than a quarter of the time */
+	if ((avg_work > profile->work_high || dim->full_polls * 4 > dim->polls) &&
+	    dim->level < HIF_NAPI_DIM_NUM_LEVELS - 1)
+		dir = 1;
+	else if (avg_work < profile->work_low && !dim->full_polls &&
+		 dim->level > 0)
+		dir = -1;
+
+	if (dir && dir == dim->pending_dir) {
+		dim->pending_cnt++;
+	} else {
+		dim->pending_dir = dir;
+		dim->pending_cnt = dir ? 1 : 0;
+	}
+
+	if (dim->pending_cnt >= HIF_NAPI_DIM_HYSTERESIS) {
+		hif_exec_dim_set_level(hif_ext_group, dim->level + dir);
+		dim->pending_dir = 0;
+		dim->pending_cnt = 0;
+	}
+
+	dim->polls = 0;
+	dim->work = 0;
+	dim->full_polls = 0;
+}
+#else
+static inline int hif_exec_dim_budget(struct hif_exec_context *hif_ext_group,
+				      int budget)
+{
+	return budget;
+}
+
+static inline void
+hif_exec_dim_update(struct hif_exec_context *hif_ext_group,
+		    int work_done, int budget)
+{
+}
+#endif /* HIF_NAPI_DIM */
+
 /**
  * hif_irq_disabled_time_limit_reached() - determine if irq disabled limit
  * reached for single MSI
@@ -667,6 +873,7 @@ static int hif_exec_poll(struct napi_struct *napi, int budget)
 	struct hif_softc *scn = HIF_GET_SOFTC(hif_ext_group->hif);
 	int work_done;
 	int normalized_budget = 0;
+	int dim_budget;
 	int actual_dones;
 	int shift = hif_ext_group->scale_bin_shift;
 	int cpu = smp_processor_id();
@@ -683,10 +890,16 @@ static int hif_exec_poll(struct napi_struct *napi, int budget)
 
 	hif_latency_profile_measure(hif_ext_group);
 
+	/*
+	 * The moderation level only limits the work of the handler, a poll
+	 * which is not completed still reports the full NAPI budget.
+	 */
+	dim_budget = hif_exec_dim_budget(hif_ext_group, normalized_budget);
 	work_done = hif_ext_group->handler(hif_ext_group->context,
-					   normalized_budget, cpu);
+					   dim_budget, cpu);
 
 	actual_dones = work_done;
+	hif_exec_dim_update(hif_ext_group, actual_dones, dim_budget);
 
 	if (hif_is_force_napi_complete_required(hif_ext_group)) {
 		force_complete = true;
@@ -695,7 +908,7 @@ static int hif_exec_poll(struct napi_struct *napi, int budget)
 	}
 
 	if (qdf_unlikely(force_complete) ||
-	    (!hif_ext_group->force_break && work_done < normalized_budget) ||
+	    (!hif_ext_group->force_break && work_done < dim_budget) ||
 	    ((pld_is_one_msi(scn->qdf_dev->dev) &&
 	    hif_irq_disabled_time_limit_reached(hif_ext_group)))) {
 		hif_record_event(hif_ext_group->hif, hif_ext_group->grp_id,
@@ -1102,6 +1315,35 @@ QDF_STATUS hif_register_ext_group(struct hif_opaque_softc *hif_ctx,
 }
 qdf_export_symbol(hif_register_ext_group);
 
+#if defined(FEATURE_NAPI) && defined(HIF_NAPI_DIM)
+QDF_STATUS hif_register_ext_group_moderation_cb(struct hif_opaque_softc *hif_ctx,
+						void *cb_ctx,
+						ext_intr_moderation_cb cb)
+{
+	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(hif_ctx);
+	struct hif_exec_context *hif_ext_group;
+	int i;
+
+	for (i = 0; i < hif_state->hif_num_extgroup; i++) {
+		hif_ext_group = hif_state->hif_ext_group[i];
+		if (!hif_ext_group || hif_ext_group->context != cb_ctx)
+			continue;
+
+		qdf_mem_zero(&hif_ext_group->dim, sizeof(hif_ext_group->dim));
+		hif_ext_group->moderation_cb = cb;
+		/* rings start with the thresholds of the default level */
+		hif_exec_dim_program_level(hif_ext_group,
+					   HIF_NAPI_DIM_DEFAULT_LEVEL);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	hif_err("No ext group registered for context %pK", cb_ctx);
+	return QDF_STATUS_E_INVAL;
+}
+
+qdf_export_symbol(hif_register_ext_group_moderation_cb);
+#endif
+
 /**
  * hif_exec_create() - create an execution context
  * @type: the type of execution context to create
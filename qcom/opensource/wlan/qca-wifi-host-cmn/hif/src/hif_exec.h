@@ -30,6 +30,32 @@
 
 struct hif_exec_context;
 
+#ifdef HIF_NAPI_DIM
+/* moderation level of a context until its traffic has been sampled */
+#define HIF_NAPI_DIM_DEFAULT_LEVEL 2
+
+/**
+ * struct hif_napi_dim - state of the NAPI interrupt moderation controller
+ *			 of an execution context
+ * @level: current moderation level, index into the profile table
+ * @pending_dir: direction of the last requested level change
+ * @pending_cnt: number of consecutive windows requesting @pending_dir
+ * @polls: number of polls in the current window
+ * @work: work done in the current window
+ * @full_polls: polls of the current window which consumed the budget
+ * @level_changes: number of level changes since init
+ */
+struct hif_napi_dim {
+	uint8_t level;
+	int8_t pending_dir;
+	uint8_t pending_cnt;
+	uint32_t polls;
+	uint32_t work;
+	uint32_t full_polls;
+	uint32_t level_changes;
+};
+#endif
+
 struct hif_execution_ops {
 	char *context_type;
 	void (*schedule)(struct hif_exec_context *);
@@ -77,6 +103,9 @@ struct hif_execution_ops {
  * @new_cpu_mask: Stores the affinity hint mask for each WLAN IRQ
  * @force_napi_complete: do a force napi_complete when this flag is set to -1
  * @irq_disabled_start_time: irq disabled start time for single MSI
+ * @moderation_cb: callback to program interrupt moderation of the rings
+ *		   serviced by this context
+ * @dim: interrupt moderation controller state
  */
 struct hif_exec_context {
 	struct hif_execution_ops *sched_ops;
@@ -116,6 +145,10 @@ struct hif_exec_context {
 	qdf_atomic_t force_napi_complete;
 #endif
 	unsigned long long irq_disabled_start_time;
+#ifdef HIF_NAPI_DIM
+	ext_intr_moderation_cb moderation_cb;
+	struct hif_napi_dim dim;
+#endif
 };
 
 /**
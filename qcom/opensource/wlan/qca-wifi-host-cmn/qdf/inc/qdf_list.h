@@ -45,6 +45,8 @@
 
 typedef __qdf_list_node_t qdf_list_node_t;
 typedef __qdf_list_t qdf_list_t;
+typedef __qdf_llist_head_t qdf_llist_head_t;
+typedef __qdf_llist_node_t qdf_llist_node_t;
 
 /* Function declarations */
 
@@ -222,4 +224,92 @@ QDF_STATUS qdf_list_join(qdf_list_t *list1, qdf_list_t *list2);
  */
 QDF_STATUS qdf_list_split(qdf_list_t *new, qdf_list_t *list,
 			  qdf_list_node_t *node);
+
+/*
+ * Lock-less singly linked list. Any number of producers may add nodes
+ * concurrently, nodes are taken off either all at once, or one at a time
+ * by a single consumer. Nodes come off in LIFO order.
+ */
+
+/**
+ * qdf_init_llist_head() - initialize a lock-less list
+ * @head: the list head
+ *
+ * Return: none
+ */
+static inline void qdf_init_llist_head(qdf_llist_head_t *head)
+{
+	__qdf_init_llist_head(head);
+}
+
+/**
+ * qdf_llist_add() - add a node to the head of a lock-less list
+ * @node: node to add
+ * @head: the list head
+ *
+ * Return: true if the list was empty before the add
+ */
+static inline bool qdf_llist_add(qdf_llist_node_t *node,
+				 qdf_llist_head_t *head)
+{
+	return __qdf_llist_add(node, head);
+}
+
+/**
+ * qdf_llist_del_first() - take the head node off a lock-less list
+ * @head: the list head
+ *
+ * Must not be called concurrently with another qdf_llist_del_first().
+ *
+ * Return: the node taken off, NULL if the list is empty
+ */
+static inline qdf_llist_node_t *qdf_llist_del_first(qdf_llist_head_t *head)
+{
+	return __qdf_llist_del_first(head);
+}
+
+/**
+ * qdf_llist_del_all() - take all nodes off a lock-less list
+ * @head: the list head
+ *
+ * Return: the first node of the chain taken off, newest first
+ */
+static inline qdf_llist_node_t *qdf_llist_del_all(qdf_llist_head_t *head)
+{
+	return __qdf_llist_del_all(head);
+}
+
+/**
+ * qdf_llist_reverse_order() - reverse a chain taken off a lock-less list
+ * @node: first node of the chain
+ *
+ * Return: first node of the reversed chain, i.e. the oldest one
+ */
+static inline qdf_llist_node_t *
+qdf_llist_reverse_order(qdf_llist_node_t *node)
+{
+	return __qdf_llist_reverse_order(node);
+}
+
+/**
+ * qdf_llist_empty() - check if a lock-less list is empty
+ * @head: the list head
+ *
+ * Return: true if the list is empty
+ */
+static inline bool qdf_llist_empty(const qdf_llist_head_t *head)
+{
+	return __qdf_llist_empty(head);
+}
+
+/**
+ * qdf_llist_next() - next node of a chain taken off a lock-less list
+ * @node: current node
+ *
+ * Return: next node, NULL at the end of the chain
+ */
+static inline qdf_llist_node_t *qdf_llist_next(qdf_llist_node_t *node)
+{
+	return __qdf_llist_next(node);
+}
 #endif /* __QDF_LIST_H */
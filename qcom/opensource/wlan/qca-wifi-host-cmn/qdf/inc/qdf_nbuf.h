@@ -1219,6 +1219,7 @@ typedef __qdf_nbuf_shared_info_t qdf_nbuf_shared_info_t;
  * @smmu_map_pa_addr: nbuf smmu map physical address
  * @smmu_unmap_iova_addr: nbuf smmu unmap virtual address
  * @smmu_unmap_pa_addr: nbuf smmu unmap physical address
+ * @rcu: RCU head to release the node once the nbuf is freed
  */
 struct qdf_nbuf_track_t {
 	struct qdf_nbuf_track_t *p_next;
@@ -1243,6 +1244,7 @@ struct qdf_nbuf_track_t {
 	unsigned long smmu_unmap_iova_addr;
 	unsigned long smmu_unmap_pa_addr;
 #endif
+	qdf_rcu_head_t rcu;
 };
 
 typedef struct qdf_nbuf_track_t QDF_NBUF_TRACK;
@@ -1252,6 +1254,9 @@ typedef struct qdf_nbuf_track_t QDF_NBUF_TRACK;
  */
 typedef __qdf_nbuf_queue_head_t qdf_nbuf_queue_head_t;
 
+/* Pool of DMA mapped pages to build rx nbufs on */
+typedef __qdf_page_pool_t qdf_page_pool_t;
+
 /**
  * typedef qdf_dma_map_cb_t() - Dma map callback prototype
  * @arg: callback context
@@ -2430,6 +2435,18 @@ qdf_nbuf_t qdf_nbuf_alloc_no_recycler_debug(size_t size, int reserve, int align,
 
 void qdf_nbuf_free_debug(qdf_nbuf_t nbuf, const char *func, uint32_t line);
 
+/**
+ * qdf_nbuf_free_partial() - free a network buf merged by
+ *			     qdf_nbuf_try_coalesce()
+ * @d: Network buf which has been merged
+ * @h: head_stolen value returned by qdf_nbuf_try_coalesce()
+ */
+#define qdf_nbuf_free_partial(d, h) \
+	qdf_nbuf_free_partial_debug(d, h, __func__, __LINE__)
+
+void qdf_nbuf_free_partial_debug(qdf_nbuf_t nbuf, bool head_stolen,
+				 const char *func, uint32_t line);
+
 #define qdf_nbuf_free_simple(d) \
 	qdf_nbuf_free_debug_simple(d, __func__, __LINE__)
 
@@ -2645,6 +2662,19 @@ static inline void qdf_nbuf_free(qdf_nbuf_t buf)
 		__qdf_nbuf_free(buf);
 }
 
+/**
+ * qdf_nbuf_free_partial() - free a network buf merged by
+ *			     qdf_nbuf_try_coalesce()
+ * @buf: Network buf which has been merged
+ * @head_stolen: head_stolen value returned by qdf_nbuf_try_coalesce()
+ *
+ * Return: none
+ */
+static inline void qdf_nbuf_free_partial(qdf_nbuf_t buf, bool head_stolen)
+{
+	__qdf_nbuf_free_partial(buf, head_stolen);
+}
+
 /**
  * qdf_nbuf_clone() - clone the nbuf (copy is readonly)
  * @buf: Pointer to network buffer
@@ -2721,6 +2751,102 @@ qdf_nbuf_page_frag_alloc_fl(qdf_device_t osdev, qdf_size_t size, int reserve,
 }
 #endif /* NBUF_MEMORY_DEBUG */
 
+/**
+ * qdf_page_pool_create() - Create a pool of DMA mapped rx pages
+ * @osdev: qdf device the pages are mapped for
+ * @pool_size: number of pages kept by the pool for recycling
+ * @max_len: length from the start of a page synced for the device when
+ *	     the page is recycled
+ *
+ * Return: page pool handle or NULL if page pools are not supported
+ */
+static inline qdf_page_pool_t
+qdf_page_pool_create(qdf_device_t osdev, uint32_t pool_size, uint32_t max_len)
+{
+	return __qdf_page_pool_create(osdev, pool_size, max_len);
+}
+
+/**
+ * qdf_page_pool_destroy() - Destroy a pool of rx pages
+ * @pp: page pool handle
+ *
+ * Return: None
+ */
+static inline void qdf_page_pool_destroy(qdf_page_pool_t pp)
+{
+	__qdf_page_pool_destroy(pp);
+}
+
+/**
+ * qdf_nbuf_page_pool_owned() - Check if an nbuf is built on a page of a
+ *				page pool mapped for a device
+ * @osdev: qdf device
+ * @buf: Network buf
+ *
+ * Return: true if @buf data is on a page pool page mapped for @osdev
+ */
+static inline bool qdf_nbuf_page_pool_owned(qdf_device_t osdev, qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_page_pool_owned(osdev, buf);
+}
+
+#ifdef NBUF_MAP_UNMAP_DEBUG
+bool qdf_nbuf_page_pool_map_debug(qdf_device_t osdev, qdf_nbuf_t buf,
+				  int nbytes, const char *func, uint32_t line);
+
+bool qdf_nbuf_page_pool_unmap_debug(qdf_device_t osdev, qdf_nbuf_t buf,
+				    int nbytes, const char *func,
+				    uint32_t line);
+
+#define qdf_nbuf_page_pool_map(osdev, buf, nbytes) \
+	qdf_nbuf_page_pool_map_debug(osdev, buf, nbytes, __func__, __LINE__)
+
+#define qdf_nbuf_page_pool_unmap(osdev, buf, nbytes) \
+	qdf_nbuf_page_pool_unmap_debug(osdev, buf, nbytes, __func__, __LINE__)
+#else /* NBUF_MAP_UNMAP_DEBUG */
+/**
+ * qdf_nbuf_page_pool_map() - Set the DMA address of a page pool nbuf
+ *			      from the mapping of its page pool
+ * @osdev: qdf device
+ * @buf: Network buf
+ * @nbytes: number of bytes synced for the device
+ *
+ * Return: true if @buf is a page pool nbuf and must not be mapped again
+ */
+static inline bool
+qdf_nbuf_page_pool_map(qdf_device_t osdev, qdf_nbuf_t buf, int nbytes)
+{
+	return __qdf_nbuf_page_pool_map(osdev, buf, nbytes);
+}
+
+/**
+ * qdf_nbuf_page_pool_unmap() - Sync a page pool nbuf for the CPU in place
+ *				of unmapping it
+ * @osdev: qdf device
+ * @buf: Network buf
+ * @nbytes: number of bytes synced for the CPU
+ *
+ * Return: true if @buf is mapped by its page pool and must not be unmapped
+ */
+static inline bool
+qdf_nbuf_page_pool_unmap(qdf_device_t osdev, qdf_nbuf_t buf, int nbytes)
+{
+	return __qdf_nbuf_page_pool_unmap(osdev, buf, nbytes);
+}
+#endif /* NBUF_MAP_UNMAP_DEBUG */
+
+#ifdef NBUF_MEMORY_DEBUG
+#define qdf_nbuf_page_pool_alloc(pp, s, r) \
+	qdf_nbuf_page_pool_alloc_debug(pp, s, r, __func__, __LINE__)
+
+qdf_nbuf_t qdf_nbuf_page_pool_alloc_debug(qdf_page_pool_t pp, qdf_size_t size,
+					  int reserve, const char *func,
+					  uint32_t line);
+#else
+#define qdf_nbuf_page_pool_alloc(pp, s, r) \
+	__qdf_nbuf_page_pool_alloc(pp, s, r, __func__, __LINE__)
+#endif
+
 #if defined(QCA_DP_NBUF_FAST_PPEDS)
 #define qdf_nbuf_alloc_ppe_ds(d, s, r, a, p) \
 	__qdf_nbuf_alloc_ppe_ds(d, s, __func__, __LINE__)
@@ -3382,6 +3508,44 @@ static inline qdf_nbuf_t qdf_nbuf_get_ext_list(qdf_nbuf_t head_buf)
 	return (qdf_nbuf_t)__qdf_nbuf_get_ext_list(head_buf);
 }
 
+/**
+ * qdf_nbuf_try_coalesce() - merge the data of one nbuf into the page
+ *			     fragments of another
+ * @to: Network buf which receives the data
+ * @from: Network buf whose data is moved into @to
+ * @head_stolen: set when the head buffer of @from now belongs to @to
+ * @delta: truesize added to @to
+ *
+ * The merge fails if @to or @from has an ext list, if @to is cloned, if
+ * @to has no free fragment slots left or if the linear data of @from does
+ * not fit the tailroom of @to and @from head is not a page frag, see
+ * qdf_nbuf_is_head_frag(). On success @to len and data_len
+ * include the data of @from and @from must be released with
+ * qdf_nbuf_free_partial().
+ *
+ * Return: true if @from was merged into @to
+ */
+static inline bool
+qdf_nbuf_try_coalesce(qdf_nbuf_t to, qdf_nbuf_t from, bool *head_stolen,
+		      int *delta)
+{
+	return __qdf_nbuf_try_coalesce(to, from, head_stolen, delta);
+}
+
+/**
+ * qdf_nbuf_is_head_frag() - check if the head buffer of nbuf is a page frag
+ * @buf: Network buf
+ *
+ * Only nbufs with a page frag head can have their linear data moved into
+ * the frags of another nbuf by qdf_nbuf_try_coalesce().
+ *
+ * Return: true if the head buffer is a page frag, false if it is kmalloced
+ */
+static inline bool qdf_nbuf_is_head_frag(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_is_head_frag(buf);
+}
+
 /**
  * qdf_nbuf_get_shinfo() - gets the shared info of head buf
  * @head_buf: Network buffer
@@ -5069,6 +5233,18 @@ qdf_nbuf_set_queue_mapping(qdf_nbuf_t buf, uint16_t val)
 	__qdf_nbuf_set_queue_mapping(buf, val);
 }
 
+/**
+ * qdf_nbuf_tx_more_pending() - check if the OS is about to transmit more
+ *	frames on the tx queue of the nbuf
+ * @buf: Network buffer handed to the driver xmit handler
+ *
+ * Return: true if more frames follow and the queue is not stopped
+ */
+static inline bool qdf_nbuf_tx_more_pending(qdf_nbuf_t buf)
+{
+	return __qdf_nbuf_tx_more_pending(buf);
+}
+
 static inline char *
 qdf_nbuf_get_priv_ptr(qdf_nbuf_t buf)
 {
@@ -149,6 +149,26 @@ void qdf_streamfs_subbufs_consumed(qdf_streamfs_chan_t chan,
  */
 void qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 			size_t length);
+
+/**
+ * qdf_streamfs_write_record() - write a header and its payload into the
+ * channel as one record
+ * @chan: relay channel
+ * @hdr: record header
+ * @hdr_len: number of header bytes
+ * @data: record payload
+ * @data_len: number of payload bytes
+ *
+ * Reserves room for the whole record in the current cpu's channel buffer
+ * and copies the header and payload straight into it, so that the record
+ * is neither split nor staged in an intermediate buffer.
+ *
+ * Return: QDF_STATUS_SUCCESS if written, QDF_STATUS_E_NOMEM if the
+ * channel buffer is full
+ */
+QDF_STATUS qdf_streamfs_write_record(qdf_streamfs_chan_t chan,
+				     const void *hdr, size_t hdr_len,
+				     const void *data, size_t data_len);
 #else
 static inline qdf_dentry_t qdf_streamfs_create_dir(
 			const char *name, qdf_dentry_t parent)
@@ -204,5 +224,13 @@ qdf_streamfs_write(qdf_streamfs_chan_t chan, const void *data,
 		   size_t length)
 {
 }
+
+static inline QDF_STATUS
+qdf_streamfs_write_record(qdf_streamfs_chan_t chan,
+			  const void *hdr, size_t hdr_len,
+			  const void *data, size_t data_len)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
 #endif /* WLAN_STREAMFS */
 #endif /* _QDF_STREAMFS_H */
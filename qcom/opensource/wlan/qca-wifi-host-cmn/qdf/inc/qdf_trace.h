@@ -494,9 +494,6 @@ struct qdf_dp_trace_record_s {
 
 /**
  * struct s_qdf_dp_trace_data - Parameters to configure/control DP trace
- * @head: Position of first record
- * @tail: Position of last record
- * @num:  Current index
  * @proto_bitmap: defines which protocol to be traced
  * @no_of_record: defines every nth packet to be traced
  * @num_records_to_dump: defines number of records to be dumped
@@ -508,8 +505,7 @@ struct qdf_dp_trace_record_s {
  * @live_mode_config: configuration as received during initialization
  * @live_mode: current live mode, enabled or disabled, can be throttled based
  *             on throughput
- * @curr_pos:
- * @saved_tail:
+ * @curr_pos: number of records dumped to debugfs so far
  * @force_live_mode: flag to enable live mode all the time for all packets.
  *                  This can be set/unset from userspace and overrides other
  *                  live mode flags.
@@ -546,9 +542,6 @@ struct qdf_dp_trace_record_s {
  *  for bitmap.
  */
 struct s_qdf_dp_trace_data {
-	uint32_t head;
-	uint32_t tail;
-	uint32_t num;
 	uint32_t proto_bitmap;
 	uint8_t no_of_record;
 	uint16_t num_records_to_dump;
@@ -559,7 +552,6 @@ struct s_qdf_dp_trace_data {
 	bool live_mode_config;
 	bool live_mode;
 	uint32_t curr_pos;
-	uint32_t saved_tail;
 	bool force_live_mode;
 	bool dynamic_verbosity_modify;
 	uint8_t print_pkt_cnt;
@@ -972,9 +964,9 @@ void qdf_dp_trace_init(bool live_mode_config, uint8_t thresh,
 void qdf_dp_trace_deinit(void);
 
 /**
- * qdf_dp_trace_spin_lock_init() - initializes the lock variable before use
- * This function will be called from cds_alloc_global_context, we will have lock
- * available to use ASAP
+ * qdf_dp_trace_spin_lock_init() - initializes the per CPU DP trace rings
+ * This function will be called from cds_alloc_global_context, we will have the
+ * rings available to use ASAP
  *
  * Return: None
  */
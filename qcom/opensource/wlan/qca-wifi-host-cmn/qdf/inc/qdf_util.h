@@ -34,6 +34,7 @@
 #endif
 
 typedef __qdf_wait_queue_head_t qdf_wait_queue_head_t;
+typedef __qdf_rcu_head_t qdf_rcu_head_t;
 
 /**
  * qdf_unlikely - Compiler-dependent macro denoting code unlikely to execute
@@ -47,6 +48,13 @@ typedef __qdf_wait_queue_head_t qdf_wait_queue_head_t;
  */
 #define qdf_likely(_expr)       __qdf_likely(_expr)
 
+/**
+ * qdf_cacheline_aligned - align a type or variable to the L1 cache line
+ *
+ * Used for per-CPU data to avoid false sharing between CPUs.
+ */
+#define qdf_cacheline_aligned   __qdf_cacheline_aligned
+
 /**
  * qdf_wmb - write memory barrier.
  */
@@ -311,6 +319,41 @@ typedef __qdf_wait_queue_head_t qdf_wait_queue_head_t;
 #define qdf_container_of(ptr, type, member) \
 	 __qdf_container_of(ptr, type, member)
 
+/**
+ * qdf_rcu_read_lock() - enter an RCU read-side critical section
+ */
+#define qdf_rcu_read_lock() __qdf_rcu_read_lock()
+
+/**
+ * qdf_rcu_read_unlock() - leave an RCU read-side critical section
+ */
+#define qdf_rcu_read_unlock() __qdf_rcu_read_unlock()
+
+/**
+ * qdf_rcu_dereference() - fetch an RCU protected pointer for dereferencing
+ * @_p: the pointer to read
+ */
+#define qdf_rcu_dereference(_p) __qdf_rcu_dereference(_p)
+
+/**
+ * qdf_rcu_assign_pointer() - publish an RCU protected pointer
+ * @_p: the pointer to assign to
+ * @_v: the value to publish
+ */
+#define qdf_rcu_assign_pointer(_p, _v) __qdf_rcu_assign_pointer(_p, _v)
+
+/**
+ * qdf_call_rcu() - invoke a callback after an RCU grace period
+ * @_head: RCU head embedded in the object to be reclaimed
+ * @_func: callback taking the RCU head
+ */
+#define qdf_call_rcu(_head, _func) __qdf_call_rcu(_head, _func)
+
+/**
+ * qdf_rcu_barrier() - wait for all pending qdf_call_rcu() callbacks
+ */
+#define qdf_rcu_barrier() __qdf_rcu_barrier()
+
 /**
  * QDF_IS_PWR2() - test input value is power of 2 integer
  * @value: input integer
@@ -847,6 +890,21 @@ uint64_t qdf_do_div(uint64_t dividend, uint32_t divisor)
 	return __qdf_do_div(dividend, divisor);
 }
 
+/**
+ * qdf_do_div64() - wrapper function for kernel API div64_u64
+ * @dividend: Dividend value
+ * @divisor : 64 bit divisor value
+ *
+ * Unlike qdf_do_div(), the divisor is not truncated to 32 bits.
+ *
+ * Return: Quotient
+ */
+static inline
+uint64_t qdf_do_div64(uint64_t dividend, uint64_t divisor)
+{
+	return __qdf_do_div64(dividend, divisor);
+}
+
 /**
  * qdf_do_div_rem() - wrapper function for kernel macro(do_div)
  *                    to get remainder.
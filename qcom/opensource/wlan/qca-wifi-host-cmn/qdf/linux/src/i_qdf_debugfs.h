@@ -57,5 +57,10 @@ struct dentry *qdf_debugfs_get_root(void);
  */
 umode_t qdf_debugfs_get_filemode(uint16_t mode);
 
+#else
+static inline struct dentry *qdf_debugfs_get_root(void)
+{
+	return NULL;
+}
 #endif /* WLAN_DEBUGFS */
 #endif /* _I_QDF_DEBUGFS_H */
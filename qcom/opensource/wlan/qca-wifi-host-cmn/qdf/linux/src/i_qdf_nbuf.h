@@ -1814,6 +1814,42 @@ __qdf_nbuf_append_ext_list(struct sk_buff *skb_head,
 	skb_head->len += ext_len;
 }
 
+/**
+ * __qdf_nbuf_try_coalesce() - merge the data of one skb into another's frags
+ * @to: skb which receives the data as page fragments
+ * @from: skb whose linear data and frags are moved into @to
+ * @head_stolen: set when the head buffer of @from now belongs to @to
+ * @delta: truesize added to @to
+ *
+ * Return: true if @from was merged into @to
+ */
+static inline bool
+__qdf_nbuf_try_coalesce(struct sk_buff *to, struct sk_buff *from,
+			bool *head_stolen, int *delta)
+{
+	return skb_try_coalesce(to, from, head_stolen, delta);
+}
+
+/**
+ * __qdf_nbuf_free_partial() - free an skb merged by __qdf_nbuf_try_coalesce()
+ * @skb: skb which has been merged
+ * @head_stolen: head buffer of @skb was taken over by the target skb
+ *
+ * Return: none
+ */
+void __qdf_nbuf_free_partial(struct sk_buff *skb, bool head_stolen);
+
+/**
+ * __qdf_nbuf_is_head_frag() - check if the skb head is a page frag
+ * @skb: Pointer to network buffer
+ *
+ * Return: true if the skb head is a page frag
+ */
+static inline bool __qdf_nbuf_is_head_frag(struct sk_buff *skb)
+{
+	return skb->head_frag;
+}
+
 /**
  * __qdf_nbuf_get_shinfo() - return the shared info of the skb
  * @head_buf: Pointer to network buffer
@@ -2742,6 +2778,31 @@ __qdf_nbuf_get_queue_mapping(struct sk_buff *skb)
 	return skb->queue_mapping;
 }
 
+/**
+ * __qdf_nbuf_tx_more_pending() - check if the stack is about to transmit
+ *	more frames on the tx queue of the skb
+ * @skb: sk buff handed to the driver xmit handler
+ *
+ * Return: true if the driver may defer the doorbell for this skb
+ */
+static inline bool __qdf_nbuf_tx_more_pending(struct sk_buff *skb)
+{
+	struct netdev_queue *txq;
+
+	if (!skb->dev)
+		return false;
+
+	txq = netdev_get_tx_queue(skb->dev, skb_get_queue_mapping(skb));
+	if (netif_xmit_stopped(txq))
+		return false;
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 2, 0))
+	return netdev_xmit_more();
+#else
+	return skb->xmit_more;
+#endif
+}
+
 /**
  * __qdf_nbuf_set_queue_mapping() - get the queue mapping set by linux kernel
  *
@@ -3378,6 +3439,133 @@ static inline qdf_ktime_t __qdf_nbuf_net_timedelta(qdf_ktime_t t)
 	return net_timedelta(t);
 }
 
+#if defined(WLAN_DP_RX_PAGE_POOL) && \
+	(LINUX_VERSION_CODE >= KERNEL_VERSION(5, 15, 0))
+typedef struct page_pool *__qdf_page_pool_t;
+
+/**
+ * __qdf_page_pool_create() - Create a pool of DMA mapped rx pages
+ * @osdev: qdf device the pages are mapped for
+ * @pool_size: number of pages kept by the pool for recycling
+ * @max_len: length of the buffer synced for the device on recycle
+ *
+ * Return: page pool handle or NULL on failure
+ */
+__qdf_page_pool_t __qdf_page_pool_create(qdf_device_t osdev,
+					 uint32_t pool_size,
+					 uint32_t max_len);
+
+/**
+ * __qdf_page_pool_destroy() - Destroy a pool of rx pages
+ * @pp: page pool handle
+ *
+ * Pages still held by nbufs are released when these nbufs are freed.
+ *
+ * Return: None
+ */
+void __qdf_page_pool_destroy(__qdf_page_pool_t pp);
+
+/**
+ * __qdf_nbuf_page_pool_alloc() - Build an nbuf on a page of a page pool
+ * @pp: page pool handle
+ * @size: data buffer size
+ * @reserve: headroom to reserve
+ * @func: function name of the call site
+ * @line: line number of the call site
+ *
+ * The page stays DMA mapped for the device of the pool across its reuse
+ * and QDF_NBUF_CB_PADDR() of the nbuf is set to the DMA address of its
+ * data. The page returns to the pool when the nbuf is freed.
+ *
+ * Return: nbuf or NULL on failure
+ */
+struct sk_buff *__qdf_nbuf_page_pool_alloc(__qdf_page_pool_t pp, size_t size,
+					   int reserve, const char *func,
+					   uint32_t line);
+
+/**
+ * __qdf_nbuf_page_pool_owned() - Check if an nbuf is built on a page pool
+ *				  page mapped for a device
+ * @osdev: qdf device
+ * @skb: nbuf
+ *
+ * Return: true if @skb data is on a page pool page mapped for @osdev
+ */
+bool __qdf_nbuf_page_pool_owned(qdf_device_t osdev, struct sk_buff *skb);
+
+/**
+ * __qdf_nbuf_page_pool_map() - Set the DMA address of a page pool nbuf
+ * @osdev: qdf device
+ * @skb: nbuf
+ * @nbytes: number of bytes synced for the device
+ *
+ * The page of a page pool nbuf is mapped by the pool for its whole life,
+ * mapping it again would leak an IOMMU mapping. QDF_NBUF_CB_PADDR() of
+ * @skb is restored from the pool mapping and the data is synced for the
+ * device instead.
+ *
+ * Return: true if @skb is a page pool nbuf and needs no mapping
+ */
+bool __qdf_nbuf_page_pool_map(qdf_device_t osdev, struct sk_buff *skb,
+			      int nbytes);
+
+/**
+ * __qdf_nbuf_page_pool_unmap() - Sync a page pool nbuf for the CPU instead
+ *				  of unmapping it
+ * @osdev: qdf device
+ * @skb: nbuf
+ * @nbytes: number of bytes synced for the CPU
+ *
+ * Pages of a page pool keep their DMA mapping, which is owned by the pool.
+ * The nbuf is only synced when QDF_NBUF_CB_PADDR() of @skb still points into
+ * that mapping, i.e. it was set by __qdf_nbuf_page_pool_alloc() or
+ * __qdf_nbuf_page_pool_map() and not by a streaming map of the caller.
+ *
+ * Return: true if @skb was synced and must not be unmapped
+ */
+bool __qdf_nbuf_page_pool_unmap(qdf_device_t osdev, struct sk_buff *skb,
+				int nbytes);
+#else
+typedef void *__qdf_page_pool_t;
+
+static inline __qdf_page_pool_t
+__qdf_page_pool_create(qdf_device_t osdev, uint32_t pool_size,
+		       uint32_t max_len)
+{
+	return NULL;
+}
+
+static inline void __qdf_page_pool_destroy(__qdf_page_pool_t pp)
+{
+}
+
+static inline struct sk_buff *
+__qdf_nbuf_page_pool_alloc(__qdf_page_pool_t pp, size_t size, int reserve,
+			   const char *func, uint32_t line)
+{
+	return NULL;
+}
+
+static inline bool
+__qdf_nbuf_page_pool_owned(qdf_device_t osdev, struct sk_buff *skb)
+{
+	return false;
+}
+
+static inline bool
+__qdf_nbuf_page_pool_map(qdf_device_t osdev, struct sk_buff *skb, int nbytes)
+{
+	return false;
+}
+
+static inline bool
+__qdf_nbuf_page_pool_unmap(qdf_device_t osdev, struct sk_buff *skb,
+			   int nbytes)
+{
+	return false;
+}
+#endif
+
 #ifdef CONFIG_NBUF_AP_PLATFORM
 #include <i_qdf_nbuf_w.h>
 #else
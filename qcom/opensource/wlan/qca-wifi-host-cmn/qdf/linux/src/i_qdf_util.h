@@ -26,11 +26,13 @@
 #define _I_QDF_UTIL_H
 
 #include <linux/compiler.h>
+#include <linux/cache.h>
 #include <linux/kernel.h>
 #include <linux/types.h>
 #include <linux/mm.h>
 #include <linux/errno.h>
 #include <linux/average.h>
+#include <linux/math64.h>
 
 #include <linux/random.h>
 #include <linux/io.h>
@@ -60,6 +62,7 @@
 #include <linux/rcupdate.h>
 
 typedef wait_queue_head_t __qdf_wait_queue_head_t;
+typedef struct rcu_head __qdf_rcu_head_t;
 
 /* Generic compiler-dependent macros if defined by the OS */
 #define __qdf_wait_queue_interruptible(wait_queue, condition) \
@@ -80,6 +83,8 @@ typedef wait_queue_head_t __qdf_wait_queue_head_t;
 #define __qdf_unlikely(_expr)   unlikely(_expr)
 #define __qdf_likely(_expr)     likely(_expr)
 
+#define __qdf_cacheline_aligned ____cacheline_aligned
+
 #define __qdf_bitmap(name, bits) DECLARE_BITMAP(name, bits)
 
 /**
@@ -238,6 +243,13 @@ static inline bool __qdf_is_macaddr_equal(const struct qdf_mac_addr *mac_addr1,
 
 #define __qdf_container_of(ptr, type, member) container_of(ptr, type, member)
 
+#define __qdf_rcu_read_lock()			rcu_read_lock()
+#define __qdf_rcu_read_unlock()			rcu_read_unlock()
+#define __qdf_rcu_dereference(_p)		rcu_dereference(_p)
+#define __qdf_rcu_assign_pointer(_p, _v)	rcu_assign_pointer(_p, _v)
+#define __qdf_call_rcu(_head, _func)		call_rcu(_head, _func)
+#define __qdf_rcu_barrier()			rcu_barrier()
+
 #define __qdf_ntohs                      ntohs
 #define __qdf_ntohl                      ntohl
 
@@ -448,6 +460,19 @@ uint64_t __qdf_do_div(uint64_t dividend, uint32_t divisor)
 	return dividend;
 }
 
+/**
+ * __qdf_do_div64() - wrapper function for kernel API div64_u64
+ * @dividend: Dividend value
+ * @divisor : 64 bit divisor value
+ *
+ * Return: Quotient
+ */
+static inline
+uint64_t __qdf_do_div64(uint64_t dividend, uint64_t divisor)
+{
+	return div64_u64(dividend, divisor);
+}
+
 /**
  * __qdf_do_div_rem() - wrapper function for kernel macro(do_div)
  *                      to get remainder.
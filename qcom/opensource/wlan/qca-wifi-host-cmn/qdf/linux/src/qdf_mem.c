@@ -784,6 +784,12 @@ qdf_print_major_nbuf_allocs(uint32_t threshold,
 		qdf_nbuf_acquire_track_lock(nbuf_iter, irq_flag);
 		p_node = qdf_nbuf_get_track_tbl(nbuf_iter);
 		while (p_node) {
+			/* skip nodes of freed nbufs waiting for the sweep */
+			if (!p_node->net_buf) {
+				p_node = p_node->p_next;
+				continue;
+			}
+
 			meta.line = p_node->line_num;
 			meta.size = p_node->size;
 			meta.caller = NULL;
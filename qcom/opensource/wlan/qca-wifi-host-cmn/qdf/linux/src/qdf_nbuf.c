@@ -105,6 +105,16 @@
 #define RADIOTAP_CCK_CHANNEL 0x0020
 #define RADIOTAP_OFDM_CHANNEL 0x0040
 
+#if defined(WLAN_DP_RX_PAGE_POOL) && \
+	(LINUX_VERSION_CODE >= KERNEL_VERSION(5, 15, 0))
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 6, 0))
+#include <net/page_pool/helpers.h>
+#else
+#include <net/page_pool.h>
+#endif
+#include <linux/poison.h>
+#endif
+
 #ifdef FEATURE_NBUFF_REPLENISH_TIMER
 #include <qdf_mc_timer.h>
 
@@ -701,6 +711,144 @@ ret_nbuf:
 
 qdf_export_symbol(__qdf_nbuf_alloc_no_recycler);
 
+#if defined(WLAN_DP_RX_PAGE_POOL) && \
+	(LINUX_VERSION_CODE >= KERNEL_VERSION(5, 15, 0))
+#ifdef PP_MAGIC_MASK
+#define QDF_PP_MAGIC_MASK PP_MAGIC_MASK
+#else
+#define QDF_PP_MAGIC_MASK (~0x3UL)
+#endif
+
+__qdf_page_pool_t __qdf_page_pool_create(qdf_device_t osdev,
+					 uint32_t pool_size,
+					 uint32_t max_len)
+{
+	struct page_pool_params pp_params = {0};
+	struct page_pool *pp;
+
+	pp_params.order = 0;
+	pp_params.flags = PP_FLAG_DMA_MAP | PP_FLAG_DMA_SYNC_DEV;
+	pp_params.pool_size = pool_size;
+	pp_params.nid = NUMA_NO_NODE;
+	pp_params.dev = osdev->dev;
+	pp_params.dma_dir = DMA_FROM_DEVICE;
+	pp_params.offset = 0;
+	pp_params.max_len = QDF_MIN(max_len, (uint32_t)PAGE_SIZE);
+
+	pp = page_pool_create(&pp_params);
+	if (IS_ERR(pp)) {
+		qdf_err("page pool create failed %ld", PTR_ERR(pp));
+		return NULL;
+	}
+
+	return pp;
+}
+
+qdf_export_symbol(__qdf_page_pool_create);
+
+void __qdf_page_pool_destroy(__qdf_page_pool_t pp)
+{
+	if (pp)
+		page_pool_destroy(pp);
+}
+
+qdf_export_symbol(__qdf_page_pool_destroy);
+
+struct sk_buff *__qdf_nbuf_page_pool_alloc(__qdf_page_pool_t pp, size_t size,
+					   int reserve, const char *func,
+					   uint32_t line)
+{
+	struct sk_buff *skb;
+	struct page *page;
+
+	if (qdf_unlikely(SKB_DATA_ALIGN(reserve + size) +
+			 SKB_DATA_ALIGN(sizeof(struct skb_shared_info)) >
+			 PAGE_SIZE))
+		return NULL;
+
+	page = page_pool_dev_alloc_pages(pp);
+	if (qdf_unlikely(!page)) {
+		qdf_rl_nofl_err("page pool alloc failed %zuB @ %s:%d",
+				size, func, line);
+		return NULL;
+	}
+
+	skb = build_skb(page_address(page), PAGE_SIZE);
+	if (qdf_unlikely(!skb)) {
+		page_pool_put_full_page(pp, page, false);
+		return NULL;
+	}
+
+	skb_mark_for_recycle(skb);
+	skb_reserve(skb, reserve);
+	QDF_NBUF_CB_PADDR(skb) = page_pool_get_dma_addr(page) + skb_headroom(skb);
+	qdf_nbuf_count_inc(skb);
+
+	return skb;
+}
+
+qdf_export_symbol(__qdf_nbuf_page_pool_alloc);
+
+bool __qdf_nbuf_page_pool_owned(qdf_device_t osdev, struct sk_buff *skb)
+{
+	struct page *page;
+
+	if (!skb->pp_recycle)
+		return false;
+
+	page = virt_to_head_page(skb->head);
+	if ((page->pp_magic & QDF_PP_MAGIC_MASK) != PP_SIGNATURE)
+		return false;
+
+	/* page pools of other devices feeding tx skbs do not qualify */
+	return page->pp->p.dev == osdev->dev;
+}
+
+qdf_export_symbol(__qdf_nbuf_page_pool_owned);
+
+bool __qdf_nbuf_page_pool_map(qdf_device_t osdev, struct sk_buff *skb,
+			      int nbytes)
+{
+	struct page *page;
+
+	if (!__qdf_nbuf_page_pool_owned(osdev, skb))
+		return false;
+
+	page = virt_to_head_page(skb->head);
+	QDF_NBUF_CB_PADDR(skb) = page_pool_get_dma_addr(page) +
+				 (skb->data - (uint8_t *)page_address(page));
+	dma_sync_single_for_device(osdev->dev, QDF_NBUF_CB_PADDR(skb), nbytes,
+				   DMA_FROM_DEVICE);
+
+	return true;
+}
+
+qdf_export_symbol(__qdf_nbuf_page_pool_map);
+
+bool __qdf_nbuf_page_pool_unmap(qdf_device_t osdev, struct sk_buff *skb,
+				int nbytes)
+{
+	struct page *page;
+	qdf_dma_addr_t paddr;
+
+	if (qdf_likely(!skb->pp_recycle) ||
+	    !__qdf_nbuf_page_pool_owned(osdev, skb))
+		return false;
+
+	page = virt_to_head_page(skb->head);
+	paddr = page_pool_get_dma_addr(page) +
+		(skb->data - (uint8_t *)page_address(page));
+	if (qdf_unlikely(QDF_NBUF_CB_PADDR(skb) != paddr))
+		return false;
+
+	dma_sync_single_for_cpu(osdev->dev, paddr, nbytes, DMA_FROM_DEVICE);
+
+	return true;
+}
+
+qdf_export_symbol(__qdf_nbuf_page_pool_unmap);
+#endif
+
 void __qdf_nbuf_free(struct sk_buff *skb)
 {
 	if (pld_nbuf_pre_alloc_free(skb))
@@ -717,6 +865,16 @@ void __qdf_nbuf_free(struct sk_buff *skb)
 
 qdf_export_symbol(__qdf_nbuf_free);
 
+void __qdf_nbuf_free_partial(struct sk_buff *skb, bool head_stolen)
+{
+	qdf_nbuf_frag_count_dec(skb);
+
+	qdf_nbuf_count_dec(skb);
+	kfree_skb_partial(skb, head_stolen);
+}
+
+qdf_export_symbol(__qdf_nbuf_free_partial);
+
 __qdf_nbuf_t __qdf_nbuf_clone(__qdf_nbuf_t skb)
 {
 	qdf_nbuf_t skb_new = NULL;
@@ -1255,6 +1413,39 @@ void qdf_nbuf_unmap_nbytes_single_paddr_debug(qdf_device_t osdev,
 
 qdf_export_symbol(qdf_nbuf_unmap_nbytes_single_paddr_debug);
 
+bool qdf_nbuf_page_pool_map_debug(qdf_device_t osdev, qdf_nbuf_t buf,
+				  int nbytes, const char *func, uint32_t line)
+{
+	if (!__qdf_nbuf_page_pool_map(osdev, buf, nbytes))
+		return false;
+
+	/* the pool owns the mapping, track it like a streaming map */
+	if (QDF_IS_STATUS_SUCCESS(qdf_nbuf_track_map(buf, func, line))) {
+		if (!is_initial_mem_debug_disabled)
+			qdf_nbuf_history_add(buf, func, line, QDF_NBUF_MAP);
+		qdf_net_buf_debug_update_map_node(buf, func, line);
+	}
+
+	return true;
+}
+
+qdf_export_symbol(qdf_nbuf_page_pool_map_debug);
+
+bool qdf_nbuf_page_pool_unmap_debug(qdf_device_t osdev, qdf_nbuf_t buf,
+				    int nbytes, const char *func,
+				    uint32_t line)
+{
+	if (!__qdf_nbuf_page_pool_unmap(osdev, buf, nbytes))
+		return false;
+
+	qdf_nbuf_untrack_map(buf, func, line);
+	qdf_net_buf_debug_update_unmap_node(buf, func, line);
+
+	return true;
+}
+
+qdf_export_symbol(qdf_nbuf_page_pool_unmap_debug);
+
 static void qdf_nbuf_panic_on_free_if_mapped(qdf_nbuf_t nbuf,
 					     const char *func,
 					     uint32_t line)
@@ -1274,6 +1465,12 @@ static inline void qdf_nbuf_map_tracking_init(void)
 {
 }
 
+static inline QDF_STATUS
+qdf_nbuf_track_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
 static inline void qdf_nbuf_map_tracking_deinit(void)
 {
 }
@@ -2839,6 +3036,15 @@ qdf_export_symbol(qdf_nbuf_set_fast_xmit);
 
 #ifdef NBUF_MEMORY_DEBUG
 
+/*
+ * Nbuf tracking nodes are kept in a hash table keyed on the nbuf pointer.
+ * Nodes are pushed on a bucket with a cmpxchg of the bucket head and are
+ * looked up under RCU, so adding, updating and deleting a node do not take
+ * any lock. A deleted node is only marked dead by clearing its net_buf and
+ * stays linked; a deferred sweep unlinks the dead nodes under the bucket
+ * lock and releases them after an RCU grace period. The bucket lock is
+ * only taken by the sweep and by the leak scans walking the table.
+ */
 static spinlock_t g_qdf_net_buf_track_lock[QDF_NET_BUF_TRACK_MAX_SIZE];
 
 static QDF_NBUF_TRACK *gp_qdf_net_buf_track_tbl[QDF_NET_BUF_TRACK_MAX_SIZE];
@@ -2852,17 +3058,54 @@ static uint32_t qdf_net_buf_track_max_free;
 static uint32_t qdf_net_buf_track_max_allocated;
 static uint32_t qdf_net_buf_track_fail_count;
 
+/* FREEQ_POOLSIZE initial and minimum desired freelist poolsize */
+#define FREEQ_POOLSIZE 2048
+/* Nodes moved between a per CPU cache and the global freelist at a time */
+#define QDF_NBUF_TRACK_PCPU_CACHE_BATCH 64
+/* Per CPU cache size above which a batch goes back to the global freelist */
+#define QDF_NBUF_TRACK_PCPU_CACHE_MAX (4 * QDF_NBUF_TRACK_PCPU_CACHE_BATCH)
+/* Dead nodes marked on a CPU before a sweep of the table is scheduled */
+#define QDF_NBUF_TRACK_SWEEP_BATCH 1024
+
+/**
+ * struct qdf_nbuf_track_pcpu_cache - per CPU cache of nbuf tracking nodes
+ * @free_list: free nodes of the CPU
+ * @count: number of nodes in @free_list
+ * @used: nodes allocated minus nodes freed on the CPU
+ * @dead: nodes marked dead on the CPU since the last sweep was scheduled
+ */
+struct qdf_nbuf_track_pcpu_cache {
+	QDF_NBUF_TRACK *free_list;
+	uint32_t count;
+	int32_t used;
+	uint32_t dead;
+} qdf_cacheline_aligned;
+
+static struct qdf_nbuf_track_pcpu_cache
+		qdf_nbuf_track_pcpu_cache[QDF_MAX_AVAILABLE_CPU];
+
+static void qdf_net_buf_track_sweep_work(struct work_struct *work);
+static DECLARE_WORK(qdf_net_buf_track_sweep, qdf_net_buf_track_sweep_work);
+
 /**
  * update_max_used() - update qdf_net_buf_track_max_used tracking variable
  *
  * tracks the max number of network buffers that the wlan driver was tracking
- * at any one time.
+ * at any one time. Called with the freelist lock held, the per CPU used
+ * counts are sampled without synchronization.
  *
  * Return: none
  */
 static inline void update_max_used(void)
 {
+	int32_t used = 0;
 	int sum;
+	int cpu;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++)
+		used += qdf_nbuf_track_pcpu_cache[cpu].used;
+
+	qdf_net_buf_track_used_list_count = QDF_MAX(used, 0);
 
 	if (qdf_net_buf_track_max_used <
 	    qdf_net_buf_track_used_list_count)
@@ -2887,31 +3130,108 @@ static inline void update_max_free(void)
 		qdf_net_buf_track_max_free = qdf_net_buf_track_free_list_count;
 }
 
+/**
+ * qdf_nbuf_track_pcpu_cache_refill() - refill a per CPU cache
+ * @cache: cache of the current CPU
+ *
+ * Moves up to QDF_NBUF_TRACK_PCPU_CACHE_BATCH nodes from the global freelist
+ * to @cache with a single acquisition of the freelist lock. Called with
+ * interrupts disabled.
+ *
+ * Return: none
+ */
+static void
+qdf_nbuf_track_pcpu_cache_refill(struct qdf_nbuf_track_pcpu_cache *cache)
+{
+	QDF_NBUF_TRACK *node;
+	uint32_t count = 0;
+
+	spin_lock(&qdf_net_buf_track_free_list_lock);
+	while (count < QDF_NBUF_TRACK_PCPU_CACHE_BATCH &&
+	       qdf_net_buf_track_free_list) {
+		node = qdf_net_buf_track_free_list;
+		qdf_net_buf_track_free_list = node->p_next;
+		node->p_next = cache->free_list;
+		cache->free_list = node;
+		count++;
+	}
+	qdf_net_buf_track_free_list_count -= count;
+	update_max_used();
+	spin_unlock(&qdf_net_buf_track_free_list_lock);
+
+	cache->count += count;
+}
+
+/**
+ * qdf_nbuf_track_pcpu_cache_flush() - return a batch of a per CPU cache
+ * @cache: cache of the current CPU
+ *
+ * Returns QDF_NBUF_TRACK_PCPU_CACHE_BATCH nodes to the global freelist, or
+ * to the kmem_cache when the freelist is bigger than FREEQ_POOLSIZE and
+ * twice the number of nbufs in use. If the driver is stalling in a
+ * consistent bursty fashion, this keeps 3/4 of the allocations from the
+ * freelist while also allowing the system to recover memory as less
+ * frantic traffic occurs. Called with interrupts disabled.
+ *
+ * Return: none
+ */
+static void
+qdf_nbuf_track_pcpu_cache_flush(struct qdf_nbuf_track_pcpu_cache *cache)
+{
+	QDF_NBUF_TRACK *node;
+	uint32_t count = 0;
+
+	spin_lock(&qdf_net_buf_track_free_list_lock);
+	update_max_used();
+	while (count < QDF_NBUF_TRACK_PCPU_CACHE_BATCH) {
+		node = cache->free_list;
+		cache->free_list = node->p_next;
+		count++;
+
+		if (qdf_net_buf_track_free_list_count > FREEQ_POOLSIZE &&
+		    (qdf_net_buf_track_free_list_count >
+		     qdf_net_buf_track_used_list_count << 1)) {
+			kmem_cache_free(nbuf_tracking_cache, node);
+			continue;
+		}
+
+		node->p_next = qdf_net_buf_track_free_list;
+		qdf_net_buf_track_free_list = node;
+		qdf_net_buf_track_free_list_count++;
+	}
+	update_max_free();
+	spin_unlock(&qdf_net_buf_track_free_list_lock);
+
+	cache->count -= count;
+}
+
 /**
  * qdf_nbuf_track_alloc() - allocate a cookie to track nbufs allocated by wlan
  *
- * This function pulls from a freelist if possible and uses kmem_cache_alloc.
- * This function also ads fexibility to adjust the allocation and freelist
- * scheems.
+ * This function pulls from the cache of the current CPU, refilled in batches
+ * from the global freelist, and falls back to kmem_cache_alloc.
  *
  * Return: a pointer to an unused QDF_NBUF_TRACK structure may not be zeroed.
  */
 static QDF_NBUF_TRACK *qdf_nbuf_track_alloc(void)
 {
+	struct qdf_nbuf_track_pcpu_cache *cache;
 	int flags = GFP_KERNEL;
 	unsigned long irq_flag;
-	QDF_NBUF_TRACK *new_node = NULL;
+	QDF_NBUF_TRACK *new_node;
 
-	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
-	qdf_net_buf_track_used_list_count++;
-	if (qdf_net_buf_track_free_list) {
-		new_node = qdf_net_buf_track_free_list;
-		qdf_net_buf_track_free_list =
-			qdf_net_buf_track_free_list->p_next;
-		qdf_net_buf_track_free_list_count--;
+	local_irq_save(irq_flag);
+	cache = &qdf_nbuf_track_pcpu_cache[smp_processor_id()];
+	cache->used++;
+	if (!cache->free_list)
+		qdf_nbuf_track_pcpu_cache_refill(cache);
+
+	new_node = cache->free_list;
+	if (new_node) {
+		cache->free_list = new_node->p_next;
+		cache->count--;
 	}
-	update_max_used();
-	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
+	local_irq_restore(irq_flag);
 
 	if (new_node)
 		return new_node;
@@ -2922,48 +3242,32 @@ static QDF_NBUF_TRACK *qdf_nbuf_track_alloc(void)
 	return kmem_cache_alloc(nbuf_tracking_cache, flags);
 }
 
-/* FREEQ_POOLSIZE initial and minimum desired freelist poolsize */
-#define FREEQ_POOLSIZE 2048
-
 /**
  * qdf_nbuf_track_free() - free the nbuf tracking cookie.
  * @node: nbuf tracking node
  *
  * Matches calls to qdf_nbuf_track_alloc.
- * Either frees the tracking cookie to kernel or an internal
- * freelist based on the size of the freelist.
+ * Puts the tracking cookie in the cache of the current CPU and hands a
+ * batch back to the global freelist once the cache grows too big.
  *
  * Return: none
  */
 static void qdf_nbuf_track_free(QDF_NBUF_TRACK *node)
 {
+	struct qdf_nbuf_track_pcpu_cache *cache;
 	unsigned long irq_flag;
 
 	if (!node)
 		return;
 
-	/* Try to shrink the freelist if free_list_count > than FREEQ_POOLSIZE
-	 * only shrink the freelist if it is bigger than twice the number of
-	 * nbufs in use. If the driver is stalling in a consistent bursty
-	 * fashion, this will keep 3/4 of thee allocations from the free list
-	 * while also allowing the system to recover memory as less frantic
-	 * traffic occurs.
-	 */
-
-	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
-
-	qdf_net_buf_track_used_list_count--;
-	if (qdf_net_buf_track_free_list_count > FREEQ_POOLSIZE &&
-	   (qdf_net_buf_track_free_list_count >
-	    qdf_net_buf_track_used_list_count << 1)) {
-		kmem_cache_free(nbuf_tracking_cache, node);
-	} else {
-		node->p_next = qdf_net_buf_track_free_list;
-		qdf_net_buf_track_free_list = node;
-		qdf_net_buf_track_free_list_count++;
-	}
-	update_max_free();
-	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
+	local_irq_save(irq_flag);
+	cache = &qdf_nbuf_track_pcpu_cache[smp_processor_id()];
+	cache->used--;
+	node->p_next = cache->free_list;
+	cache->free_list = node;
+	if (++cache->count > QDF_NBUF_TRACK_PCPU_CACHE_MAX)
+		qdf_nbuf_track_pcpu_cache_flush(cache);
+	local_irq_restore(irq_flag);
 }
 
 /**
@@ -2979,21 +3283,28 @@ static void qdf_nbuf_track_prefill(void)
 {
 	int i;
 	QDF_NBUF_TRACK *node, *head;
+	unsigned long irq_flag;
 
-	/* prepopulate the freelist */
+	/* prepopulate the global freelist */
 	head = NULL;
 	for (i = 0; i < FREEQ_POOLSIZE; i++) {
-		node = qdf_nbuf_track_alloc();
+		node = kmem_cache_alloc(nbuf_tracking_cache, GFP_KERNEL);
 		if (!node)
 			continue;
 		node->p_next = head;
 		head = node;
 	}
+
+	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
 	while (head) {
-		node = head->p_next;
-		qdf_nbuf_track_free(head);
-		head = node;
+		node = head;
+		head = head->p_next;
+		node->p_next = qdf_net_buf_track_free_list;
+		qdf_net_buf_track_free_list = node;
+		qdf_net_buf_track_free_list_count++;
 	}
+	update_max_free();
+	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
 
 	/* prefilled buffers should not count as used */
 	qdf_net_buf_track_max_used = 0;
@@ -3013,6 +3324,8 @@ static void qdf_nbuf_track_prefill(void)
 static void qdf_nbuf_track_memory_manager_create(void)
 {
 	spin_lock_init(&qdf_net_buf_track_free_list_lock);
+	qdf_mem_zero(qdf_nbuf_track_pcpu_cache,
+		     sizeof(qdf_nbuf_track_pcpu_cache));
 	nbuf_tracking_cache = kmem_cache_create("qdf_nbuf_tracking_cache",
 						sizeof(QDF_NBUF_TRACK),
 						0, 0, NULL);
@@ -3023,18 +3336,34 @@ static void qdf_nbuf_track_memory_manager_create(void)
 /**
  * qdf_nbuf_track_memory_manager_destroy() - manager for nbuf tracking cookies
  *
- * Empty the freelist and print out usage statistics when it is no longer
- * needed. Also the kmem_cache should be destroyed here so that it can warn if
- * any nbuf tracking cookies were leaked.
+ * Empty the per CPU caches and the freelist and print out usage statistics
+ * when it is no longer needed. Also the kmem_cache should be destroyed here
+ * so that it can warn if any nbuf tracking cookies were leaked.
  *
  * Return: None
  */
 static void qdf_nbuf_track_memory_manager_destroy(void)
 {
+	struct qdf_nbuf_track_pcpu_cache *cache;
 	QDF_NBUF_TRACK *node, *tmp;
 	unsigned long irq_flag;
+	int cpu;
 
 	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
+	update_max_used();
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		cache = &qdf_nbuf_track_pcpu_cache[cpu];
+		while (cache->free_list) {
+			node = cache->free_list;
+			cache->free_list = node->p_next;
+			node->p_next = qdf_net_buf_track_free_list;
+			qdf_net_buf_track_free_list = node;
+			qdf_net_buf_track_free_list_count++;
+		}
+		cache->count = 0;
+	}
+
 	node = qdf_net_buf_track_free_list;
 
 	if (qdf_net_buf_track_max_used > FREEQ_POOLSIZE * 4)
@@ -3088,6 +3417,97 @@ static void qdf_nbuf_track_memory_manager_destroy(void)
 	qdf_net_buf_track_free_list = NULL;
 }
 
+/**
+ * qdf_net_buf_track_free_rcu() - free a dead node after a grace period
+ * @rcu: RCU head of the node
+ *
+ * Return: None
+ */
+static void qdf_net_buf_track_free_rcu(qdf_rcu_head_t *rcu)
+{
+	qdf_nbuf_track_free(container_of(rcu, QDF_NBUF_TRACK, rcu));
+}
+
+/**
+ * qdf_net_buf_track_sweep_bucket() - unlink the dead nodes of a bucket
+ * @i: bucket index
+ *
+ * Writers only ever push nodes on the bucket head, the links past the head
+ * are only modified here under the bucket lock. An unlinked node keeps its
+ * p_next so that lockless walkers still on it carry on, it is released
+ * after an RCU grace period.
+ *
+ * Return: None
+ */
+static void qdf_net_buf_track_sweep_bucket(uint32_t i)
+{
+	QDF_NBUF_TRACK *p_node, *p_prev;
+	unsigned long irq_flag;
+
+	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+
+	/* dead nodes at the head race with writers pushing new nodes */
+	p_node = READ_ONCE(gp_qdf_net_buf_track_tbl[i]);
+	while (p_node && !READ_ONCE(p_node->net_buf)) {
+		if (cmpxchg(&gp_qdf_net_buf_track_tbl[i],
+			    p_node, p_node->p_next) != p_node) {
+			p_node = READ_ONCE(gp_qdf_net_buf_track_tbl[i]);
+			continue;
+		}
+		qdf_call_rcu(&p_node->rcu, qdf_net_buf_track_free_rcu);
+		p_node = p_node->p_next;
+	}
+
+	p_prev = p_node;
+	while (p_prev && p_prev->p_next) {
+		p_node = p_prev->p_next;
+		if (READ_ONCE(p_node->net_buf)) {
+			p_prev = p_node;
+			continue;
+		}
+		qdf_rcu_assign_pointer(p_prev->p_next, p_node->p_next);
+		qdf_call_rcu(&p_node->rcu, qdf_net_buf_track_free_rcu);
+	}
+
+	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+}
+
+/**
+ * qdf_net_buf_track_sweep_work() - release the dead nodes of the table
+ * @work: sweep work
+ *
+ * Return: None
+ */
+static void qdf_net_buf_track_sweep_work(struct work_struct *work)
+{
+	uint32_t i;
+
+	for (i = 0; i < QDF_NET_BUF_TRACK_MAX_SIZE; i++)
+		qdf_net_buf_track_sweep_bucket(i);
+}
+
+/**
+ * qdf_net_buf_track_mark_dead() - account a node marked dead
+ *
+ * Schedules a sweep of the table every QDF_NBUF_TRACK_SWEEP_BATCH nodes
+ * marked dead on a CPU.
+ *
+ * Return: None
+ */
+static void qdf_net_buf_track_mark_dead(void)
+{
+	struct qdf_nbuf_track_pcpu_cache *cache;
+	unsigned long irq_flag;
+
+	local_irq_save(irq_flag);
+	cache = &qdf_nbuf_track_pcpu_cache[smp_processor_id()];
+	if (++cache->dead >= QDF_NBUF_TRACK_SWEEP_BATCH) {
+		cache->dead = 0;
+		schedule_work(&qdf_net_buf_track_sweep);
+	}
+	local_irq_restore(irq_flag);
+}
+
 void qdf_net_buf_debug_init(void)
 {
 	uint32_t i;
@@ -3121,12 +3541,20 @@ void qdf_net_buf_debug_exit(void)
 	if (is_initial_mem_debug_disabled)
 		return;
 
+	cancel_work_sync(&qdf_net_buf_track_sweep);
+	qdf_rcu_barrier();
+
 	for (i = 0; i < QDF_NET_BUF_TRACK_MAX_SIZE; i++) {
 		spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
 		p_node = gp_qdf_net_buf_track_tbl[i];
+		gp_qdf_net_buf_track_tbl[i] = NULL;
 		while (p_node) {
 			p_prev = p_node;
 			p_node = p_node->p_next;
+			if (!p_prev->net_buf) {
+				qdf_nbuf_track_free(p_prev);
+				continue;
+			}
 			count++;
 			qdf_info("SKB buf memory Leak@ Func %s, @Line %d, size %zu, nbuf %pK",
 				 p_prev->func_name, p_prev->line_num,
@@ -3176,6 +3604,9 @@ static uint32_t qdf_net_buf_debug_hash(qdf_nbuf_t net_buf)
  * qdf_net_buf_debug_look_up() - look up network buffer in debug hash table
  * @net_buf: network buffer
  *
+ * Must be called under qdf_rcu_read_lock(). Dead nodes never match since
+ * their net_buf is cleared.
+ *
  * Return: If skb is found in hash table then return pointer to network buffer
  *	else return %NULL
  */
@@ -3185,12 +3616,12 @@ static QDF_NBUF_TRACK *qdf_net_buf_debug_look_up(qdf_nbuf_t net_buf)
 	QDF_NBUF_TRACK *p_node;
 
 	i = qdf_net_buf_debug_hash(net_buf);
-	p_node = gp_qdf_net_buf_track_tbl[i];
+	p_node = qdf_rcu_dereference(gp_qdf_net_buf_track_tbl[i]);
 
 	while (p_node) {
-		if (p_node->net_buf == net_buf)
+		if (READ_ONCE(p_node->net_buf) == net_buf)
 			return p_node;
-		p_node = p_node->p_next;
+		p_node = qdf_rcu_dereference(p_node->p_next);
 	}
 
 	return NULL;
@@ -3200,8 +3631,8 @@ void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 				const char *func_name, uint32_t line_num)
 {
 	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
+	QDF_NBUF_TRACK *p_head;
 	QDF_NBUF_TRACK *new_node;
 
 	if (is_initial_mem_debug_disabled)
@@ -3210,7 +3641,7 @@ void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 	new_node = qdf_nbuf_track_alloc();
 
 	i = qdf_net_buf_debug_hash(net_buf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(net_buf);
 
@@ -3235,8 +3666,12 @@ void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 			p_node->time = qdf_get_log_timestamp();
 			qdf_net_buf_update_smmu_params(p_node);
 			qdf_mem_skb_inc(size);
-			p_node->p_next = gp_qdf_net_buf_track_tbl[i];
-			gp_qdf_net_buf_track_tbl[i] = p_node;
+			/* cmpxchg orders the node init before publishing */
+			do {
+				p_head = READ_ONCE(gp_qdf_net_buf_track_tbl[i]);
+				p_node->p_next = p_head;
+			} while (cmpxchg(&gp_qdf_net_buf_track_tbl[i],
+					 p_head, p_node) != p_head);
 		} else {
 			qdf_net_buf_track_fail_count++;
 			qdf_print(
@@ -3245,22 +3680,19 @@ void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 		}
 	}
 
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 qdf_export_symbol(qdf_net_buf_debug_add_node);
 
 void qdf_net_buf_debug_update_node(qdf_nbuf_t net_buf, const char *func_name,
 				   uint32_t line_num)
 {
-	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(net_buf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(net_buf);
 
@@ -3270,7 +3702,7 @@ void qdf_net_buf_debug_update_node(qdf_nbuf_t net_buf, const char *func_name,
 		p_node->line_num = line_num;
 	}
 
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 
 qdf_export_symbol(qdf_net_buf_debug_update_node);
@@ -3279,15 +3711,12 @@ void qdf_net_buf_debug_update_map_node(qdf_nbuf_t net_buf,
 				       const char *func_name,
 				       uint32_t line_num)
 {
-	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(net_buf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(net_buf);
 
@@ -3297,7 +3726,7 @@ void qdf_net_buf_debug_update_map_node(qdf_nbuf_t net_buf,
 		p_node->map_line_num = line_num;
 		p_node->is_nbuf_mapped = true;
 	}
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 
 #ifdef NBUF_SMMU_MAP_UNMAP_DEBUG
@@ -3307,15 +3736,12 @@ void qdf_net_buf_debug_update_smmu_map_node(qdf_nbuf_t nbuf,
 					    const char *func,
 					    uint32_t line)
 {
-	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(nbuf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(nbuf);
 
@@ -3327,7 +3753,7 @@ void qdf_net_buf_debug_update_smmu_map_node(qdf_nbuf_t nbuf,
 		p_node->smmu_map_iova_addr = iova;
 		p_node->smmu_map_pa_addr = pa;
 	}
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 
 void qdf_net_buf_debug_update_smmu_unmap_node(qdf_nbuf_t nbuf,
@@ -3336,15 +3762,12 @@ void qdf_net_buf_debug_update_smmu_unmap_node(qdf_nbuf_t nbuf,
 					      const char *func,
 					      uint32_t line)
 {
-	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(nbuf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(nbuf);
 
@@ -3356,7 +3779,7 @@ void qdf_net_buf_debug_update_smmu_unmap_node(qdf_nbuf_t nbuf,
 		p_node->smmu_unmap_iova_addr = iova;
 		p_node->smmu_unmap_pa_addr = pa;
 	}
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 #endif
 
@@ -3364,15 +3787,12 @@ void qdf_net_buf_debug_update_unmap_node(qdf_nbuf_t net_buf,
 					 const char *func_name,
 					 uint32_t line_num)
 {
-	uint32_t i;
-	unsigned long irq_flag;
 	QDF_NBUF_TRACK *p_node;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(net_buf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_lock();
 
 	p_node = qdf_net_buf_debug_look_up(net_buf);
 
@@ -3382,52 +3802,32 @@ void qdf_net_buf_debug_update_unmap_node(qdf_nbuf_t net_buf,
 		p_node->unmap_line_num = line_num;
 		p_node->is_nbuf_mapped = false;
 	}
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 }
 
 void qdf_net_buf_debug_delete_node(qdf_nbuf_t net_buf)
 {
-	uint32_t i;
-	QDF_NBUF_TRACK *p_head;
-	QDF_NBUF_TRACK *p_node = NULL;
-	unsigned long irq_flag;
-	QDF_NBUF_TRACK *p_prev;
+	QDF_NBUF_TRACK *p_node;
+	size_t size = 0;
 
 	if (is_initial_mem_debug_disabled)
 		return;
 
-	i = qdf_net_buf_debug_hash(net_buf);
-	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
-
-	p_head = gp_qdf_net_buf_track_tbl[i];
-
-	/* Unallocated SKB */
-	if (!p_head)
-		goto done;
+	qdf_rcu_read_lock();
 
-	p_node = p_head;
-	/* Found at head of the table */
-	if (p_head->net_buf == net_buf) {
-		gp_qdf_net_buf_track_tbl[i] = p_node->p_next;
-		goto done;
-	}
+	p_node = qdf_net_buf_debug_look_up(net_buf);
 
-	/* Search in collision list */
-	while (p_node) {
-		p_prev = p_node;
-		p_node = p_node->p_next;
-		if ((p_node) && (p_node->net_buf == net_buf)) {
-			p_prev->p_next = p_node->p_next;
-			break;
-		}
-	}
+	/* only one of racing double frees gets to mark the node dead */
+	if (p_node && cmpxchg(&p_node->net_buf, net_buf, NULL) == net_buf)
+		size = p_node->size;
+	else
+		p_node = NULL;
 
-done:
-	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+	qdf_rcu_read_unlock();
 
 	if (p_node) {
-		qdf_mem_skb_dec(p_node->size);
-		qdf_nbuf_track_free(p_node);
+		qdf_mem_skb_dec(size);
+		qdf_net_buf_track_mark_dead();
 	} else {
 		if (qdf_net_buf_track_fail_count) {
 			qdf_print("Untracked net_buf free: %pK with tracking failures count: %u",
@@ -3547,6 +3947,31 @@ qdf_nbuf_t qdf_nbuf_frag_alloc_debug(qdf_device_t osdev, qdf_size_t size,
 
 qdf_export_symbol(qdf_nbuf_frag_alloc_debug);
 
+qdf_nbuf_t qdf_nbuf_page_pool_alloc_debug(qdf_page_pool_t pp, qdf_size_t size,
+					  int reserve, const char *func,
+					  uint32_t line)
+{
+	qdf_nbuf_t nbuf;
+
+	nbuf = __qdf_nbuf_page_pool_alloc(pp, size, reserve, func, line);
+	if (is_initial_mem_debug_disabled)
+		return nbuf;
+
+	/* Store SKB in internal QDF tracking table */
+	if (qdf_likely(nbuf)) {
+		qdf_net_buf_debug_add_node(nbuf, size, func, line);
+		qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_ALLOC);
+		/* the page pool mapping is released through the unmap APIs */
+		qdf_nbuf_track_map(nbuf, func, line);
+	} else {
+		qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_ALLOC_FAILURE);
+	}
+
+	return nbuf;
+}
+
+qdf_export_symbol(qdf_nbuf_page_pool_alloc_debug);
+
 qdf_nbuf_t qdf_nbuf_alloc_no_recycler_debug(size_t size, int reserve, int align,
 					    const char *func, uint32_t line)
 {
@@ -3636,6 +4061,29 @@ free_buf:
 }
 qdf_export_symbol(qdf_nbuf_free_debug);
 
+void qdf_nbuf_free_partial_debug(qdf_nbuf_t nbuf, bool head_stolen,
+				 const char *func, uint32_t line)
+{
+	if (is_initial_mem_debug_disabled)
+		goto free_buf;
+
+	if (qdf_nbuf_get_users(nbuf) > 1)
+		goto free_buf;
+
+	/*
+	 * The frags of a merged nbuf now belong to the target nbuf, only
+	 * the nbuf itself is removed from the tracking table.
+	 */
+	qdf_nbuf_panic_on_free_if_smmu_mapped(nbuf, func, line);
+	qdf_nbuf_panic_on_free_if_mapped(nbuf, func, line);
+	qdf_net_buf_debug_delete_node(nbuf);
+	qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_FREE);
+
+free_buf:
+	__qdf_nbuf_free_partial(nbuf, head_stolen);
+}
+qdf_export_symbol(qdf_nbuf_free_partial_debug);
+
 struct sk_buff *__qdf_nbuf_alloc_simple(qdf_device_t osdev, size_t size,
 					const char *func, uint32_t line)
 {
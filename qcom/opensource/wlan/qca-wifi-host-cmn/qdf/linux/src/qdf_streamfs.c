@@ -25,6 +25,7 @@
 #include <qdf_trace.h>
 #include <qdf_streamfs.h>
 #include <qdf_module.h>
+#include <qdf_mem.h>
 
 /**
  * qdf_create_buf_file_handler() - Create streamfs buffer file
@@ -147,3 +148,27 @@ void qdf_streamfs_write(qdf_streamfs_chan_t chan,
 }
 
 qdf_export_symbol(qdf_streamfs_write);
+
+QDF_STATUS qdf_streamfs_write_record(qdf_streamfs_chan_t chan,
+				     const void *hdr, size_t hdr_len,
+				     const void *data, size_t data_len)
+{
+	unsigned long flags;
+	uint8_t *record;
+
+	if (!chan)
+		return QDF_STATUS_E_INVAL;
+
+	/* relay_reserve() works on the current cpu buffer */
+	local_irq_save(flags);
+	record = relay_reserve(chan, hdr_len + data_len);
+	if (record) {
+		qdf_mem_copy(record, hdr, hdr_len);
+		qdf_mem_copy(record + hdr_len, data, data_len);
+	}
+	local_irq_restore(flags);
+
+	return record ? QDF_STATUS_SUCCESS : QDF_STATUS_E_NOMEM;
+}
+
+qdf_export_symbol(qdf_streamfs_write_record);
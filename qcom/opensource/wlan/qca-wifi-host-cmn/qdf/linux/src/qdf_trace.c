@@ -31,6 +31,7 @@
 #include <qdf_util.h>
 #include <qdf_mem.h>
 #include <qdf_list.h>
+#include <qdf_atomic.h>
 
 /* macro to map qdf trace levels into the bitmask */
 #define QDF_TRACE_LEVEL_TO_MODULE_BITMASK(_level) ((1 << (_level)))
@@ -101,7 +102,41 @@ static struct qdf_dp_trace_record_s *g_qdf_dp_trace_tbl;
 static struct qdf_dp_trace_record_s
 			g_qdf_dp_trace_tbl[MAX_QDF_DP_TRACE_RECORDS];
 #endif
-static spinlock_t l_dp_trace_lock;
+
+/*
+ * The DP trace table is split in one ring per CPU, up to
+ * QDF_DP_TRACE_MAX_RINGS rings. A writer reserves a slot in the ring of the
+ * CPU it runs on by incrementing the ring sequence, so tx and rx CPUs add
+ * records without sharing a lock. Readers merge the rings on the record
+ * timestamp.
+ */
+#define QDF_DP_TRACE_MAX_RINGS 8
+
+/**
+ * struct qdf_dp_trace_ring - ring of DP trace records of a CPU
+ * @seq: number of records added to the ring
+ * @saved_seq: @seq at the start of a debugfs dump
+ */
+struct qdf_dp_trace_ring {
+	qdf_atomic_t seq;
+	uint32_t saved_seq;
+} qdf_cacheline_aligned;
+
+/**
+ * struct qdf_dp_trace_cursor - reader position in the DP trace rings
+ * @pos: per ring sequence of the next record to read going forward
+ * @lo: per ring sequence of the oldest valid record
+ * @hi: per ring sequence one past the newest valid record
+ */
+struct qdf_dp_trace_cursor {
+	uint32_t pos[QDF_DP_TRACE_MAX_RINGS];
+	uint32_t lo[QDF_DP_TRACE_MAX_RINGS];
+	uint32_t hi[QDF_DP_TRACE_MAX_RINGS];
+};
+
+static struct qdf_dp_trace_ring g_qdf_dp_trace_ring[QDF_DP_TRACE_MAX_RINGS];
+static uint32_t g_qdf_dp_trace_num_rings;
+static uint32_t g_qdf_dp_trace_ring_size;
 
 /*
  * all the options to configure/control DP trace are
@@ -638,10 +673,8 @@ void qdf_dp_trace_deinit(void)
 {
 	if (!g_qdf_dp_trace_data.enable)
 		return;
-	spin_lock_bh(&l_dp_trace_lock);
 	g_qdf_dp_trace_data.enable = false;
 	g_qdf_dp_trace_data.no_of_record = 0;
-	spin_unlock_bh(&l_dp_trace_lock);
 
 	free_g_qdf_dp_trace_tbl_buffer();
 }
@@ -756,7 +789,7 @@ void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 	if (!g_qdf_dp_trace_data.enable)
 		return;
 
-	spin_lock_bh(&l_dp_trace_lock);
+	/* sampling counters, a lost update from a racing CPU is harmless */
 	if (QDF_TX == dir)
 		count = ++g_qdf_dp_trace_data.tx_count;
 	else if (QDF_RX == dir)
@@ -769,7 +802,6 @@ void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 		else if (QDF_RX == dir)
 			QDF_NBUF_CB_RX_DP_TRACE(nbuf) = 1;
 	}
-	spin_unlock_bh(&l_dp_trace_lock);
 }
 qdf_export_symbol(qdf_dp_trace_set_track);
 
@@ -1205,6 +1237,128 @@ end:
 	rec->size = data_to_copy;
 }
 
+/**
+ * qdf_dp_trace_ring_idx() - table index of a DP trace ring record
+ * @ring: ring id
+ * @seq: sequence of the record in the ring
+ *
+ * Return: index of the record in g_qdf_dp_trace_tbl
+ */
+static inline uint32_t qdf_dp_trace_ring_idx(uint32_t ring, uint32_t seq)
+{
+	return ring * g_qdf_dp_trace_ring_size +
+	       seq % g_qdf_dp_trace_ring_size;
+}
+
+/**
+ * qdf_dp_trace_num_records() - number of valid records in the DP trace rings
+ *
+ * Return: number of records
+ */
+static uint32_t qdf_dp_trace_num_records(void)
+{
+	uint32_t ring, seq, num = 0;
+
+	for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++) {
+		seq = qdf_atomic_read(&g_qdf_dp_trace_ring[ring].seq);
+		num += QDF_MIN(seq, g_qdf_dp_trace_ring_size);
+	}
+
+	return num;
+}
+
+/**
+ * qdf_dp_trace_cursor_init() - snapshot the DP trace rings for a reader
+ * @cur: reader cursor
+ * @saved: use the sequences saved at the start of a debugfs dump instead of
+ *	   the current ones
+ *
+ * The cursor is left past the newest record of each ring. Records which
+ * writers have overwritten since the snapshot are excluded.
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_cursor_init(struct qdf_dp_trace_cursor *cur,
+				     bool saved)
+{
+	struct qdf_dp_trace_ring *dpt_ring;
+	uint32_t ring, seq, depth;
+
+	for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++) {
+		dpt_ring = &g_qdf_dp_trace_ring[ring];
+		seq = qdf_atomic_read(&dpt_ring->seq);
+		cur->hi[ring] = saved ? dpt_ring->saved_seq : seq;
+		depth = g_qdf_dp_trace_ring_size -
+			QDF_MIN(seq - cur->hi[ring], g_qdf_dp_trace_ring_size);
+		depth = QDF_MIN(depth, cur->hi[ring]);
+		cur->lo[ring] = cur->hi[ring] - depth;
+		cur->pos[ring] = cur->hi[ring];
+	}
+}
+
+/**
+ * qdf_dp_trace_cursor_prev() - step a reader back to the next older record
+ * @cur: reader cursor
+ *
+ * Return: ring holding the record at cur->pos[ring] or -1 if there are no
+ *	   older records
+ */
+static int qdf_dp_trace_cursor_prev(struct qdf_dp_trace_cursor *cur)
+{
+	struct qdf_dp_trace_record_s *rec;
+	uint64_t newest = 0;
+	uint32_t ring;
+	int sel = -1;
+
+	for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++) {
+		if (cur->pos[ring] == cur->lo[ring])
+			continue;
+
+		rec = &g_qdf_dp_trace_tbl[qdf_dp_trace_ring_idx(ring,
+							cur->pos[ring] - 1)];
+		if (sel < 0 || rec->time > newest) {
+			newest = rec->time;
+			sel = ring;
+		}
+	}
+
+	if (sel >= 0)
+		cur->pos[sel]--;
+
+	return sel;
+}
+
+/**
+ * qdf_dp_trace_cursor_next() - oldest record ahead of a reader
+ * @cur: reader cursor
+ *
+ * The caller advances cur->pos[ring] once it has read the record.
+ *
+ * Return: ring holding the record at cur->pos[ring] or -1 if there are no
+ *	   newer records
+ */
+static int qdf_dp_trace_cursor_next(struct qdf_dp_trace_cursor *cur)
+{
+	struct qdf_dp_trace_record_s *rec;
+	uint64_t oldest = 0;
+	uint32_t ring;
+	int sel = -1;
+
+	for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++) {
+		if (cur->pos[ring] == cur->hi[ring])
+			continue;
+
+		rec = &g_qdf_dp_trace_tbl[qdf_dp_trace_ring_idx(ring,
+							cur->pos[ring])];
+		if (sel < 0 || rec->time < oldest) {
+			oldest = rec->time;
+			sel = ring;
+		}
+	}
+
+	return sel;
+}
+
 /**
  * qdf_dp_add_record() - add dp trace record
  * @code: dptrace code
@@ -1225,7 +1379,7 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 
 {
 	struct qdf_dp_trace_record_s *rec = NULL;
-	int index;
+	uint32_t ring, seq, index;
 	bool print_this_record = false;
 	u8 info = 0;
 
@@ -1236,8 +1390,10 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		return;
 	}
 
-	spin_lock_bh(&l_dp_trace_lock);
-
+	/*
+	 * Live mode accounting is a throttling heuristic, a lost update
+	 * from a racing CPU is harmless.
+	 */
 	if (print || g_qdf_dp_trace_data.force_live_mode) {
 		print_this_record = true;
 	} else if (g_qdf_dp_trace_data.live_mode == 1) {
@@ -1252,32 +1408,11 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		}
 	}
 
-	g_qdf_dp_trace_data.num++;
-
-	if (g_qdf_dp_trace_data.num > MAX_QDF_DP_TRACE_RECORDS)
-		g_qdf_dp_trace_data.num = MAX_QDF_DP_TRACE_RECORDS;
-
-	if (INVALID_QDF_DP_TRACE_ADDR == g_qdf_dp_trace_data.head) {
-		/* first record */
-		g_qdf_dp_trace_data.head = 0;
-		g_qdf_dp_trace_data.tail = 0;
-	} else {
-		/* queue is not empty */
-		g_qdf_dp_trace_data.tail++;
-
-		if (MAX_QDF_DP_TRACE_RECORDS == g_qdf_dp_trace_data.tail)
-			g_qdf_dp_trace_data.tail = 0;
+	ring = qdf_get_cpu() % g_qdf_dp_trace_num_rings;
+	seq = qdf_atomic_inc_return(&g_qdf_dp_trace_ring[ring].seq) - 1;
+	index = qdf_dp_trace_ring_idx(ring, seq);
 
-		if (g_qdf_dp_trace_data.head == g_qdf_dp_trace_data.tail) {
-			/* full */
-			if (MAX_QDF_DP_TRACE_RECORDS ==
-				++g_qdf_dp_trace_data.head)
-				g_qdf_dp_trace_data.head = 0;
-		}
-	}
-
-	rec = &g_qdf_dp_trace_tbl[g_qdf_dp_trace_data.tail];
-	index = g_qdf_dp_trace_data.tail;
+	rec = &g_qdf_dp_trace_tbl[index];
 	rec->code = code;
 	rec->pdev_id = pdev_id;
 	rec->size = 0;
@@ -1286,18 +1421,9 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 	rec->time = qdf_get_log_timestamp();
 	rec->pid = (in_interrupt() ? 0 : current->pid);
 
-	if (rec->code >= QDF_DP_TRACE_MAX) {
-		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
-				"invalid record code %u, max code %u",
-				rec->code, QDF_DP_TRACE_MAX);
-		return;
-	}
-
-	spin_unlock_bh(&l_dp_trace_lock);
-
 	info |= QDF_DP_TRACE_RECORD_INFO_LIVE;
 	if (print_this_record)
-		qdf_dp_trace_cb_table[rec->code] (rec, index,
+		qdf_dp_trace_cb_table[code](rec, index,
 					QDF_TRACE_DEFAULT_PDEV_ID, info);
 }
 
@@ -2645,7 +2771,10 @@ qdf_export_symbol(qdf_dp_trace);
 
 void qdf_dp_trace_spin_lock_init(void)
 {
-	spin_lock_init(&l_dp_trace_lock);
+	g_qdf_dp_trace_num_rings = QDF_MIN(num_possible_cpus(),
+					   QDF_DP_TRACE_MAX_RINGS);
+	g_qdf_dp_trace_ring_size = MAX_QDF_DP_TRACE_RECORDS /
+				   g_qdf_dp_trace_num_rings;
 }
 qdf_export_symbol(qdf_dp_trace_spin_lock_init);
 
@@ -2663,9 +2792,12 @@ qdf_export_symbol(qdf_dp_trace_enable_live_mode);
 
 void qdf_dp_trace_clear_buffer(void)
 {
-	g_qdf_dp_trace_data.head = INVALID_QDF_DP_TRACE_ADDR;
-	g_qdf_dp_trace_data.tail = INVALID_QDF_DP_TRACE_ADDR;
-	g_qdf_dp_trace_data.num = 0;
+	uint32_t ring;
+
+	for (ring = 0; ring < QDF_DP_TRACE_MAX_RINGS; ring++) {
+		qdf_atomic_set(&g_qdf_dp_trace_ring[ring].seq, 0);
+		g_qdf_dp_trace_ring[ring].saved_seq = 0;
+	}
 	g_qdf_dp_trace_data.dump_counter = 0;
 	g_qdf_dp_trace_data.num_records_to_dump = MAX_QDF_DP_TRACE_RECORDS;
 	if (g_qdf_dp_trace_data.enable)
@@ -2878,9 +3010,8 @@ static void qdf_dpt_display_record_debugfs(qdf_debugfs_file_t file,
 uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 				      enum qdf_dpt_debugfs_state state)
 {
-	uint32_t i = 0;
-	uint32_t tail;
-	uint32_t count = g_qdf_dp_trace_data.num;
+	uint32_t ring;
+	uint32_t count;
 
 	if (!g_qdf_dp_trace_data.enable) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
@@ -2888,6 +3019,7 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 		return QDF_STATUS_E_EMPTY;
 	}
 
+	count = qdf_dp_trace_num_records();
 	if (!count) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
 		  "%s: no packets", __func__);
@@ -2932,29 +3064,15 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 		g_qdf_dp_trace_data.eapol_others);
 
 	qdf_debugfs_printf(file,
-		"DPT: Total Records: %d, Head: %d, Tail: %d\n",
-		g_qdf_dp_trace_data.num, g_qdf_dp_trace_data.head,
-		g_qdf_dp_trace_data.tail);
-
-	spin_lock_bh(&l_dp_trace_lock);
-	if (g_qdf_dp_trace_data.head != INVALID_QDF_DP_TRACE_ADDR) {
-		i = g_qdf_dp_trace_data.head;
-		tail = g_qdf_dp_trace_data.tail;
-
-		if (count > g_qdf_dp_trace_data.num)
-			count = g_qdf_dp_trace_data.num;
-
-		if (tail >= (count - 1))
-			i = tail - count + 1;
-		else if (count != MAX_QDF_DP_TRACE_RECORDS)
-			i = MAX_QDF_DP_TRACE_RECORDS - ((count - 1) -
-						     tail);
-		g_qdf_dp_trace_data.curr_pos = 0;
-		g_qdf_dp_trace_data.saved_tail = tail;
-	}
-	spin_unlock_bh(&l_dp_trace_lock);
+		"DPT: Total Records: %u, Rings: %u, Ring Size: %u\n",
+		count, g_qdf_dp_trace_num_rings, g_qdf_dp_trace_ring_size);
 
-	return g_qdf_dp_trace_data.saved_tail;
+	for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++)
+		g_qdf_dp_trace_ring[ring].saved_seq =
+			qdf_atomic_read(&g_qdf_dp_trace_ring[ring].seq);
+	g_qdf_dp_trace_data.curr_pos = 0;
+
+	return g_qdf_dp_trace_data.curr_pos;
 }
 qdf_export_symbol(qdf_dpt_get_curr_pos_debugfs);
 
@@ -2962,7 +3080,10 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 				      uint32_t curr_pos)
 {
 	struct qdf_dp_trace_record_s p_record;
-	uint32_t i = curr_pos;
+	struct qdf_dp_trace_cursor cur;
+	uint32_t dumped = 0;
+	uint32_t i;
+	int ring;
 	uint16_t num_records_to_dump = g_qdf_dp_trace_data.num_records_to_dump;
 
 	if (!g_qdf_dp_trace_data.enable) {
@@ -2971,9 +3092,6 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	if (num_records_to_dump > g_qdf_dp_trace_data.num)
-		num_records_to_dump = g_qdf_dp_trace_data.num;
-
 	/*
 	 * Max dp trace record size should always be less than
 	 * QDF_DP_TRACE_PREPEND_STR_SIZE(100) + BUFFER_SIZE(121).
@@ -2982,9 +3100,13 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 				QDF_DP_TRACE_PREPEND_STR_SIZE + BUFFER_SIZE))
 		return QDF_STATUS_E_FAILURE;
 
-	spin_lock_bh(&l_dp_trace_lock);
-	p_record = g_qdf_dp_trace_tbl[i];
-	spin_unlock_bh(&l_dp_trace_lock);
+	/*
+	 * Records are dumped newest first, @curr_pos is the number of
+	 * records already dumped to the previous pages.
+	 */
+	qdf_dp_trace_cursor_init(&cur, true);
+	while (dumped < curr_pos && qdf_dp_trace_cursor_prev(&cur) >= 0)
+		dumped++;
 
 	for (;; ) {
 		/*
@@ -2993,12 +3115,20 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 		 * then return so that it gets an extra page.
 		 */
 		if ((file->size - file->count) < QDF_DP_TRACE_MAX_RECORD_SIZE) {
-			spin_lock_bh(&l_dp_trace_lock);
-			g_qdf_dp_trace_data.curr_pos = i;
-			spin_unlock_bh(&l_dp_trace_lock);
+			g_qdf_dp_trace_data.curr_pos = dumped;
 			return QDF_STATUS_E_FAILURE;
 		}
 
+		ring = qdf_dp_trace_cursor_prev(&cur);
+		if (ring < 0)
+			break;
+
+		i = qdf_dp_trace_ring_idx(ring, cur.pos[ring]);
+		p_record = g_qdf_dp_trace_tbl[i];
+		dumped++;
+		if (p_record.code > QDF_DP_TRACE_MAX)
+			continue;
+
 		switch (p_record.code) {
 		case QDF_DP_TRACE_TXRX_PACKET_PTR_RECORD:
 		case QDF_DP_TRACE_TXRX_FAST_PACKET_PTR_RECORD:
@@ -3072,14 +3202,6 @@ QDF_STATUS qdf_dpt_dump_stats_debugfs(qdf_debugfs_file_t file,
 
 		if (++g_qdf_dp_trace_data.dump_counter == num_records_to_dump)
 			break;
-
-		spin_lock_bh(&l_dp_trace_lock);
-		if (i == 0)
-			i = MAX_QDF_DP_TRACE_RECORDS;
-
-		i -= 1;
-		p_record = g_qdf_dp_trace_tbl[i];
-		spin_unlock_bh(&l_dp_trace_lock);
 	}
 
 	g_qdf_dp_trace_data.dump_counter = 0;
@@ -3104,7 +3226,9 @@ qdf_export_symbol(qdf_dpt_set_value_debugfs);
 void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 {
 	struct qdf_dp_trace_record_s p_record;
-	int32_t i, tail;
+	struct qdf_dp_trace_cursor cur;
+	uint32_t i, ring;
+	int sel;
 
 	if (!g_qdf_dp_trace_data.enable) {
 		DPTRACE_PRINT("Tracing Disabled");
@@ -3122,47 +3246,32 @@ void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 
 	qdf_dp_trace_dump_stats();
 
-	DPTRACE_PRINT("DPT: Total Records: %d, Head: %d, Tail: %d",
-		      g_qdf_dp_trace_data.num, g_qdf_dp_trace_data.head,
-		      g_qdf_dp_trace_data.tail);
+	DPTRACE_PRINT("DPT: Total Records: %u, Rings: %u, Ring Size: %u",
+		      qdf_dp_trace_num_records(), g_qdf_dp_trace_num_rings,
+		      g_qdf_dp_trace_ring_size);
 
-	/* acquire the lock so that only one thread at a time can read
-	 * the ring buffer
+	/*
+	 * Walk back from the newest record to select the last @count
+	 * records of all rings, then print them oldest first.
 	 */
-	spin_lock_bh(&l_dp_trace_lock);
-
-	if (g_qdf_dp_trace_data.head != INVALID_QDF_DP_TRACE_ADDR) {
-		i = g_qdf_dp_trace_data.head;
-		tail = g_qdf_dp_trace_data.tail;
-
-		if (count) {
-			if (count > g_qdf_dp_trace_data.num)
-				count = g_qdf_dp_trace_data.num;
-			if (tail >= (count - 1))
-				i = tail - count + 1;
-			else if (count != MAX_QDF_DP_TRACE_RECORDS)
-				i = MAX_QDF_DP_TRACE_RECORDS - ((count - 1) -
-							     tail);
-		}
+	qdf_dp_trace_cursor_init(&cur, false);
+	if (count) {
+		while (count-- && qdf_dp_trace_cursor_prev(&cur) >= 0)
+			;
+	} else {
+		for (ring = 0; ring < g_qdf_dp_trace_num_rings; ring++)
+			cur.pos[ring] = cur.lo[ring];
+	}
 
+	while ((sel = qdf_dp_trace_cursor_next(&cur)) >= 0) {
+		i = qdf_dp_trace_ring_idx(sel, cur.pos[sel]++);
 		p_record = g_qdf_dp_trace_tbl[i];
-		spin_unlock_bh(&l_dp_trace_lock);
-		for (;; ) {
-			qdf_dp_trace_cb_table[p_record.code](&p_record,
-							(uint16_t)i, pdev_id, false);
-			if (i == tail)
-				break;
-			i += 1;
-
-			spin_lock_bh(&l_dp_trace_lock);
-			if (MAX_QDF_DP_TRACE_RECORDS == i)
-				i = 0;
+		if (p_record.code > QDF_DP_TRACE_MAX)
+			continue;
 
-			p_record = g_qdf_dp_trace_tbl[i];
-			spin_unlock_bh(&l_dp_trace_lock);
-		}
-	} else {
-		spin_unlock_bh(&l_dp_trace_lock);
+		qdf_dp_trace_cb_table[p_record.code](&p_record,
+						     (uint16_t)i, pdev_id,
+						     false);
 	}
 }
 qdf_export_symbol(qdf_dp_trace_dump_all);
@@ -3186,13 +3295,11 @@ void qdf_dp_trace_throttle_live_mode(bool high_bw_request)
 	if (0 == (bw_interval_counter %
 			g_qdf_dp_trace_data.thresh_time_limit)) {
 
-		spin_lock_bh(&l_dp_trace_lock);
-			if (g_qdf_dp_trace_data.print_pkt_cnt <=
-				g_qdf_dp_trace_data.high_tput_thresh)
-				g_qdf_dp_trace_data.live_mode = 1;
+		if (g_qdf_dp_trace_data.print_pkt_cnt <=
+			g_qdf_dp_trace_data.high_tput_thresh)
+			g_qdf_dp_trace_data.live_mode = 1;
 
 		g_qdf_dp_trace_data.print_pkt_cnt = 0;
-		spin_unlock_bh(&l_dp_trace_lock);
 	}
 }
 qdf_export_symbol(qdf_dp_trace_throttle_live_mode);
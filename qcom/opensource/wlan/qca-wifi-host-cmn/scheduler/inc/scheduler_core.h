@@ -24,6 +24,7 @@
 #include <qdf_timer.h>
 #include <scheduler_api.h>
 #include <qdf_list.h>
+#include <qdf_atomic.h>
 
 #ifndef SCHEDULER_CORE_MAX_MESSAGES
 #define SCHEDULER_CORE_MAX_MESSAGES 4000
@@ -32,6 +33,9 @@
 #define WLAN_SCHED_REDUCTION_LIMIT 32
 #endif
 #define SCHEDULER_NUMBER_OF_MSG_QUEUE 6
+/* enqueue to dispatch latency buckets: <16us, <64us, ... <64ms, >=64ms */
+#define SCHEDULER_LATENCY_HIST_BUCKETS 8
+#define SCHEDULER_LATENCY_HIST_MIN_US 16
 #define SCHEDULER_WRAPPER_MAX_FAIL_COUNT (SCHEDULER_CORE_MAX_MESSAGES * 3)
 #define SCHEDULER_WATCHDOG_TIMEOUT (10 * 1000) /* 10s */
 
@@ -68,13 +72,20 @@
 
 /**
  * struct scheduler_mq_type -  scheduler message queue
- * @mq_lock: message queue lock
- * @mq_list: message queue list
+ * @mq_list: messages posted to the back of the queue, newest first
+ * @mq_front_list: messages posted to the front of the queue, newest first
+ * @mq_out: messages moved off @mq_list by the consumer, oldest first
+ * @mq_depth: number of messages in the queue
  * @qid: queue id
+ *
+ * Any context may post to the queue without locking, there is only one
+ * consumer, the scheduler thread or the flush once the thread has stopped.
  */
 struct scheduler_mq_type {
-	qdf_spinlock_t mq_lock;
-	qdf_list_t mq_list;
+	qdf_llist_head_t mq_list;
+	qdf_llist_head_t mq_front_list;
+	qdf_llist_node_t *mq_out;
+	qdf_atomic_t mq_depth;
 	QDF_MODULE_ID qid;
 };
 
@@ -83,12 +94,14 @@ struct scheduler_mq_type {
  * @sch_msg_q: scheduler message queue
  * @scheduler_msg_qid_to_qidx: message qid to qidx mapping
  * @scheduler_msg_process_fn: array of message queue handler function pointers
+ * @ready_mask: bitmap of qidx with messages pending
  */
 struct scheduler_mq_ctx {
 	struct scheduler_mq_type sch_msg_q[SCHEDULER_NUMBER_OF_MSG_QUEUE];
 	uint8_t scheduler_msg_qid_to_qidx[QDF_MODULE_ID_MAX];
 	QDF_STATUS (*scheduler_msg_process_fn[SCHEDULER_NUMBER_OF_MSG_QUEUE])
 					(struct scheduler_msg *msg);
+	unsigned long ready_mask;
 };
 
 /**
@@ -189,7 +202,7 @@ QDF_STATUS scheduler_destroy_ctx(void);
  * @msg: the message to enqueue
  *
  * This function is used to put message in back of provided message
- * queue
+ * queue. It is lock-less and may be called from any context.
  *
  *  Return: none
  */
@@ -201,7 +214,7 @@ void scheduler_mq_put(struct scheduler_mq_type *msg_q,
  * @msg: the message to enqueue
  *
  * This function is used to put message in front of provided message
- * queue
+ * queue. It is lock-less and may be called from any context.
  *
  *  Return: none
  */
@@ -211,9 +224,10 @@ void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
  * scheduler_mq_get() - to get message from message queue
  * @msg_q: Pointer to the message queue
  *
- * This function is used to get message from given message queue
+ * This function is used to get message from given message queue. Only
+ * the single consumer of the queue may call it.
  *
- *  Return: none
+ *  Return: the message, NULL if the queue is empty
  */
 struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q);
 
@@ -311,6 +311,8 @@ QDF_STATUS scheduler_post_msg_by_priority(uint32_t qid,
 	else
 		scheduler_mq_put(target_mq, queue_msg);
 
+	qdf_atomic_set_bit(qidx, &sched_ctx->queue_ctx.ready_mask);
+
 	qdf_atomic_set_bit(MC_POST_EVENT_MASK, &sched_ctx->sch_event_flag);
 	qdf_wake_up_interruptible(&sched_ctx->sch_wait_queue);
 
@@ -771,7 +773,7 @@ QDF_STATUS scheduler_get_queue_size(QDF_MODULE_ID qid, uint32_t *size)
 
 	target_mq = &(sched_ctx->queue_ctx.sch_msg_q[qidx]);
 
-	*size = qdf_list_size(&target_mq->mq_list);
+	*size = qdf_atomic_read(&target_mq->mq_depth);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -62,16 +62,33 @@ struct sched_history_item {
 
 static struct sched_history_item sched_history[WLAN_SCHED_HISTORY_SIZE];
 static uint32_t sched_history_index;
+/* enqueue to dispatch latency per qidx, updated by the scheduler thread */
+static uint32_t sched_latency_hist[SCHEDULER_NUMBER_OF_MSG_QUEUE]
+				  [SCHEDULER_LATENCY_HIST_BUCKETS];
 
 static void sched_history_queue(struct scheduler_mq_type *queue,
 				struct scheduler_msg *msg)
 {
 	msg->queue_id = queue->qid;
-	msg->queue_depth = qdf_list_size(&queue->mq_list);
+	msg->queue_depth = qdf_atomic_read(&queue->mq_depth);
 	msg->queued_at_us = qdf_get_log_timestamp_usecs();
 }
 
-static void sched_history_start(struct scheduler_msg *msg)
+static void sched_latency_hist_update(int qidx, uint32_t queue_duration_us)
+{
+	uint32_t limit_us = SCHEDULER_LATENCY_HIST_MIN_US;
+	int bucket = 0;
+
+	while (queue_duration_us >= limit_us &&
+	       bucket < SCHEDULER_LATENCY_HIST_BUCKETS - 1) {
+		limit_us <<= 2;
+		bucket++;
+	}
+
+	sched_latency_hist[qidx][bucket]++;
+}
+
+static void sched_history_start(struct scheduler_msg *msg, int qidx)
 {
 	uint64_t started_at_us = qdf_get_log_timestamp_usecs();
 	struct sched_history_item hist = {
@@ -84,6 +101,7 @@ static void sched_history_start(struct scheduler_msg *msg)
 	};
 
 	sched_history[sched_history_index] = hist;
+	sched_latency_hist_update(qidx, hist.queue_duration_us);
 }
 
 static void sched_history_stop(void)
@@ -135,12 +153,25 @@ void sched_history_print(void)
 	sched_nofl_fatal(SCHEDULER_HISTORY_LINE);
 
 	qdf_mem_free(history);
+
+	sched_nofl_fatal("Queue latency(us) |<16|<64|<256|<1k|<4k|<16k|<64k|>=64k|");
+	for (idx = 0; idx < SCHEDULER_NUMBER_OF_MSG_QUEUE; idx++)
+		sched_nofl_fatal("qidx %u|%u|%u|%u|%u|%u|%u|%u|%u|", idx,
+				 sched_latency_hist[idx][0],
+				 sched_latency_hist[idx][1],
+				 sched_latency_hist[idx][2],
+				 sched_latency_hist[idx][3],
+				 sched_latency_hist[idx][4],
+				 sched_latency_hist[idx][5],
+				 sched_latency_hist[idx][6],
+				 sched_latency_hist[idx][7]);
 }
 #else /* WLAN_SCHED_HISTORY_SIZE */
 
 static inline void sched_history_queue(struct scheduler_mq_type *queue,
 				       struct scheduler_msg *msg) { }
-static inline void sched_history_start(struct scheduler_msg *msg) { }
+static inline void sched_history_start(struct scheduler_msg *msg,
+				       int qidx) { }
 static inline void sched_history_stop(void) { }
 void sched_history_print(void) { }
 
@@ -173,8 +204,10 @@ static QDF_STATUS scheduler_mq_init(struct scheduler_mq_type *msg_q)
 {
 	sched_enter();
 
-	qdf_spinlock_create(&msg_q->mq_lock);
-	qdf_list_create(&msg_q->mq_list, SCHEDULER_CORE_MAX_MESSAGES);
+	qdf_init_llist_head(&msg_q->mq_list);
+	qdf_init_llist_head(&msg_q->mq_front_list);
+	msg_q->mq_out = NULL;
+	qdf_atomic_init(&msg_q->mq_depth);
 
 	sched_exit();
 
@@ -185,8 +218,11 @@ static void scheduler_mq_deinit(struct scheduler_mq_type *msg_q)
 {
 	sched_enter();
 
-	qdf_list_destroy(&msg_q->mq_list);
-	qdf_spinlock_destroy(&msg_q->mq_lock);
+	if (qdf_atomic_read(&msg_q->mq_depth)) {
+		sched_err("qid %d deinit with %d messages pending", msg_q->qid,
+			  qdf_atomic_read(&msg_q->mq_depth));
+		QDF_ASSERT(0);
+	}
 
 	sched_exit();
 }
@@ -206,6 +242,7 @@ static QDF_STATUS scheduler_all_queues_init(struct scheduler_ctx *sched_ctx)
 		return QDF_STATUS_E_FAILURE;
 
 	qdf_atomic_set(&__sched_queue_depth, 0);
+	sched_ctx->queue_ctx.ready_mask = 0;
 
 	/* Initialize all message queues */
 	for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
@@ -251,36 +288,76 @@ static QDF_STATUS scheduler_all_queues_deinit(struct scheduler_ctx *sched_ctx)
 void scheduler_mq_put(struct scheduler_mq_type *msg_q,
 		      struct scheduler_msg *msg)
 {
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
-	qdf_list_insert_back(&msg_q->mq_list, &msg->node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+	/* count first so that the consumer never sees a negative depth */
+	qdf_atomic_inc(&msg_q->mq_depth);
+	qdf_llist_add(&msg->node, &msg_q->mq_list);
 }
 
 void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
 			    struct scheduler_msg *msg)
 {
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
-	qdf_list_insert_front(&msg_q->mq_list, &msg->node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+	qdf_atomic_inc(&msg_q->mq_depth);
+	qdf_llist_add(&msg->node, &msg_q->mq_front_list);
 }
 
 struct scheduler_msg *scheduler_mq_get(struct scheduler_mq_type *msg_q)
 {
-	QDF_STATUS status;
-	qdf_list_node_t *node;
+	qdf_llist_node_t *node;
+
+	/* front posts are LIFO among themselves, as with insert at front */
+	node = qdf_llist_del_first(&msg_q->mq_front_list);
+	if (!node) {
+		if (!msg_q->mq_out)
+			msg_q->mq_out = qdf_llist_reverse_order(
+					qdf_llist_del_all(&msg_q->mq_list));
 
-	qdf_spin_lock_irqsave(&msg_q->mq_lock);
-	status = qdf_list_remove_front(&msg_q->mq_list, &node);
-	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
+		node = msg_q->mq_out;
+		if (!node)
+			return NULL;
+
+		msg_q->mq_out = qdf_llist_next(node);
+	}
 
-	if (QDF_IS_STATUS_ERROR(status))
-		return NULL;
+	qdf_atomic_dec(&msg_q->mq_depth);
 
 	return qdf_container_of(node, struct scheduler_msg, node);
 }
 
+/**
+ * scheduler_mq_empty() - check if a message queue is empty
+ * @msg_q: Pointer to the message queue
+ *
+ * Only the consumer of the queue may call it.
+ *
+ * Return: true if the queue is empty
+ */
+static bool scheduler_mq_empty(struct scheduler_mq_type *msg_q)
+{
+	return !msg_q->mq_out && qdf_llist_empty(&msg_q->mq_list) &&
+	       qdf_llist_empty(&msg_q->mq_front_list);
+}
+
+/**
+ * scheduler_next_ready_queue() - highest priority queue with messages
+ * @mq_ctx: scheduler message queue context
+ *
+ * Return: qidx, SCHEDULER_NUMBER_OF_MSG_QUEUE if all queues are empty
+ */
+static int scheduler_next_ready_queue(struct scheduler_mq_ctx *mq_ctx)
+{
+	unsigned long ready = mq_ctx->ready_mask;
+	int qidx;
+
+	for (qidx = 0; qidx < SCHEDULER_NUMBER_OF_MSG_QUEUE; qidx++) {
+		if (ready & (1UL << qidx))
+			break;
+	}
+
+	return qidx;
+}
+
 QDF_STATUS scheduler_queues_deinit(struct scheduler_ctx *sched_ctx)
 {
 	return scheduler_all_queues_deinit(sched_ctx);
@@ -360,9 +437,8 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 		return;
 	}
 
-	/* start with highest priority queue : timer queue at index 0 */
-	i = 0;
-	while (i < SCHEDULER_NUMBER_OF_MSG_QUEUE) {
+	/* jump to the highest priority queue with messages pending */
+	while (true) {
 		/* Check if MC needs to shutdown */
 		if (qdf_atomic_test_bit(MC_SHUTDOWN_EVENT_MASK,
 					&sch_ctx->sch_event_flag)) {
@@ -380,10 +456,18 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			break;
 		}
 
+		i = scheduler_next_ready_queue(&sch_ctx->queue_ctx);
+		if (i >= SCHEDULER_NUMBER_OF_MSG_QUEUE)
+			break;
+
 		msg = scheduler_mq_get(&sch_ctx->queue_ctx.sch_msg_q[i]);
 		if (!msg) {
-			/* check next queue */
-			i++;
+			qdf_atomic_test_and_clear_bit(i,
+					&sch_ctx->queue_ctx.ready_mask);
+			/* a post may have raced with clearing the ready bit */
+			if (!scheduler_mq_empty(&sch_ctx->queue_ctx.sch_msg_q[i]))
+				qdf_atomic_set_bit(i,
+					&sch_ctx->queue_ctx.ready_mask);
 			continue;
 		}
 
@@ -391,7 +475,7 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			sch_ctx->watchdog_msg_type = msg->type;
 			sch_ctx->watchdog_callback = msg->callback;
 
-			sched_history_start(msg);
+			sched_history_start(msg, i);
 			qdf_timer_start(&sch_ctx->watchdog_timer,
 					sch_ctx->timeout);
 			status = sch_ctx->queue_ctx.
@@ -405,9 +489,6 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 
 			scheduler_core_msg_free(msg);
 		}
-
-		/* start again with highest priority queue at index 0 */
-		i = 0;
 	}
 
 	/* Check for any Suspend Indication */
@@ -499,6 +580,7 @@ void scheduler_queues_flush(struct scheduler_ctx *sched_ctx)
 	for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
 		mq = &sched_ctx->queue_ctx.sch_msg_q[i];
 		scheduler_flush_single_queue(mq);
+		qdf_atomic_clear_bit(i, &sched_ctx->queue_ctx.ready_mask);
 	}
 }
 
@@ -265,6 +265,20 @@ static void scm_add_rnr_channel_db(struct wlan_objmgr_psoc *psoc,
 }
 #endif
 
+/**
+ * scm_get_entry_ssid_idx() - get the scan_ssid_tbl bucket of a scan entry
+ * @entry: scan entry
+ *
+ * Return: index in scan_ssid_tbl
+ */
+static uint8_t scm_get_entry_ssid_idx(struct scan_cache_entry *entry)
+{
+	if (!entry->ssid.length || util_scan_entry_is_hidden_ap(entry))
+		return SCAN_SSID_HIDDEN_IDX;
+
+	return scm_get_ssid_hash_idx(&entry->ssid);
+}
+
 /**
  * scm_del_scan_node() - API to remove scan node from the list
  * @list: hash list
@@ -305,6 +319,10 @@ static QDF_STATUS scm_del_scan_node_from_db(struct scan_dbs *scan_db,
 	if (!scan_node)
 		return QDF_STATUS_E_INVAL;
 
+	hash_idx = scm_get_entry_ssid_idx(scan_node->entry);
+	qdf_list_remove_node(&scan_db->scan_ssid_tbl[hash_idx],
+			     &scan_node->ssid_node);
+
 	hash_idx = SCAN_GET_HASH(scan_node->entry->bssid.bytes);
 	scm_del_scan_node(&scan_db->scan_hash_tbl[hash_idx], scan_node);
 	scan_db->num_entries--;
@@ -428,15 +446,37 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
 		qdf_list_insert_before(&scan_db->scan_hash_tbl[hash_idx],
 				       &scan_node->node, &dup_node->node);
 
+	hash_idx = scm_get_entry_ssid_idx(scan_node->entry);
+	qdf_list_insert_back(&scan_db->scan_ssid_tbl[hash_idx],
+			     &scan_node->ssid_node);
+
 	scan_db->num_entries++;
 }
 
 
+/**
+ * scm_list_node_to_scan_node() - get the scan node of a list node
+ * @lnode: list node
+ * @by_ssid: @lnode is the ssid_node of the scan node
+ *
+ * Return: scan node
+ */
+static inline struct scan_cache_node *
+scm_list_node_to_scan_node(qdf_list_node_t *lnode, bool by_ssid)
+{
+	if (by_ssid)
+		return qdf_container_of(lnode, struct scan_cache_node,
+					ssid_node);
+
+	return qdf_container_of(lnode, struct scan_cache_node, node);
+}
+
 /**
  * scm_get_next_valid_node() - API get the next valid scan node from
  * the list
  * @list: hash list
  * @cur_node: current node pointer
+ * @by_ssid: @list is a scan_ssid_tbl bucket
  *
  * API to get next active node from the list. If cur_node is NULL
  * it will return first node of the list.
@@ -446,7 +486,7 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
  */
 static qdf_list_node_t *
 scm_get_next_valid_node(qdf_list_t *list,
-	qdf_list_node_t *cur_node)
+	qdf_list_node_t *cur_node, bool by_ssid)
 {
 	qdf_list_node_t *next_node = NULL;
 	qdf_list_node_t *temp_node = NULL;
@@ -458,8 +498,7 @@ scm_get_next_valid_node(qdf_list_t *list,
 		qdf_list_peek_front(list, &next_node);
 
 	while (next_node) {
-		scan_node = qdf_container_of(next_node,
-			struct scan_cache_node, node);
+		scan_node = scm_list_node_to_scan_node(next_node, by_ssid);
 		if (scan_node->cookie == SCAN_NODE_ACTIVE_COOKIE)
 			return next_node;
 		/*
@@ -475,11 +514,12 @@ scm_get_next_valid_node(qdf_list_t *list,
 }
 
 /**
- * scm_get_next_node() - API get the next scan node from
- * the list
+ * scm_get_next_list_node() - API get the next scan node from
+ * a scan_hash_tbl or scan_ssid_tbl list
  * @scan_db: scan data base
  * @list: hash list
  * @cur_node: current node pointer
+ * @by_ssid: @list is a scan_ssid_tbl bucket
  *
  * API get the next node from the list. If cur_node is NULL
  * it will return first node of the list
@@ -487,25 +527,28 @@ scm_get_next_valid_node(qdf_list_t *list,
  * Return: next scan cache node
  */
 static struct scan_cache_node *
-scm_get_next_node(struct scan_dbs *scan_db,
-	qdf_list_t *list, struct scan_cache_node *cur_node)
+scm_get_next_list_node(struct scan_dbs *scan_db, qdf_list_t *list,
+		       struct scan_cache_node *cur_node, bool by_ssid)
 {
 	struct scan_cache_node *next_node = NULL;
 	qdf_list_node_t *next_list = NULL;
 
 	qdf_spin_lock_bh(&scan_db->scan_db_lock);
 	if (cur_node) {
-		next_list = scm_get_next_valid_node(list, &cur_node->node);
+		next_list = scm_get_next_valid_node(list,
+						    by_ssid ?
+						    &cur_node->ssid_node :
+						    &cur_node->node,
+						    by_ssid);
 		/* Decrement the ref count of the previous node */
 		scm_scan_entry_put_ref(scan_db,
 			cur_node, false);
 	} else {
-		next_list = scm_get_next_valid_node(list, NULL);
+		next_list = scm_get_next_valid_node(list, NULL, by_ssid);
 	}
 	/* Increase the ref count of the obtained node */
 	if (next_list) {
-		next_node = qdf_container_of(next_list,
-			struct scan_cache_node, node);
+		next_node = scm_list_node_to_scan_node(next_list, by_ssid);
 		scm_scan_entry_get_ref(next_node);
 	}
 	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
@@ -513,6 +556,25 @@ scm_get_next_node(struct scan_dbs *scan_db,
 	return next_node;
 }
 
+/**
+ * scm_get_next_node() - API get the next scan node from
+ * the list
+ * @scan_db: scan data base
+ * @list: hash list
+ * @cur_node: current node pointer
+ *
+ * API get the next node from the list. If cur_node is NULL
+ * it will return first node of the list
+ *
+ * Return: next scan cache node
+ */
+static struct scan_cache_node *
+scm_get_next_node(struct scan_dbs *scan_db,
+	qdf_list_t *list, struct scan_cache_node *cur_node)
+{
+	return scm_get_next_list_node(scan_db, list, cur_node, false);
+}
+
 /**
  * scm_check_and_age_out() - check and age out the old entries
  * @scan_db: scan db
@@ -1471,6 +1533,133 @@ scm_scan_apply_filter_get_entry(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * scm_get_results_from_bucket() - get scan results of one hash bucket
+ * @psoc: psoc ptr
+ * @scan_db: scan db
+ * @hash_idx: scan_hash_tbl bucket
+ * @filter: filter to be applied
+ * @scan_list: scan list to which entry is added
+ *
+ * Return: void
+ */
+static void scm_get_results_from_bucket(struct wlan_objmgr_psoc *psoc,
+					struct scan_dbs *scan_db,
+					int hash_idx,
+					struct scan_filter *filter,
+					qdf_list_t *scan_list)
+{
+	struct scan_cache_node *cur_node;
+	struct scan_cache_node *next_node = NULL;
+
+	if (!qdf_list_size(&scan_db->scan_hash_tbl[hash_idx]))
+		return;
+
+	cur_node = scm_get_next_node(scan_db,
+				     &scan_db->scan_hash_tbl[hash_idx], NULL);
+	while (cur_node) {
+		scm_scan_apply_filter_get_entry(psoc,
+			cur_node->entry, filter, scan_list);
+		next_node = scm_get_next_node(scan_db,
+			&scan_db->scan_hash_tbl[hash_idx], cur_node);
+		cur_node = next_node;
+	}
+}
+
+/**
+ * scm_get_results_from_ssid_bucket() - get scan results of one SSID bucket
+ * @psoc: psoc ptr
+ * @scan_db: scan db
+ * @hash_idx: scan_ssid_tbl bucket
+ * @filter: filter to be applied
+ * @scan_list: scan list to which entry is added
+ *
+ * Return: void
+ */
+static void scm_get_results_from_ssid_bucket(struct wlan_objmgr_psoc *psoc,
+					     struct scan_dbs *scan_db,
+					     int hash_idx,
+					     struct scan_filter *filter,
+					     qdf_list_t *scan_list)
+{
+	struct scan_cache_node *cur_node;
+	qdf_list_t *list = &scan_db->scan_ssid_tbl[hash_idx];
+
+	if (!qdf_list_size(list))
+		return;
+
+	cur_node = scm_get_next_list_node(scan_db, list, NULL, true);
+	while (cur_node) {
+		scm_scan_apply_filter_get_entry(psoc,
+			cur_node->entry, filter, scan_list);
+		cur_node = scm_get_next_list_node(scan_db, list, cur_node,
+						  true);
+	}
+}
+
+/**
+ * scm_get_results_by_ssid() - get scan results of the SSIDs of the filter
+ * @psoc: psoc ptr
+ * @scan_db: scan db
+ * @filter: filter to be applied
+ * @scan_list: scan list to which entry is added
+ *
+ * scm_filter_match() only lets through entries whose SSID is in the
+ * filter, or hidden APs, so only those SSID buckets and the hidden AP
+ * bucket are walked.
+ *
+ * Return: void
+ */
+static void scm_get_results_by_ssid(struct wlan_objmgr_psoc *psoc,
+				    struct scan_dbs *scan_db,
+				    struct scan_filter *filter,
+				    qdf_list_t *scan_list)
+{
+	int i, j;
+	uint8_t hash_idx;
+
+	for (i = 0; i < filter->num_of_ssid; i++) {
+		hash_idx = scm_get_ssid_hash_idx(&filter->ssid_list[i]);
+		/* bucket already walked for an earlier SSID of the list */
+		for (j = 0; j < i; j++) {
+			if (scm_get_ssid_hash_idx(&filter->ssid_list[j]) ==
+			    hash_idx)
+				break;
+		}
+		if (j < i)
+			continue;
+
+		scm_get_results_from_ssid_bucket(psoc, scan_db, hash_idx,
+						 filter, scan_list);
+	}
+
+	scm_get_results_from_ssid_bucket(psoc, scan_db, SCAN_SSID_HIDDEN_IDX,
+					 filter, scan_list);
+}
+
+/**
+ * scm_filter_is_bssid_specific() - check if filter matches only the
+ * BSSIDs in its bssid list
+ * @filter: filter to be applied
+ *
+ * Return: true if every entry of the bssid list is a unicast BSSID
+ */
+static bool scm_filter_is_bssid_specific(struct scan_filter *filter)
+{
+	int i;
+
+	if (!filter || !filter->num_of_bssid)
+		return false;
+
+	for (i = 0; i < filter->num_of_bssid; i++) {
+		if (qdf_is_macaddr_zero(&filter->bssid_list[i]) ||
+		    qdf_is_macaddr_broadcast(&filter->bssid_list[i]))
+			return false;
+	}
+
+	return true;
+}
+
 /**
  * scm_get_results() - Iterate and get scan results
  * @psoc: psoc ptr
@@ -1478,29 +1667,46 @@ scm_scan_apply_filter_get_entry(struct wlan_objmgr_psoc *psoc,
  * @filter: filter to be applied
  * @scan_list: scan list to which entry is added
  *
+ * If the filter is restricted to a list of BSSIDs only the hash buckets
+ * of those BSSIDs are walked. Else if it is restricted to a list of SSIDs
+ * only the SSID index buckets of those SSIDs are walked, else the whole
+ * scan db.
+ *
  * Return: void
  */
 static void scm_get_results(struct wlan_objmgr_psoc *psoc,
 	struct scan_dbs *scan_db, struct scan_filter *filter,
 	qdf_list_t *scan_list)
 {
-	int i, count;
-	struct scan_cache_node *cur_node;
-	struct scan_cache_node *next_node = NULL;
+	int i, j;
+	uint8_t hash_idx;
 
-	for (i = 0 ; i < SCAN_HASH_SIZE; i++) {
-		cur_node = scm_get_next_node(scan_db,
-			   &scan_db->scan_hash_tbl[i], NULL);
-		count = qdf_list_size(&scan_db->scan_hash_tbl[i]);
-		if (!count)
-			continue;
-		while (cur_node) {
-			scm_scan_apply_filter_get_entry(psoc,
-				cur_node->entry, filter, scan_list);
-			next_node = scm_get_next_node(scan_db,
-				&scan_db->scan_hash_tbl[i], cur_node);
-			cur_node = next_node;
+	if (!scm_filter_is_bssid_specific(filter)) {
+		if (filter && filter->num_of_ssid) {
+			scm_get_results_by_ssid(psoc, scan_db, filter,
+						scan_list);
+			return;
 		}
+
+		for (i = 0 ; i < SCAN_HASH_SIZE; i++)
+			scm_get_results_from_bucket(psoc, scan_db, i, filter,
+						    scan_list);
+		return;
+	}
+
+	for (i = 0; i < filter->num_of_bssid; i++) {
+		hash_idx = SCAN_GET_HASH(filter->bssid_list[i].bytes);
+		/* bucket already walked for an earlier BSSID of the list */
+		for (j = 0; j < i; j++) {
+			if (SCAN_GET_HASH(filter->bssid_list[j].bytes) ==
+			    hash_idx)
+				break;
+		}
+		if (j < i)
+			continue;
+
+		scm_get_results_from_bucket(psoc, scan_db, hash_idx, filter,
+					    scan_list);
 	}
 }
 
@@ -1898,6 +2104,9 @@ QDF_STATUS scm_db_init(struct wlan_objmgr_psoc *psoc)
 		for (j = 0; j < SCAN_HASH_SIZE; j++)
 			qdf_list_create(&scan_db->scan_hash_tbl[j],
 				MAX_SCAN_CACHE_SIZE);
+		for (j = 0; j <= SCAN_SSID_HASH_SIZE; j++)
+			qdf_list_create(&scan_db->scan_ssid_tbl[j],
+					MAX_SCAN_CACHE_SIZE);
 		scm_reset_scan_chan_info(psoc, i);
 	}
 	return QDF_STATUS_SUCCESS;
@@ -1924,6 +2133,8 @@ QDF_STATUS scm_db_deinit(struct wlan_objmgr_psoc *psoc)
 		scm_flush_scan_entries(psoc, scan_db, NULL, i);
 		for (j = 0; j < SCAN_HASH_SIZE; j++)
 			qdf_list_destroy(&scan_db->scan_hash_tbl[j]);
+		for (j = 0; j <= SCAN_SSID_HASH_SIZE; j++)
+			qdf_list_destroy(&scan_db->scan_ssid_tbl[j]);
 		qdf_spinlock_destroy(&scan_db->scan_db_lock);
 	}
 
@@ -2035,7 +2246,7 @@ QDF_STATUS scm_rnr_db_flush(struct wlan_objmgr_psoc *psoc)
 
 void scm_update_rnr_from_scan_cache(struct wlan_objmgr_pdev *pdev)
 {
-	uint8_t i;
+	int i;
 	struct scan_dbs *scan_db;
 	struct scan_cache_node *cur_node;
 	struct scan_cache_node *next_node = NULL;
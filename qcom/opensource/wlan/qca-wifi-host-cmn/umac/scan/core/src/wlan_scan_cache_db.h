@@ -30,9 +30,14 @@
 #include <wlan_objmgr_vdev_obj.h>
 #include <wlan_scan_public_structs.h>
 
-#define SCAN_HASH_SIZE 64
-#define SCAN_GET_HASH(addr) \
-	(((const uint8_t *)(addr))[QDF_MAC_ADDR_SIZE - 1] % SCAN_HASH_SIZE)
+#define SCAN_HASH_BITS 8
+#define SCAN_HASH_SIZE (1 << SCAN_HASH_BITS)
+#define SCAN_GET_HASH(addr) scm_get_hash_idx((const uint8_t *)(addr))
+
+#define SCAN_SSID_HASH_BITS 6
+#define SCAN_SSID_HASH_SIZE (1 << SCAN_SSID_HASH_BITS)
+/* SSID index bucket of hidden APs, which match a filter with any SSID */
+#define SCAN_SSID_HIDDEN_IDX SCAN_SSID_HASH_SIZE
 
 #define ADJACENT_CHANNEL_RSSI_THRESHOLD -80
 #define ADJACENT_CHANNEL_RSSI_DIFF_THRESHOLD 40
@@ -40,15 +45,57 @@
 /**
  * struct scan_dbs - scan cache data base definition
  * @num_entries: number of scan entries
- * @scan_db_lock: lock for @scan_hash_tbl
+ * @scan_db_lock: lock for @scan_hash_tbl and @scan_ssid_tbl
  * @scan_hash_tbl: link list of bssid hashed scan cache entries for a pdev
+ * @scan_ssid_tbl: the same entries hashed by SSID, hidden APs are kept in
+ *		   the extra SCAN_SSID_HIDDEN_IDX bucket
  */
 struct scan_dbs {
 	uint32_t num_entries;
 	qdf_spinlock_t scan_db_lock;
 	qdf_list_t scan_hash_tbl[SCAN_HASH_SIZE];
+	qdf_list_t scan_ssid_tbl[SCAN_SSID_HASH_SIZE + 1];
 };
 
+/**
+ * scm_get_hash_idx() - get the scan_hash_tbl bucket of a BSSID
+ * @addr: BSSID
+ *
+ * All six bytes go into the hash. APs of the same vendor share the OUI
+ * and the BSSIDs of one multi BSSID AP differ only in the low bits of the
+ * last byte, so no single byte spreads a dense scan cache evenly.
+ *
+ * Return: index in scan_hash_tbl
+ */
+static inline uint8_t scm_get_hash_idx(const uint8_t *addr)
+{
+	uint32_t key;
+
+	key = ((uint32_t)addr[0] << 8 | addr[1]) ^
+	      ((uint32_t)addr[2] << 24 | (uint32_t)addr[3] << 16 |
+	       (uint32_t)addr[4] << 8 | addr[5]);
+
+	return (key * 0x9E3779B1) >> (32 - SCAN_HASH_BITS);
+}
+
+/**
+ * scm_get_ssid_hash_idx() - get the scan_ssid_tbl bucket of an SSID
+ * @ssid: SSID
+ *
+ * Return: index in scan_ssid_tbl
+ */
+static inline uint8_t scm_get_ssid_hash_idx(const struct wlan_ssid *ssid)
+{
+	uint32_t key = 0x811C9DC5;
+	uint8_t i;
+
+	/* FNV-1a */
+	for (i = 0; i < ssid->length && i < WLAN_SSID_MAX_LEN; i++)
+		key = (key ^ ssid->ssid[i]) * 0x01000193;
+
+	return key >> (32 - SCAN_SSID_HASH_BITS);
+}
+
 /**
  * struct scan_bcn_probe_event - beacon/probe info
  * @frm_type: frame type
@@ -334,12 +334,14 @@ struct bss_info {
 /**
  * struct scan_cache_node - Scan cache entry node
  * @node: node pointers
+ * @ssid_node: node pointers in the SSID index of the scan db
  * @ref_cnt: ref count if in use
  * @cookie: cookie to check if entry is logically active
  * @entry: scan entry pointer
  */
 struct scan_cache_node {
 	qdf_list_node_t node;
+	qdf_list_node_t ssid_node;
 	qdf_atomic_t ref_cnt;
 	uint32_t cookie;
 	struct scan_cache_entry *entry;
@@ -26,6 +26,10 @@
 #include <linux/vmalloc.h>
 #include <wlan_logging_sock_svc.h>
 #include <linux/kthread.h>
+#ifdef WLAN_LOGGING_PERCPU_RING
+#include <linux/percpu.h>
+#include <linux/rtc.h>
+#endif
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 14, 0))
 #include <linux/panic_notifier.h>
 #endif
@@ -413,37 +417,28 @@ log_to_console(QDF_TRACE_LEVEL level, const char *timestamp, const char *msg)
 }
 #endif
 
-int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
+/**
+ * wlan_fill_logmsg() - append a time stamped log line to the current node
+ * @tbuf: time stamp of the log
+ * @tlen: length of the time stamp
+ * @msg: log message
+ * @length: length of the log message
+ *
+ * Need to call this with spin_lock acquired and pcur_node valid.
+ *
+ * Return: true if a filled node got queued for the logger thread
+ */
+static bool wlan_fill_logmsg(const char *tbuf, int tlen,
+			     const char *msg, int length)
 {
 	char *ptr;
-	char tbuf[60];
-	int tlen;
 	int total_log_len;
 	unsigned int *pfilled_length;
 	bool wake_up_thread = false;
-	unsigned long flags;
-	uint64_t ts;
-
-	/* Add the current time stamp */
-	ts = qdf_get_log_timestamp();
-	tlen = wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
-
-	/* if logging isn't up yet, just dump to dmesg */
-	if (!gwlan_logging.is_active) {
-		log_to_console(log_level, tbuf, to_be_sent);
-		return 0;
-	}
 
 	/* 1+1 indicate '\n'+'\0' */
 	total_log_len = length + tlen + 1 + 1;
 
-	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
-	/* wlan logging svc resources are not yet initialized */
-	if (!gwlan_logging.pcur_node) {
-		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
-		return -EIO;
-	}
-
 	pfilled_length = &gwlan_logging.pcur_node->filled_length;
 
 	/* Check if we can accommodate more log into current node/buffer */
@@ -473,11 +468,522 @@ int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
 	}
 
 	memcpy(&ptr[*pfilled_length], tbuf, tlen);
-	memcpy(&ptr[*pfilled_length + tlen], to_be_sent, length);
+	memcpy(&ptr[*pfilled_length + tlen], msg, length);
 	*pfilled_length += tlen + length;
 	ptr[*pfilled_length] = '\n';
 	*pfilled_length += 1;
 
+	return wake_up_thread;
+}
+
+#ifdef WLAN_LOGGING_PERCPU_RING
+/* Per cpu ring size, must be a power of 2 */
+#define WLAN_LOG_RING_SIZE 16384
+/* Wake up the logger thread once this much is pending over all cpus */
+#define WLAN_LOG_RINGS_WAKE_THRESH MAX_LOGMSG_LENGTH
+/* Record length marking the unused tail of the ring before a wrap */
+#define WLAN_LOG_REC_PAD 0xFFFF
+#define WLAN_LOG_REC_ALIGN 8
+
+/**
+ * struct wlan_log_rec - binary log record, formatted by the logger thread
+ * @len: length of @msg, WLAN_LOG_REC_PAD for wrap padding
+ * @level: trace level of the log
+ * @rsvd: reserved
+ * @tv_usec: microseconds of the wall clock time of the log
+ * @tv_sec: seconds of the wall clock time of the log
+ * @ts: log timestamp
+ * @proc: context which logged
+ * @msg: log message, not NUL terminated
+ */
+struct wlan_log_rec {
+	uint16_t len;
+	uint8_t level;
+	uint8_t rsvd;
+	uint32_t tv_usec;
+	int64_t tv_sec;
+	uint64_t ts;
+	char proc[8];
+	char msg[];
+};
+
+/**
+ * struct wlan_log_ring - single producer single consumer ring of one cpu
+ * @buf: record storage of WLAN_LOG_RING_SIZE bytes, NULL when not usable
+ * @mem: allocation backing @buf
+ * @head: producer offset, only written by the owning cpu with irqs off
+ * @tail: consumer offset, only written with wlan_log_drain_lock held
+ * @drain_head: @head snapshot the current drain stops at
+ * @drops: records dropped as the ring was full
+ * @drops_seen: @drops already accounted in gwlan_logging.drop_count
+ */
+struct wlan_log_ring {
+	uint8_t *buf;
+	uint8_t *mem;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t drain_head;
+	uint32_t drops;
+	uint32_t drops_seen;
+};
+
+static DEFINE_PER_CPU(struct wlan_log_ring, wlan_log_rings);
+/* Bytes put in all rings and not drained yet, paces the logger thread */
+static atomic_t wlan_log_rings_pending = ATOMIC_INIT(0);
+
+/**
+ * wlan_log_ring_put() - record a log in the ring of the current cpu
+ * @log_level: trace level of the log
+ * @msg: log message
+ * @length: length of the log message
+ * @ts: log timestamp
+ *
+ * Lock free, the caller only pays for a copy of the message. Formatting
+ * and the copy into the netlink buffers happen in the logger thread.
+ *
+ * Return: true if the log is consumed by the ring, including when it is
+ * dropped because the ring is full, false if the rings are not set up
+ */
+static bool wlan_log_ring_put(QDF_TRACE_LEVEL log_level, const char *msg,
+			      int length, uint64_t ts)
+{
+	struct wlan_log_ring *ring;
+	struct wlan_log_rec *rec;
+	struct timespec64 tv;
+	unsigned long flags;
+	uint8_t *buf;
+	uint32_t rec_len, pad, off, used;
+	int pending;
+
+	if (length > MAX_LOGMSG_LENGTH)
+		length = MAX_LOGMSG_LENGTH;
+	rec_len = ALIGN(sizeof(*rec) + length, WLAN_LOG_REC_ALIGN);
+
+	ktime_get_real_ts64(&tv);
+
+	local_irq_save(flags);
+	ring = this_cpu_ptr(&wlan_log_rings);
+	buf = READ_ONCE(ring->buf);
+	if (!buf) {
+		local_irq_restore(flags);
+		return false;
+	}
+
+	/* A record is contiguous, pad up to the end of the buffer if needed */
+	off = ring->head & (WLAN_LOG_RING_SIZE - 1);
+	pad = WLAN_LOG_RING_SIZE - off;
+	if (pad >= rec_len)
+		pad = 0;
+
+	used = ring->head - smp_load_acquire(&ring->tail);
+	if (WLAN_LOG_RING_SIZE - used < pad + rec_len) {
+		ring->drops++;
+		local_irq_restore(flags);
+		return true;
+	}
+
+	if (pad) {
+		rec = (struct wlan_log_rec *)&buf[off];
+		rec->len = WLAN_LOG_REC_PAD;
+		off = 0;
+	}
+
+	rec = (struct wlan_log_rec *)&buf[off];
+	rec->len = length;
+	rec->level = log_level;
+	rec->tv_sec = tv.tv_sec;
+	rec->tv_usec = tv.tv_nsec / 1000;
+	rec->ts = ts;
+	strscpy(rec->proc, current_process_name(), sizeof(rec->proc));
+	memcpy(rec->msg, msg, length);
+
+	smp_store_release(&ring->head, ring->head + pad + rec_len);
+	local_irq_restore(flags);
+
+	/* Only the put crossing the threshold wakes up the thread */
+	pending = atomic_add_return(pad + rec_len, &wlan_log_rings_pending);
+	if (pending >= WLAN_LOG_RINGS_WAKE_THRESH &&
+	    pending - (int)(pad + rec_len) < WLAN_LOG_RINGS_WAKE_THRESH) {
+		qdf_atomic_set_bit(HOST_LOG_DRIVER_MSG,
+				   gwlan_logging.event_flag);
+		wake_up_interruptible(&gwlan_logging.wait_queue);
+	}
+
+	return true;
+}
+
+/**
+ * wlan_log_rec_time_stamp() - format the time stamp of a log record
+ * @tbuf: Pointer to time stamp buffer
+ * @tbuf_sz: Time buffer size
+ * @rec: log record
+ *
+ * Same format as wlan_add_user_log_time_stamp(), with the time taken
+ * when the record was logged.
+ *
+ * Return: number of characters written in target buffer not including
+ *	   trailing '/0'
+ */
+static int wlan_log_rec_time_stamp(char *tbuf, size_t tbuf_sz,
+				   const struct wlan_log_rec *rec)
+{
+	struct rtc_time tm;
+
+	rtc_time64_to_tm((u32)(rec->tv_sec - (sys_tz.tz_minuteswest * 60)),
+			 &tm);
+
+	return scnprintf(tbuf, tbuf_sz,
+			 "[%.6s][0x%llx][%02d:%02d:%02d.%06u]",
+			 rec->proc, (unsigned long long)rec->ts,
+			 tm.tm_hour, tm.tm_min, tm.tm_sec, rec->tv_usec);
+}
+
+/* Size of the batch of formatted logs filled in the log nodes at once */
+#define WLAN_LOG_BATCH_SIZE (2 * MAX_LOGMSG_LENGTH)
+
+/**
+ * struct wlan_log_batch_ent - formatted log in a batch
+ * @tlen: length of the time stamp at the start of @data
+ * @len: length of the log message following the time stamp in @data
+ * @data: time stamp and log message
+ */
+struct wlan_log_batch_ent {
+	uint16_t tlen;
+	uint16_t len;
+	char data[];
+};
+
+/**
+ * struct wlan_log_batch - logs taken out of the rings, not yet in log nodes
+ * @len: bytes used in @buf
+ * @drops: ring drops not yet accounted in gwlan_logging.drop_count
+ * @buf: storage of struct wlan_log_batch_ent entries
+ */
+struct wlan_log_batch {
+	uint32_t len;
+	uint32_t drops;
+	uint8_t buf[WLAN_LOG_BATCH_SIZE];
+};
+
+/* Serializes the consumers of the rings, protects wlan_log_batch */
+static DEFINE_SPINLOCK(wlan_log_drain_lock);
+static struct wlan_log_batch wlan_log_batch;
+
+/**
+ * wlan_log_batch_flush() - fill the logs of the batch in the log nodes
+ * @batch: log batch
+ *
+ * Only this takes gwlan_logging.spin_lock, for the copy of the already
+ * formatted logs.
+ *
+ * Return: None
+ */
+static void wlan_log_batch_flush(struct wlan_log_batch *batch)
+{
+	struct wlan_log_batch_ent *ent;
+	unsigned long flags;
+	uint32_t off = 0;
+
+	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	if (gwlan_logging.pcur_node) {
+		while (off < batch->len) {
+			ent = (struct wlan_log_batch_ent *)&batch->buf[off];
+			wlan_fill_logmsg(ent->data, ent->tlen,
+					 &ent->data[ent->tlen], ent->len);
+			off += ALIGN(sizeof(*ent) + ent->tlen + ent->len,
+				     sizeof(*ent));
+		}
+	}
+	gwlan_logging.drop_count += batch->drops;
+	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+
+	batch->len = 0;
+	batch->drops = 0;
+}
+
+/**
+ * wlan_log_batch_add() - format a log record into the batch
+ * @batch: log batch
+ * @rec: log record
+ *
+ * The batch is flushed first if the record does not fit.
+ *
+ * Return: None
+ */
+static void wlan_log_batch_add(struct wlan_log_batch *batch,
+			       const struct wlan_log_rec *rec)
+{
+	struct wlan_log_batch_ent *ent;
+	char tbuf[60];
+	uint32_t ent_len;
+	int tlen;
+
+	tlen = wlan_log_rec_time_stamp(tbuf, sizeof(tbuf), rec);
+	ent_len = ALIGN(sizeof(*ent) + tlen + rec->len, sizeof(*ent));
+	if (batch->len + ent_len > WLAN_LOG_BATCH_SIZE)
+		wlan_log_batch_flush(batch);
+
+	ent = (struct wlan_log_batch_ent *)&batch->buf[batch->len];
+	ent->tlen = tlen;
+	ent->len = rec->len;
+	memcpy(ent->data, tbuf, tlen);
+	memcpy(&ent->data[tlen], rec->msg, rec->len);
+	batch->len += ent_len;
+}
+
+/* Rings with records left in the current drain, protected by drain lock */
+static struct cpumask wlan_log_drain_mask;
+
+/**
+ * wlan_log_ring_peek() - get the oldest record of a ring in the current
+ *			  drain
+ * @ring: log ring
+ * @consumed: incremented by the wrap padding skipped
+ *
+ * Return: oldest record of @ring, NULL if the drain is done with @ring
+ */
+static struct wlan_log_rec *wlan_log_ring_peek(struct wlan_log_ring *ring,
+					       uint32_t *consumed)
+{
+	struct wlan_log_rec *rec;
+	uint8_t *buf = READ_ONCE(ring->buf);
+	uint32_t off;
+
+	if (!buf)
+		return NULL;
+
+	while (ring->tail != ring->drain_head) {
+		off = ring->tail & (WLAN_LOG_RING_SIZE - 1);
+		rec = (struct wlan_log_rec *)&buf[off];
+		if (rec->len != WLAN_LOG_REC_PAD)
+			return rec;
+
+		*consumed += WLAN_LOG_RING_SIZE - off;
+		smp_store_release(&ring->tail,
+				  ring->tail + WLAN_LOG_RING_SIZE - off);
+	}
+
+	return NULL;
+}
+
+/**
+ * __wlan_log_rings_drain() - move logs of all cpu rings into log nodes
+ *
+ * Need to call this with wlan_log_drain_lock acquired, which makes it the
+ * only consumer of the rings. The rings are merged by log timestamp, so
+ * the log nodes are in time order and the newest logs are the last ones
+ * filled. The records are formatted into a batch without
+ * gwlan_logging.spin_lock, which is only taken to fill the log nodes from
+ * the batch.
+ *
+ * Return: None
+ */
+static void __wlan_log_rings_drain(void)
+{
+	struct wlan_log_batch *batch = &wlan_log_batch;
+	struct cpumask *mask = &wlan_log_drain_mask;
+	struct wlan_log_ring *ring, *oldest_ring;
+	struct wlan_log_rec *rec, *oldest;
+	uint32_t drops, rec_len, consumed = 0;
+	int cpu;
+
+	cpumask_clear(mask);
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		if (!READ_ONCE(ring->buf))
+			continue;
+
+		/* Logs put after this are left for the next drain */
+		ring->drain_head = smp_load_acquire(&ring->head);
+		if (ring->tail != ring->drain_head)
+			cpumask_set_cpu(cpu, mask);
+
+		drops = READ_ONCE(ring->drops);
+		batch->drops += drops - ring->drops_seen;
+		ring->drops_seen = drops;
+	}
+
+	while (!cpumask_empty(mask)) {
+		oldest = NULL;
+		oldest_ring = NULL;
+		for_each_cpu(cpu, mask) {
+			ring = per_cpu_ptr(&wlan_log_rings, cpu);
+			rec = wlan_log_ring_peek(ring, &consumed);
+			if (!rec) {
+				cpumask_clear_cpu(cpu, mask);
+				continue;
+			}
+
+			if (!oldest || rec->ts < oldest->ts) {
+				oldest = rec;
+				oldest_ring = ring;
+			}
+		}
+
+		if (!oldest)
+			break;
+
+		wlan_log_batch_add(batch, oldest);
+		rec_len = ALIGN(sizeof(*oldest) + oldest->len,
+				WLAN_LOG_REC_ALIGN);
+		consumed += rec_len;
+		smp_store_release(&oldest_ring->tail,
+				  oldest_ring->tail + rec_len);
+	}
+
+	atomic_sub(consumed, &wlan_log_rings_pending);
+
+	if (batch->len || batch->drops)
+		wlan_log_batch_flush(batch);
+}
+
+/**
+ * wlan_log_rings_drain() - move logs of all cpu rings into log nodes
+ *
+ * Must be called without gwlan_logging.spin_lock held.
+ *
+ * Return: None
+ */
+static void wlan_log_rings_drain(void)
+{
+	unsigned long flags;
+
+	spin_lock_irqsave(&wlan_log_drain_lock, flags);
+	__wlan_log_rings_drain();
+	spin_unlock_irqrestore(&wlan_log_drain_lock, flags);
+}
+
+/**
+ * wlan_log_rings_try_drain() - move logs of all cpu rings into log nodes,
+ *				unless another context is draining them
+ *
+ * For the panic path, where the owner of wlan_log_drain_lock may never
+ * release it. Must be called without gwlan_logging.spin_lock held.
+ *
+ * Return: None
+ */
+static void wlan_log_rings_try_drain(void)
+{
+	unsigned long flags;
+
+	if (!spin_trylock_irqsave(&wlan_log_drain_lock, flags))
+		return;
+
+	__wlan_log_rings_drain();
+	spin_unlock_irqrestore(&wlan_log_drain_lock, flags);
+}
+
+/**
+ * wlan_log_rings_init() - allocate the per cpu log rings
+ *
+ * Logs go through the spin lock protected path if this fails.
+ *
+ * Return: None
+ */
+static void wlan_log_rings_init(void)
+{
+	struct wlan_log_ring *ring;
+	int cpu;
+
+	atomic_set(&wlan_log_rings_pending, 0);
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		ring->head = 0;
+		ring->tail = 0;
+		ring->drain_head = 0;
+		ring->drops = 0;
+		ring->drops_seen = 0;
+		ring->mem = qdf_mem_valloc(WLAN_LOG_RING_SIZE);
+		if (!ring->mem)
+			qdf_err("log ring alloc failed for cpu %d", cpu);
+		WRITE_ONCE(ring->buf, ring->mem);
+	}
+}
+
+/**
+ * wlan_log_rings_deinit() - free the per cpu log rings
+ *
+ * Return: None
+ */
+static void wlan_log_rings_deinit(void)
+{
+	struct wlan_log_ring *ring;
+	int cpu;
+
+	for_each_possible_cpu(cpu)
+		WRITE_ONCE(per_cpu_ptr(&wlan_log_rings, cpu)->buf, NULL);
+
+	/* Users of the rings run with irqs disabled, wait for them */
+	synchronize_rcu();
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&wlan_log_rings, cpu);
+		qdf_mem_vfree(ring->mem);
+		ring->mem = NULL;
+	}
+}
+#else
+static inline bool wlan_log_ring_put(QDF_TRACE_LEVEL log_level,
+				     const char *msg, int length, uint64_t ts)
+{
+	return false;
+}
+
+static inline void wlan_log_rings_drain(void)
+{
+}
+
+static inline void wlan_log_rings_try_drain(void)
+{
+}
+
+static inline void wlan_log_rings_init(void)
+{
+}
+
+static inline void wlan_log_rings_deinit(void)
+{
+}
+#endif /* WLAN_LOGGING_PERCPU_RING */
+
+int wlan_log_to_user(QDF_TRACE_LEVEL log_level, char *to_be_sent, int length)
+{
+	char tbuf[60];
+	int tlen;
+	bool wake_up_thread;
+	unsigned long flags;
+	uint64_t ts;
+
+	ts = qdf_get_log_timestamp();
+
+	/* Time stamp formatting is left to the logger thread */
+	if (gwlan_logging.is_active &&
+	    wlan_log_ring_put(log_level, to_be_sent, length, ts)) {
+		if (gwlan_logging.console_log_levels & BIT(log_level)) {
+			wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
+			log_to_console(log_level, tbuf, to_be_sent);
+		}
+		return 0;
+	}
+
+	/* Add the current time stamp */
+	tlen = wlan_add_user_log_time_stamp(tbuf, sizeof(tbuf), ts);
+
+	/* if logging isn't up yet, just dump to dmesg */
+	if (!gwlan_logging.is_active) {
+		log_to_console(log_level, tbuf, to_be_sent);
+		return 0;
+	}
+
+	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
+	/* wlan logging svc resources are not yet initialized */
+	if (!gwlan_logging.pcur_node) {
+		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
+		return -EIO;
+	}
+
+	wake_up_thread = wlan_fill_logmsg(tbuf, tlen, to_be_sent, length);
+
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
 
 	/* Wakeup logger thread */
@@ -920,6 +1426,7 @@ static int wlan_logging_thread(void *Arg)
 
 		if (qdf_atomic_test_and_clear_bit(HOST_LOG_DRIVER_MSG,
 						  gwlan_logging.event_flag)) {
+			wlan_log_rings_drain();
 			ret = send_filled_buffers_to_user();
 			if (-ENOMEM == ret)
 				msleep(200);
@@ -982,6 +1489,7 @@ static int wlan_logging_thread(void *Arg)
 			} else {
 				gwlan_logging.is_flush_complete = true;
 				/* Flush all current host logs*/
+				wlan_log_rings_drain();
 				spin_lock_irqsave(&gwlan_logging.spin_lock,
 					flags);
 				wlan_queue_logmsg_for_app();
@@ -1115,6 +1623,7 @@ static int wlan_logging_panic_handler(struct notifier_block *this,
 	struct log_msg *plog_msg;
 	unsigned long flags;
 
+	wlan_log_rings_try_drain();
 	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
 	/* Iterate over nodes queued for app */
 	while (!list_empty(&gwlan_logging.filled_list)) {
@@ -1232,6 +1741,7 @@ int wlan_logging_sock_init_svc(void)
 	list_del_init(gwlan_logging.free_list.next);
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
 
+	wlan_log_rings_init();
 	flush_timer_init();
 
 	/* Initialize the pktStats data structure here */
@@ -1317,6 +1827,7 @@ err2:
 	gpkt_stats_buffers = NULL;
 err1:
 	flush_timer_deinit();
+	wlan_log_rings_deinit();
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
@@ -1372,6 +1883,7 @@ int wlan_logging_sock_deinit_svc(void)
 
 	/* Delete the Flush timer then mark pcur_node NULL */
 	flush_timer_deinit();
+	wlan_log_rings_deinit();
 
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
@@ -1443,6 +1955,7 @@ void wlan_flush_host_logs_for_fatal(void)
 
 	if (gwlan_logging.flush_timer_period == 0)
 		qdf_info("Flush all host logs Setting HOST_LOG_POST_MAS");
+	wlan_log_rings_drain();
 	spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
 	wlan_queue_logmsg_for_app();
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
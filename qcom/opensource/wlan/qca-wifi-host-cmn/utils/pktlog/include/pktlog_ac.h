@@ -30,6 +30,10 @@
 #include <ol_defines.h>
 #include <pktlog_ac_api.h>
 #include <pktlog_ac_fmt.h>
+#ifdef WLAN_PKTLOG_STREAMFS
+#include <qdf_atomic.h>
+#include <qdf_streamfs.h>
+#endif
 
 #define NO_REG_FUNCS    4
 
@@ -113,8 +117,25 @@ struct pktlog_dev_t {
 	bool vendor_cmd_send;
 	uint8_t callback_type;
 	uint32_t invalid_packets;
+#ifdef WLAN_PKTLOG_STREAMFS
+	qdf_dentry_t streamfs_dir;
+	qdf_streamfs_chan_t streamfs_chan;
+	qdf_atomic_t streamfs_drops;
+#endif
 };
 
+#ifdef WLAN_PKTLOG_STREAMFS
+/*
+ * Records published through streamfs are struct ath_pktlog_hdr followed
+ * by the payload, as in the proc buffer. A sub-buffer must hold the
+ * largest record.
+ */
+#define PKTLOG_STREAMFS_DIR		"pktlog"
+#define PKTLOG_STREAMFS_FILE		"pktlog_dump"
+#define PKTLOG_STREAMFS_SUBBUF_SIZE	32768
+#define PKTLOG_STREAMFS_NUM_SUBBUFS	16
+#endif
+
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 6, 0))
 #define PKTLOG_SYSCTL_SIZE	10
 #else
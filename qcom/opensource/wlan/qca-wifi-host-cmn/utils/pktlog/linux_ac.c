@@ -511,6 +511,82 @@ static int pktlog_sysctl_register(struct hif_opaque_softc *scn)
 }
 #endif
 
+#ifdef WLAN_PKTLOG_STREAMFS
+/**
+ * pktlog_streamfs_attach() - create the streamfs channel pktlog records
+ *			      are published to
+ * @pl_dev: pktlog device
+ *
+ * The channel lives under the debugfs root of the driver. Failure is not
+ * fatal, records then go to the proc buffer.
+ *
+ * Return: None
+ */
+static void pktlog_streamfs_attach(struct pktlog_dev_t *pl_dev)
+{
+	qdf_dentry_t root;
+
+	qdf_atomic_init(&pl_dev->streamfs_drops);
+
+	/* never fall back to a pktlog dir at the top of debugfs */
+	root = qdf_debugfs_get_root();
+	if (!root) {
+		qdf_err("driver debugfs root not available for pktlog");
+		return;
+	}
+
+	pl_dev->streamfs_dir = qdf_streamfs_create_dir(PKTLOG_STREAMFS_DIR,
+						       root);
+	if (!pl_dev->streamfs_dir) {
+		qdf_err("pktlog streamfs dir create failed");
+		return;
+	}
+
+	pl_dev->streamfs_chan = qdf_streamfs_open(PKTLOG_STREAMFS_FILE,
+						  pl_dev->streamfs_dir,
+						  PKTLOG_STREAMFS_SUBBUF_SIZE,
+						  PKTLOG_STREAMFS_NUM_SUBBUFS,
+						  NULL);
+	if (!pl_dev->streamfs_chan) {
+		qdf_err("pktlog streamfs channel create failed");
+		qdf_streamfs_remove_dir_recursive(pl_dev->streamfs_dir);
+		pl_dev->streamfs_dir = NULL;
+	}
+}
+
+/**
+ * pktlog_streamfs_detach() - remove the pktlog streamfs channel
+ * @pl_dev: pktlog device
+ *
+ * Return: None
+ */
+static void pktlog_streamfs_detach(struct pktlog_dev_t *pl_dev)
+{
+	if (pl_dev->streamfs_chan) {
+		qdf_streamfs_flush(pl_dev->streamfs_chan);
+		qdf_streamfs_close(pl_dev->streamfs_chan);
+		pl_dev->streamfs_chan = NULL;
+	}
+
+	if (pl_dev->streamfs_dir) {
+		qdf_streamfs_remove_dir_recursive(pl_dev->streamfs_dir);
+		pl_dev->streamfs_dir = NULL;
+	}
+
+	if (qdf_atomic_read(&pl_dev->streamfs_drops))
+		qdf_info("pktlog streamfs records dropped: %d",
+			 qdf_atomic_read(&pl_dev->streamfs_drops));
+}
+#else
+static inline void pktlog_streamfs_attach(struct pktlog_dev_t *pl_dev)
+{
+}
+
+static inline void pktlog_streamfs_detach(struct pktlog_dev_t *pl_dev)
+{
+}
+#endif /* WLAN_PKTLOG_STREAMFS */
+
 /*
  * Initialize logging for system or adapter
  * Parameter scn should be NULL for system wide logging
@@ -576,6 +652,8 @@ static int pktlog_attach(struct hif_opaque_softc *scn)
 		goto attach_fail2;
 	}
 
+	pktlog_streamfs_attach(pl_dev);
+
 	return 0;
 
 attach_fail2:
@@ -626,6 +704,7 @@ static void pktlog_detach(struct hif_opaque_softc *scn)
 		return;
 	}
 	mutex_lock(&pl_info->pktlog_mutex);
+	pktlog_streamfs_detach(pl_dev);
 	remove_proc_entry(WLANDEV_BASENAME, g_pktlog_pde);
 	pktlog_sysctl_unregister(pl_dev);
 
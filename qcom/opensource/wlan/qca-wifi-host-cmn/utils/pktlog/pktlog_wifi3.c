@@ -18,6 +18,46 @@
 #include "pktlog_wifi3.h"
 
 #ifndef REMOVE_PKT_LOG
+#ifdef WLAN_PKTLOG_STREAMFS
+/**
+ * pktlog_streamfs_publish() - publish a pktlog record to streamfs
+ * @pl_dev: pktlog device
+ * @pl_hdr: record header
+ * @data: record payload of pl_hdr->size bytes
+ *
+ * The record is copied once, straight into the relay sub-buffer that
+ * userspace maps, instead of going through the pktlog proc buffer and
+ * the logger thread.
+ *
+ * Return: true if the record is handled by streamfs, false if it has to
+ * go to the pktlog buffer
+ */
+static bool pktlog_streamfs_publish(struct pktlog_dev_t *pl_dev,
+				    struct ath_pktlog_hdr *pl_hdr,
+				    const void *data)
+{
+	QDF_STATUS status;
+
+	if (!pl_dev->streamfs_chan)
+		return false;
+
+	status = qdf_streamfs_write_record(pl_dev->streamfs_chan,
+					   pl_hdr, sizeof(*pl_hdr),
+					   data, pl_hdr->size);
+	if (QDF_IS_STATUS_ERROR(status))
+		qdf_atomic_inc(&pl_dev->streamfs_drops);
+
+	return true;
+}
+#else
+static inline bool pktlog_streamfs_publish(struct pktlog_dev_t *pl_dev,
+					   struct ath_pktlog_hdr *pl_hdr,
+					   const void *data)
+{
+	return false;
+}
+#endif /* WLAN_PKTLOG_STREAMFS */
+
 A_STATUS
 process_offload_pktlog_wifi3(struct cdp_pdev *pdev, void *data)
 {
@@ -67,6 +107,11 @@ process_offload_pktlog_wifi3(struct cdp_pdev *pdev, void *data)
 	 *  Must include to process different types
 	 *  TX_CTL, TX_STATUS, TX_MSDU_ID, TX_FRM_HDR
 	 */
+	if (pktlog_streamfs_publish(pl_dev, &pl_hdr,
+				    (uint8_t *)data +
+				    sizeof(struct ath_pktlog_hdr)))
+		return A_OK;
+
 	pl_info = pl_dev->pl_info;
 	log_size = pl_hdr.size;
 	txdesc_hdr_ctl =
@@ -107,6 +152,10 @@ int process_rx_desc_remote_wifi3(void *pdev, void *data)
 	pl_hdr.log_type = PKTLOG_TYPE_RX_STATBUF;
 	pl_hdr.size = qdf_nbuf_len(log_nbuf);
 	pl_hdr.timestamp = 0;
+
+	if (pktlog_streamfs_publish(pl_dev, &pl_hdr, qdf_nbuf_data(log_nbuf)))
+		return 0;
+
 	log_size = pl_hdr.size;
 	rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
 						  log_size, &pl_hdr);
@@ -146,6 +195,10 @@ process_pktlog_lite_wifi3(void *context, void *log_data,
 	pl_hdr.log_type = log_type;
 	pl_hdr.size = qdf_nbuf_len(log_nbuf);
 	pl_hdr.timestamp = 0;
+
+	if (pktlog_streamfs_publish(pl_dev, &pl_hdr, qdf_nbuf_data(log_nbuf)))
+		return 0;
+
 	log_size = pl_hdr.size;
 	rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
 						   log_size, &pl_hdr);
@@ -2024,6 +2024,33 @@
 #define CFG_TX_PKT_INSPECT_FOR_ILP_CFG
 #endif
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+/*
+ * <ini>
+ * dp_vdev_stats_aggr_cache_ms - Max age of a shared vdev stats aggregate
+ * @Min: 0
+ * @Max: 10000
+ * @Default: 250
+ *
+ * Vdev stats reads within this many ms of the last walk of the vdev peers
+ * for the same xmit type get the aggregate of that walk, so the stats read
+ * can be this old. Set it above the period of the stats pollers for them
+ * to share the walks. 0 disables the cache.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_VDEV_STATS_AGGR_CACHE_MS \
+	CFG_INI_UINT("dp_vdev_stats_aggr_cache_ms", \
+	0, 10000, 250, \
+	CFG_VALUE_OR_DEFAULT, "vdev stats aggregate cache max age in ms")
+#define CFG_DP_VDEV_STATS_AGGR_CACHE_MS_CFG \
+	CFG(CFG_DP_VDEV_STATS_AGGR_CACHE_MS)
+#else
+#define CFG_DP_VDEV_STATS_AGGR_CACHE_MS_CFG
+#endif
+
 /*
  * <ini>
  * special_frame_msk - frame mask to mark special frame type
@@ -2192,6 +2219,7 @@
 		CFG(CFG_DP_HANDLE_INVALID_DECAP_TYPE_DISABLE) \
 		CFG(CFG_DP_TXMON_SW_PEER_FILTERING) \
 		CFG_TX_PKT_INSPECT_FOR_ILP_CFG \
+		CFG_DP_VDEV_STATS_AGGR_CACHE_MS_CFG \
 		CFG(CFG_DP_POINTER_TIMER_THRESHOLD_RX) \
 		CFG(CFG_DP_POINTER_NUM_THRESHOLD_RX) \
 		CFG_DP_LOCAL_PKT_CAPTURE_CONFIG \
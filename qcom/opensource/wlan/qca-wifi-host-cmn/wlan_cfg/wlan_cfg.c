@@ -3985,6 +3985,30 @@ wlan_soc_tx_packet_inspect_attach(struct cdp_ctrl_objmgr_psoc *psoc,
 }
 #endif
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+/**
+ * wlan_soc_vdev_stats_aggr_cfg_attach() - Update vdev stats aggregate
+ *					   cache config
+ * @psoc: object manager psoc
+ * @wlan_cfg_ctx: dp soc cfg ctx
+ *
+ * Return: None
+ */
+static void
+wlan_soc_vdev_stats_aggr_cfg_attach(struct cdp_ctrl_objmgr_psoc *psoc,
+				    struct wlan_cfg_dp_soc_ctxt *wlan_cfg_ctx)
+{
+	wlan_cfg_ctx->vdev_stats_aggr_cache_ms =
+			cfg_get(psoc, CFG_DP_VDEV_STATS_AGGR_CACHE_MS);
+}
+#else
+static void
+wlan_soc_vdev_stats_aggr_cfg_attach(struct cdp_ctrl_objmgr_psoc *psoc,
+				    struct wlan_cfg_dp_soc_ctxt *wlan_cfg_ctx)
+{
+}
+#endif
+
 #ifdef DP_UMAC_HW_RESET_SUPPORT
 /**
  * wlan_soc_umac_reset_cfg_attach() - Update umac reset buffer window config
@@ -4190,6 +4214,7 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 	wlan_cfg_ctx->txmon_sw_peer_filtering =
 			cfg_get(psoc, CFG_DP_TXMON_SW_PEER_FILTERING);
 	wlan_soc_tx_packet_inspect_attach(psoc, wlan_cfg_ctx);
+	wlan_soc_vdev_stats_aggr_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_soc_local_pkt_capture_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_soc_umac_reset_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_cfg_ctx->rx_buffer_size = cfg_get(psoc, CFG_DP_RX_BUFFER_SIZE);
@@ -4444,6 +4469,7 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 	wlan_cfg_ctx->pointer_num_threshold_rx =
 			cfg_get(psoc, CFG_DP_POINTER_NUM_THRESHOLD_RX);
 	wlan_soc_tx_packet_inspect_attach(psoc, wlan_cfg_ctx);
+	wlan_soc_vdev_stats_aggr_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_soc_local_pkt_capture_cfg_attach(psoc, wlan_cfg_ctx);
 	wlan_cfg_ctx->special_frame_msk =
 			cfg_get(psoc, CFG_SPECIAL_FRAME_MSK);
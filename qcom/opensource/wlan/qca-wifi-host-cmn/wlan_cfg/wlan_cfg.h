@@ -343,6 +343,7 @@ struct wlan_srng_cfg {
  *                                         type handling is disabled
  * @tx_pkt_inspect_for_ilp: flag to indicate if TX packet inspection for HW
  *			    based ILP feature is enabled
+ * @vdev_stats_aggr_cache_ms: max age of a cached vdev stats aggregate in ms
  * @pointer_timer_threshold_rx: RX REO2SW ring pointer update timer threshold
  * @pointer_num_threshold_rx: RX REO2SW ring pointer update entries threshold
  * @local_pkt_capture: flag indicating enable/disable of local packet capture
@@ -554,6 +555,9 @@ struct wlan_cfg_dp_soc_ctxt {
 	bool is_handle_invalid_decap_type_disabled;
 #ifdef DP_TX_PACKET_INSPECT_FOR_ILP
 	bool tx_pkt_inspect_for_ilp;
+#endif
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+	uint32_t vdev_stats_aggr_cache_ms;
 #endif
 	uint16_t pointer_timer_threshold_rx;
 	uint8_t pointer_num_threshold_rx;
@@ -2652,6 +2656,21 @@ wlan_cfg_get_tx_ilp_inspect_config(struct wlan_cfg_dp_soc_ctxt *cfg)
 }
 #endif
 
+#ifdef WLAN_DP_VDEV_STATS_AGGR_CACHE
+/**
+ * wlan_cfg_get_vdev_stats_aggr_cache_ms() - Get max age of a cached vdev
+ *					     stats aggregate
+ * @cfg: Configuration Handle
+ *
+ * Return: max age in ms, 0 if the cache is disabled
+ */
+static inline uint32_t
+wlan_cfg_get_vdev_stats_aggr_cache_ms(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->vdev_stats_aggr_cache_ms;
+}
+#endif
+
 /**
  * wlan_cfg_get_napi_scale_factor() - Get napi scale factor
  * @cfg: soc configuration context
@@ -26,6 +26,7 @@
 #include <osdep.h>
 #include "wmi_unified_api.h"
 #include "wmi_unified_param.h"
+#include "wmi_tlv_helper.h"
 #include "wlan_scan_ucfg_api.h"
 #include "qdf_atomic.h"
 #include <wbuff.h>
@@ -122,6 +123,15 @@
 #endif
 
 #define WMI_UNIFIED_MAX_EVENT 0x100
+/*
+ * FW event id to event handler index map, open addressed with linear
+ * probing. Kept at twice the max handler count so that probe sequences
+ * stay short even with all handlers registered.
+ */
+#define WMI_EVENT_IDX_MAP_SIZE (2 * WMI_UNIFIED_MAX_EVENT)
+#define WMI_EVENT_IDX_MAP_MASK (WMI_EVENT_IDX_MAP_SIZE - 1)
+/* Size of the scratch buffer the rx event TLVs are parsed into */
+#define WMI_TLV_SCRATCH_SIZE 0x2000
 
 #ifdef WMI_EXT_DBG
 
@@ -2591,11 +2601,13 @@ void (*wmi_pdev_id_conversion_enable)(wmi_unified_t wmi_handle,
 				      uint8_t size);
 void (*send_time_stamp_sync_cmd)(wmi_unified_t wmi_handle);
 void (*wmi_free_allocated_event)(uint32_t cmd_event_id,
-				void **wmi_cmd_struct_ptr);
+				void **wmi_cmd_struct_ptr,
+				wmitlv_scratch *scratch);
 int (*wmi_check_and_pad_event)(void *os_handle, void *param_struc_ptr,
 				uint32_t param_buf_len,
 				uint32_t wmi_cmd_event_id,
-				void **wmi_cmd_struct_ptr);
+				void **wmi_cmd_struct_ptr,
+				wmitlv_scratch *scratch);
 int (*wmi_check_command_params)(void *os_handle, void *param_struc_ptr,
 				uint32_t param_buf_len,
 				uint32_t wmi_cmd_event_id);
@@ -3594,8 +3606,13 @@ struct wmi_soc {
 	uint32_t event_id[WMI_UNIFIED_MAX_EVENT];
 	wmi_unified_event_handler event_handler[WMI_UNIFIED_MAX_EVENT];
 	uint32_t max_event_idx;
+	/* event handler index + 1 per slot, 0 marks an empty slot */
+	uint16_t event_idx_map[WMI_EVENT_IDX_MAP_SIZE];
 	struct wmi_unified_exec_ctx ctx[WMI_UNIFIED_MAX_EVENT];
 	qdf_spinlock_t ctx_lock;
+	/* rx event TLV scratch buffer, owned by whoever sets bit 0 in use */
+	wmitlv_scratch tlv_scratch;
+	unsigned long tlv_scratch_in_use;
 	struct wmi_unified *wmi_pdev[WMI_MAX_RADIOS];
 	HTC_ENDPOINT_ID wmi_endpoint_id[WMI_MAX_RADIOS];
 	uint16_t max_msg_len[WMI_MAX_RADIOS];
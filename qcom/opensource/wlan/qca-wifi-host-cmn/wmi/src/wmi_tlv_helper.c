@@ -57,8 +57,59 @@ uint32_t evt_attr_list[] = {
 #ifdef NO_DYNAMIC_MEM_ALLOC
 static wmitlv_cmd_param_info *g_wmi_static_cmd_param_info_buf;
 uint32_t g_wmi_static_max_cmd_param_tlvs;
+#else
+#define WMITLV_SCRATCH_ALIGN(len) \
+	(((len) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1))
+
+/**
+ * wmitlv_mem_alloc() - allocate memory for TLV processing
+ * @os_handle: os context handle
+ * @scratch: scratch buffer to allocate from, NULL to use the heap
+ * @len: number of bytes
+ *
+ * Return: allocated memory, NULL on failure
+ */
+static void *wmitlv_mem_alloc(void *os_handle, wmitlv_scratch *scratch,
+			      uint32_t len)
+{
+	void *ptr;
+	uint32_t used;
+
+	if (scratch && scratch->buf) {
+		used = WMITLV_SCRATCH_ALIGN(scratch->used);
+		if (used <= scratch->size && len <= scratch->size - used) {
+			scratch->used = used + len;
+			return scratch->buf + used;
+		}
+	}
+
+	wmi_tlv_os_mem_alloc(os_handle, ptr, len);
+
+	return ptr;
+}
+
+/**
+ * wmitlv_mem_free() - free memory allocated by wmitlv_mem_alloc()
+ * @scratch: scratch buffer the memory may have been allocated from
+ * @ptr: memory to free
+ *
+ * Return: none
+ */
+static void wmitlv_mem_free(wmitlv_scratch *scratch, void *ptr)
+{
+	if (scratch && scratch->buf && (uint8_t *)ptr >= scratch->buf &&
+	    (uint8_t *)ptr < scratch->buf + scratch->size)
+		return;
+
+	wmi_tlv_os_mem_free(ptr);
+}
 #endif
 
+static void wmitlv_free_allocated_tlvs(uint32_t is_cmd_id,
+				       uint32_t cmd_event_id,
+				       void **wmi_cmd_struct_ptr,
+				       wmitlv_scratch *scratch);
+
 
 /**
  * wmitlv_set_static_param_tlv_buf() - tlv helper function
@@ -479,6 +530,7 @@ qdf_export_symbol(wmitlv_check_command_tlv_params);
  * @is_cmd_id: boolean for command attribute
  * @wmi_cmd_event_id: command event id
  * @wmi_cmd_struct_ptr: wmi command structure
+ * @scratch: scratch buffer for the allocations, NULL to use the heap
  *
  *
  * validate the TLV's coming for an event/command and
@@ -489,7 +541,8 @@ qdf_export_symbol(wmitlv_check_command_tlv_params);
 static int
 wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 			  uint32_t param_buf_len, uint32_t is_cmd_id,
-			  uint32_t wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
+			  uint32_t wmi_cmd_event_id, void **wmi_cmd_struct_ptr,
+			  wmitlv_scratch *scratch)
 {
 	wmitlv_attributes_struc attr_struct_ptr;
 	uint32_t buf_idx = 0;
@@ -526,8 +579,8 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 		attr_struct_ptr.cmd_num_tlv * sizeof(wmitlv_cmd_param_info);
 #ifndef NO_DYNAMIC_MEM_ALLOC
 	/* Dynamic memory allocation supported */
-	wmi_tlv_os_mem_alloc(os_handle, *wmi_cmd_struct_ptr,
-			     len_wmi_cmd_struct_buf);
+	*wmi_cmd_struct_ptr = wmitlv_mem_alloc(os_handle, scratch,
+					       len_wmi_cmd_struct_buf);
 #else
 	/* Dynamic memory allocation is not supported. Use the buffer
 	 * g_wmi_static_cmd_param_info_buf, which should be set using
@@ -707,9 +760,10 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				WMITLV_GET_TLVLEN(WMITLV_GET_HDR(buf_ptr)) +
 				WMI_TLV_HDR_SIZE;
 #ifndef NO_DYNAMIC_MEM_ALLOC
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (num_of_elems *
-					      attr_struct_ptr.tag_struct_size));
+			new_tlv_buf =
+				wmitlv_mem_alloc(os_handle, scratch,
+						 (num_of_elems *
+						  attr_struct_ptr.tag_struct_size));
 			if (!new_tlv_buf) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -914,8 +968,9 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				__func__, tlv_size_diff);
 #ifndef NO_DYNAMIC_MEM_ALLOC
 			/* Dynamic memory allocation is supported */
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (curr_tlv_len - tlv_size_diff));
+			new_tlv_buf = wmitlv_mem_alloc(os_handle, scratch,
+						       (curr_tlv_len -
+							tlv_size_diff));
 			if (!new_tlv_buf) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -970,13 +1025,8 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 
 	return 0;
 Error_wmitlv_check_and_pad_tlvs:
-	if (is_cmd_id) {
-		wmitlv_free_allocated_command_tlvs(wmi_cmd_event_id,
-						   wmi_cmd_struct_ptr);
-	} else {
-		wmitlv_free_allocated_event_tlvs(wmi_cmd_event_id,
-						 wmi_cmd_struct_ptr);
-	}
+	wmitlv_free_allocated_tlvs(is_cmd_id, wmi_cmd_event_id,
+				   wmi_cmd_struct_ptr, scratch);
 	*wmi_cmd_struct_ptr = NULL;
 	return error;
 }
@@ -1003,10 +1053,41 @@ wmitlv_check_and_pad_event_tlvs(void *os_handle, void *param_struc_ptr,
 	uint32_t is_cmd_id = 0;
 	return wmitlv_check_and_pad_tlvs
 			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 qdf_export_symbol(wmitlv_check_and_pad_event_tlvs);
 
+/**
+ * wmitlv_check_and_pad_event_tlvs_scratch() - tlv helper function
+ * @os_handle: os context handle
+ * @param_struc_ptr: pointer to tlv structure
+ * @param_buf_len: length of tlv parameter
+ * @wmi_cmd_event_id: command event id
+ * @wmi_cmd_struct_ptr: wmi command structure
+ * @scratch: scratch buffer for the allocations
+ *
+ *
+ * validate and pad(if necessary) for incoming WMI Event TLVs, carving
+ * the buffers out of @scratch as long as they fit. The buffers must be
+ * released with wmitlv_free_allocated_event_tlvs_scratch().
+ *
+ * Return: 0 if success. Return < 0 if failure.
+ */
+int
+wmitlv_check_and_pad_event_tlvs_scratch(void *os_handle,
+					void *param_struc_ptr,
+					uint32_t param_buf_len,
+					uint32_t wmi_cmd_event_id,
+					void **wmi_cmd_struct_ptr,
+					wmitlv_scratch *scratch)
+{
+	uint32_t is_cmd_id = 0;
+	return wmitlv_check_and_pad_tlvs
+			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, scratch);
+}
+qdf_export_symbol(wmitlv_check_and_pad_event_tlvs_scratch);
+
 /**
  * wmitlv_check_and_pad_command_tlvs() - tlv helper function
  * @os_handle: os context handle
@@ -1029,7 +1110,7 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
 	uint32_t is_cmd_id = 1;
 	return wmitlv_check_and_pad_tlvs
 			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 
 /**
@@ -1037,21 +1118,26 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
  * @is_cmd_id: bollean to check if cmd or event tlv
  * @cmd_event_id: command or event id
  * @wmi_cmd_struct_ptr: wmi command structure
+ * @scratch: scratch buffer used for the allocations, NULL for the heap
  *
  *
- * free any allocated buffers for WMI Event/Command TLV processing
+ * free any allocated buffers for WMI Event/Command TLV processing and
+ * reset @scratch for the next Event/Command
  *
  * Return: none
  */
 static void wmitlv_free_allocated_tlvs(uint32_t is_cmd_id,
 				       uint32_t cmd_event_id,
-				       void **wmi_cmd_struct_ptr)
+				       void **wmi_cmd_struct_ptr,
+				       wmitlv_scratch *scratch)
 {
 	void *ptr = *wmi_cmd_struct_ptr;
 
 	if (!ptr) {
 		wmi_tlv_print_error("%s: Nothing to free for CMD/Event 0x%x\n",
 				    __func__, cmd_event_id);
+		if (scratch)
+			scratch->used = 0;
 		return;
 	}
 #ifndef NO_DYNAMIC_MEM_ALLOC
@@ -1061,7 +1147,7 @@ static void wmitlv_free_allocated_tlvs(uint32_t is_cmd_id,
 	if ((((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->WMITLV_FIELD_BUF_IS_ALLOCATED(elem_name)) &&	\
 	    (((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name)) \
 	{ \
-		wmi_tlv_os_mem_free(((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name); \
+		wmitlv_mem_free(scratch, ((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name); \
 	}
 
 #define WMITLV_FREE_TLV_ELEMS(id)	     \
@@ -1089,8 +1175,10 @@ break;
 		}
 	}
 
-	wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
+	wmitlv_mem_free(scratch, *wmi_cmd_struct_ptr);
 	*wmi_cmd_struct_ptr = NULL;
+	if (scratch)
+		scratch->used = 0;
 #endif
 
 	return;
@@ -1109,7 +1197,7 @@ break;
 void wmitlv_free_allocated_command_tlvs(uint32_t cmd_event_id,
 					void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 
 /**
@@ -1125,10 +1213,31 @@ void wmitlv_free_allocated_command_tlvs(uint32_t cmd_event_id,
 void wmitlv_free_allocated_event_tlvs(uint32_t cmd_event_id,
 				      void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 qdf_export_symbol(wmitlv_free_allocated_event_tlvs);
 
+/**
+ * wmitlv_free_allocated_event_tlvs_scratch() - tlv helper function
+ * @cmd_event_id: command or event id
+ * @wmi_cmd_struct_ptr: wmi command structure
+ * @scratch: scratch buffer used for the allocations
+ *
+ *
+ * free any allocated buffers for WMI Event TLV processing done by
+ * wmitlv_check_and_pad_event_tlvs_scratch() and reset @scratch
+ *
+ * Return: none
+ */
+void wmitlv_free_allocated_event_tlvs_scratch(uint32_t cmd_event_id,
+					      void **wmi_cmd_struct_ptr,
+					      wmitlv_scratch *scratch)
+{
+	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr,
+				   scratch);
+}
+qdf_export_symbol(wmitlv_free_allocated_event_tlvs_scratch);
+
 /**
  * wmi_versions_are_compatible() - tlv helper function
  * @vers1: host wmi version
@@ -2230,6 +2230,121 @@ QDF_STATUS wmi_unified_cmd_send_fl(wmi_unified_t wmi_handle, wmi_buf_t buf,
 }
 qdf_export_symbol(wmi_unified_cmd_send_fl);
 
+/**
+ * wmi_event_idx_map_hash() - home slot of a FW event id in the index map
+ * @evt_id: FW event id
+ *
+ * FW event ids are (group << 12) | offset, multiplicative hashing spreads
+ * both the group and the offset bits over the map.
+ *
+ * Return: slot in soc event_idx_map
+ */
+static inline uint32_t wmi_event_idx_map_hash(uint32_t evt_id)
+{
+	return ((evt_id * 0x9E3779B1) >> 16) & WMI_EVENT_IDX_MAP_MASK;
+}
+
+/**
+ * wmi_event_idx_map_find() - find the map slot holding a FW event id
+ * @wmi_handle: handle to wmi
+ * @evt_id: FW event id
+ *
+ * Return: slot in soc event_idx_map, -1 if the event id is not mapped
+ */
+static int wmi_event_idx_map_find(wmi_unified_t wmi_handle, uint32_t evt_id)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t slot = wmi_event_idx_map_hash(evt_id);
+	uint32_t probe;
+	uint16_t ent;
+
+	for (probe = 0; probe < WMI_EVENT_IDX_MAP_SIZE; probe++) {
+		ent = soc->event_idx_map[slot];
+		if (!ent)
+			break;
+
+		if (wmi_handle->event_id[ent - 1] == evt_id)
+			return slot;
+
+		slot = (slot + 1) & WMI_EVENT_IDX_MAP_MASK;
+	}
+
+	return -1;
+}
+
+/**
+ * wmi_event_idx_map_add() - map a FW event id to its event handler index
+ * @wmi_handle: handle to wmi
+ * @evt_id: FW event id
+ * @idx: event handler index
+ *
+ * The map is twice the size of the handler table, a free slot is always
+ * found.
+ *
+ * Return: None
+ */
+static void wmi_event_idx_map_add(wmi_unified_t wmi_handle, uint32_t evt_id,
+				  uint32_t idx)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t slot = wmi_event_idx_map_hash(evt_id);
+
+	while (soc->event_idx_map[slot])
+		slot = (slot + 1) & WMI_EVENT_IDX_MAP_MASK;
+
+	soc->event_idx_map[slot] = idx + 1;
+}
+
+/**
+ * wmi_event_idx_map_del() - unmap the event handler at index @idx
+ * @wmi_handle: handle to wmi
+ * @idx: event handler index being unregistered
+ *
+ * Must be called before the last event handler is moved into @idx, the
+ * map entry of the moved handler is re-pointed to @idx. Entries following
+ * the freed slot are shifted back so that lookups never need tombstones.
+ *
+ * Return: None
+ */
+static void wmi_event_idx_map_del(wmi_unified_t wmi_handle, uint32_t idx)
+{
+	struct wmi_soc *soc = wmi_handle->soc;
+	uint32_t last = soc->max_event_idx - 1;
+	uint32_t hole, next, home;
+	int slot;
+
+	slot = wmi_event_idx_map_find(wmi_handle, wmi_handle->event_id[idx]);
+	if (slot < 0)
+		return;
+
+	hole = slot;
+	soc->event_idx_map[hole] = 0;
+	next = hole;
+	while (true) {
+		next = (next + 1) & WMI_EVENT_IDX_MAP_MASK;
+		if (!soc->event_idx_map[next])
+			break;
+
+		home = wmi_event_idx_map_hash(
+			wmi_handle->event_id[soc->event_idx_map[next] - 1]);
+		/* entry can only move back if hole lies within home..next */
+		if (((next - home) & WMI_EVENT_IDX_MAP_MASK) <
+		    ((next - hole) & WMI_EVENT_IDX_MAP_MASK))
+			continue;
+
+		soc->event_idx_map[hole] = soc->event_idx_map[next];
+		soc->event_idx_map[next] = 0;
+		hole = next;
+	}
+
+	if (idx == last)
+		return;
+
+	slot = wmi_event_idx_map_find(wmi_handle, wmi_handle->event_id[last]);
+	if (slot >= 0)
+		soc->event_idx_map[slot] = idx + 1;
+}
+
 /**
  * wmi_unified_get_event_handler_ix() - gives event handler's index
  * @wmi_handle: handle to wmi
@@ -2240,19 +2355,19 @@ qdf_export_symbol(wmi_unified_cmd_send_fl);
 static int wmi_unified_get_event_handler_ix(wmi_unified_t wmi_handle,
 					    uint32_t event_id)
 {
-	uint32_t idx = 0;
 	int32_t invalid_idx = -1;
-	struct wmi_soc *soc = wmi_handle->soc;
+	int slot;
+	uint32_t idx;
 
-	for (idx = 0; (idx < soc->max_event_idx &&
-		       idx < WMI_UNIFIED_MAX_EVENT); ++idx) {
-		if (wmi_handle->event_id[idx] == event_id &&
-		    wmi_handle->event_handler[idx]) {
-			return idx;
-		}
-	}
+	slot = wmi_event_idx_map_find(wmi_handle, event_id);
+	if (slot < 0)
+		return invalid_idx;
 
-	return invalid_idx;
+	idx = wmi_handle->soc->event_idx_map[slot] - 1;
+	if (idx >= WMI_UNIFIED_MAX_EVENT || !wmi_handle->event_handler[idx])
+		return invalid_idx;
+
+	return idx;
 }
 
 /**
@@ -2313,6 +2428,7 @@ wmi_register_event_handler_with_ctx(wmi_unified_t wmi_handle,
 	idx = soc->max_event_idx;
 	wmi_handle->event_handler[idx] = handler_func;
 	wmi_handle->event_id[idx] = evt_id;
+	wmi_event_idx_map_add(wmi_handle, evt_id, idx);
 
 	qdf_spin_lock_bh(&soc->ctx_lock);
 	wmi_handle->ctx[idx].exec_ctx = rx_ctx;
@@ -2388,6 +2504,7 @@ QDF_STATUS wmi_unified_unregister_event(wmi_unified_t wmi_handle,
 			 evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
+	wmi_event_idx_map_del(wmi_handle, idx);
 	wmi_handle->event_handler[idx] = NULL;
 	wmi_handle->event_id[idx] = 0;
 	--soc->max_event_idx;
@@ -2440,6 +2557,7 @@ QDF_STATUS wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle,
 			 evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
+	wmi_event_idx_map_del(wmi_handle, idx);
 	wmi_handle->event_handler[idx] = NULL;
 	wmi_handle->event_id[idx] = 0;
 	--soc->max_event_idx;
@@ -2884,6 +3002,39 @@ int wmi_process_qmi_fw_event(void *wmi_cb_ctx, void *buf, int len)
 }
 #endif
 
+/**
+ * wmi_tlv_scratch_get() - claim the soc rx event TLV scratch buffer
+ * @soc: WMI soc handle
+ *
+ * Events are processed in several execution contexts at the same time,
+ * the context that does not get the scratch buffer parses into the heap.
+ *
+ * Return: scratch buffer, NULL if it is in use by another context
+ */
+static inline wmitlv_scratch *wmi_tlv_scratch_get(struct wmi_soc *soc)
+{
+	if (!soc->tlv_scratch.buf ||
+	    qdf_atomic_test_and_set_bit(0, &soc->tlv_scratch_in_use))
+		return NULL;
+
+	return &soc->tlv_scratch;
+}
+
+/**
+ * wmi_tlv_scratch_put() - release the scratch buffer got from
+ *			   wmi_tlv_scratch_get()
+ * @soc: WMI soc handle
+ * @scratch: scratch buffer, may be NULL
+ *
+ * Return: none
+ */
+static inline void wmi_tlv_scratch_put(struct wmi_soc *soc,
+				       wmitlv_scratch *scratch)
+{
+	if (scratch)
+		qdf_atomic_clear_bit(0, &soc->tlv_scratch_in_use);
+}
+
 void wmi_process_fw_event(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 {
 	__wmi_control_rx(wmi_handle, evt_buf);
@@ -2901,6 +3052,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	uint32_t idx = 0;
 	struct wmi_raw_event_buffer ev_buf;
 	enum wmi_rx_buff_type ev_buff_type;
+	wmitlv_scratch *scratch = NULL;
 
 	id = WMI_GET_FIELD(qdf_nbuf_data(evt_buf), WMI_CMD_HDR, COMMANDID);
 
@@ -2915,11 +3067,13 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 
 #ifndef WMI_NON_TLV_SUPPORT
 	if (wmi_handle->target_type == WMI_TLV_TARGET) {
+		scratch = wmi_tlv_scratch_get(wmi_handle->soc);
 		/* Validate and pad(if necessary) the TLVs */
 		tlv_ok_status =
 			wmi_handle->ops->wmi_check_and_pad_event(wmi_handle->scn_handle,
 							data, len, id,
-							&wmi_cmd_struct_ptr);
+							&wmi_cmd_struct_ptr,
+							scratch);
 		if (tlv_ok_status != 0) {
 			QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
 				  "%s: Error: id=0x%x, wmitlv check status=%d",
@@ -2981,8 +3135,11 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 end:
 	/* Free event buffer and allocated event tlv */
 #ifndef WMI_NON_TLV_SUPPORT
-	if (wmi_handle->target_type == WMI_TLV_TARGET)
-		wmi_handle->ops->wmi_free_allocated_event(id, &wmi_cmd_struct_ptr);
+	if (wmi_handle->target_type == WMI_TLV_TARGET) {
+		wmi_handle->ops->wmi_free_allocated_event(id, &wmi_cmd_struct_ptr,
+							  scratch);
+		wmi_tlv_scratch_put(wmi_handle->soc, scratch);
+	}
 #endif
 
 	wmi_rx_nbuf_free(evt_buf);
@@ -3391,6 +3548,10 @@ void *wmi_unified_attach(void *scn_handle,
 	/* Increase the ref count once refcount infra is present */
 	soc->wmi_psoc = param->psoc;
 	qdf_spinlock_create(&soc->ctx_lock);
+	/* events are parsed into the heap if this fails */
+	soc->tlv_scratch.buf = qdf_mem_malloc(WMI_TLV_SCRATCH_SIZE);
+	if (soc->tlv_scratch.buf)
+		soc->tlv_scratch.size = WMI_TLV_SCRATCH_SIZE;
 	soc->ops = wmi_handle->ops;
 	soc->wmi_pdev[0] = wmi_handle;
 	if (wmi_ext_dbgfs_init(wmi_handle, 0) != QDF_STATUS_SUCCESS)
@@ -3471,6 +3632,11 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 	}
 	qdf_spinlock_destroy(&soc->ctx_lock);
 
+	if (soc->tlv_scratch.buf) {
+		qdf_mem_free(soc->tlv_scratch.buf);
+		soc->tlv_scratch.buf = NULL;
+	}
+
 	if (soc->wmi_service_bitmap) {
 		qdf_mem_free(soc->wmi_service_bitmap);
 		soc->wmi_service_bitmap = NULL;
@@ -75,6 +75,21 @@ struct dp_rtpm_tput_policy_context {
 };
 #endif
 
+#ifdef WLAN_DP_BUS_BW_PREDICT
+/**
+ * struct dp_bus_bw_predictor - Packet count forecast of the bus bw work
+ * @level: smoothed packets per bus bw interval
+ * @trend: smoothed change of @level per bus bw interval
+ *
+ * Double exponential smoothing of the per interval packet count, the
+ * forecast for the next interval being @level + @trend.
+ */
+struct dp_bus_bw_predictor {
+	int64_t level;
+	int64_t trend;
+};
+#endif
+
 #define FISA_FLOW_MAX_AGGR_COUNT        16 /* max flow aggregate count */
 
 /**
@@ -358,12 +373,14 @@ struct dp_fisa_reo_mismatch_stats {
  * @reo_mismatch: REO ID mismatch
  * @incorrect_rdi: Incorrect REO dest indication in TLV
  *		   (typically used for RDI = 0)
+ * @flow_steer_moves: elephant flows moved to another rx thread
  */
 struct dp_fisa_stats {
 	uint32_t invalid_flow_index;
 	uint32_t update_deferred;
 	struct dp_fisa_reo_mismatch_stats reo_mismatch;
 	uint32_t incorrect_rdi;
+	uint32_t flow_steer_moves;
 };
 
 /**
@@ -436,6 +453,16 @@ struct fisa_pkt_hist {
  * @pkt_hist: FISA aggreagtion packets history
  * @same_mld_vdev_mismatch: Packets flushed after vdev_mismatch on same MLD
  * @add_timestamp: FISA entry created timestamp
+ * @last_rx_ts: sched_clock timestamp (ns) of the last aggregated packet
+ * @avg_rx_gap_ns: moving average of the packet inter-arrival time
+ * @aggr_limit: current per-flow limit on packets per aggregate
+ * @frag_aggr_count: Packets merged into the head skb page frags
+ * @frag_aggr_len: Bytes of the current aggregate merged into the head skb
+ * @aggr_limit_flush_count: Flushes triggered by @aggr_limit
+ * @steer_bytes: bytes received on the flow, for rx thread steering
+ * @steer_last_bytes: @steer_bytes at the last steering rebalance
+ * @steer_thread: rx thread id + 1 the flow is steered to, 0 if not steered
+ * @steer_hash: RX flow id (toeplitz hash) used to index the steering table
  */
 struct dp_fisa_rx_sw_ft {
 	void *hw_fse;
@@ -486,6 +513,20 @@ struct dp_fisa_rx_sw_ft {
 #endif
 	uint64_t same_mld_vdev_mismatch;
 	uint64_t add_timestamp;
+#ifdef WLAN_DP_FISA_FRAG_AGGR
+	uint64_t last_rx_ts;
+	uint32_t avg_rx_gap_ns;
+	uint8_t aggr_limit;
+	uint32_t frag_aggr_count;
+	uint16_t frag_aggr_len;
+	uint32_t aggr_limit_flush_count;
+#endif
+#ifdef WLAN_DP_RX_FLOW_STEERING
+	uint64_t steer_bytes;
+	uint64_t steer_last_bytes;
+	uint8_t steer_thread;
+	uint32_t steer_hash;
+#endif
 };
 
 #define DP_RX_GET_SW_FT_ENTRY_SIZE sizeof(struct dp_fisa_rx_sw_ft)
@@ -574,6 +615,20 @@ struct dp_rx_fst {
 	uint16_t rx_pkt_tlv_size;
 };
 
+/**
+ * struct dp_tx_batch - frames held back while the OS has more frames queued
+ *			for transmission
+ * @lock: protects @nbuf_q, the frames are added on the owning CPU only but
+ *	  may be flushed or purged from another context
+ * @nbuf_q: held frames
+ * @hold_ts: time in ticks the oldest held frame was queued
+ */
+struct dp_tx_batch {
+	qdf_spinlock_t lock;
+	qdf_nbuf_queue_t nbuf_q;
+	qdf_time_t hold_ts;
+};
+
 /**
  * struct wlan_dp_intf - DP interface object related info
  * @dp_ctx: DP context reference
@@ -626,6 +681,7 @@ struct dp_rx_fst {
  * @def_link: Pointer to default link (usually used for TX operation)
  * @dp_link_list_lock: Lock to protect dp_link_list operatiosn
  * @dp_link_list: List of dp_links for this DP interface
+ * @tx_batch: per CPU tx bursts handed to txrx_ops.tx.tx_list at once
  */
 struct wlan_dp_intf {
 	struct wlan_dp_psoc_context *dp_ctx;
@@ -694,6 +750,7 @@ struct wlan_dp_intf {
 	struct wlan_dp_link *def_link;
 	qdf_spinlock_t dp_link_list_lock;
 	qdf_list_t dp_link_list;
+	struct dp_tx_batch tx_batch[NUM_CPUS];
 };
 
 #define WLAN_DP_LINK_MAGIC 0x5F44505F4C494E4B	/* "_DP_LINK" in ASCII */
@@ -805,6 +862,8 @@ struct dp_direct_link_context {
  * @dp_agg_param.tc_based_dyn_gro:
  * @dp_agg_param.tc_ingress_prio:
  * @rtpm_tput_policy_ctx: Runtime Tput policy context
+ * @tx_predict: Tx packet count forecast of the bus bw work
+ * @rx_predict: Rx packet count forecast of the bus bw work
  * @txrx_hist: TxRx histogram
  * @bbm_ctx: bus bandwidth manager context
  * @dp_direct_link_lock: Direct link mutex lock
@@ -871,6 +930,10 @@ struct wlan_dp_psoc_context {
 #ifdef FEATURE_RUNTIME_PM
 	struct dp_rtpm_tput_policy_context rtpm_tput_policy_ctx;
 #endif
+#ifdef WLAN_DP_BUS_BW_PREDICT
+	struct dp_bus_bw_predictor tx_predict;
+	struct dp_bus_bw_predictor rx_predict;
+#endif
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 	qdf_atomic_t disable_rx_ol_in_concurrency;
 	qdf_atomic_t disable_rx_ol_in_low_tput;
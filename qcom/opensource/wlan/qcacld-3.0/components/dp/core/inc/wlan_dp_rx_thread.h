@@ -37,6 +37,14 @@
 /* Number of DP RX threads supported */
 #define DP_MAX_RX_THREADS WLAN_CFG_NUM_REO_DEST_RING
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/* Number of flow hash buckets in the rx thread steering table */
+#define DP_RX_TM_FLOW_STEER_TBL_SIZE 256
+#define DP_RX_TM_FLOW_STEER_TBL_MASK (DP_RX_TM_FLOW_STEER_TBL_SIZE - 1)
+/* Steering table entry value for flows following the REO ring mapping */
+#define DP_RX_TM_FLOW_STEER_NONE 0
+#endif
+
 /*
  * struct dp_rx_tm_handle_cmn - Opaque handle for rx_threads to store
  * rx_tm_handle. This handle will be common for all the threads.
@@ -63,6 +71,8 @@ struct dp_rx_tm_handle_cmn;
  * @dropped_others: packets dropped due to other reasons
  * @dropped_enq_fail: packets dropped due to pending queue full
  * @rx_nbufq_loop_yield: rx loop yield counter
+ * @nbuf_steered: packets steered from this thread's REO ring to another
+ *		  thread by the flow steering table
  */
 struct dp_rx_thread_stats {
 	unsigned int nbuf_queued[DP_RX_TM_MAX_REO_RINGS];
@@ -79,6 +89,7 @@ struct dp_rx_thread_stats {
 	unsigned int dropped_others;
 	unsigned int dropped_enq_fail;
 	unsigned int rx_nbufq_loop_yield;
+	unsigned int nbuf_steered;
 };
 
 /**
@@ -117,6 +128,9 @@ enum dp_rx_refill_thread_state {
  * @napi: napi to deliver packet to stack via GRO
  * @wait_q: wait queue to conditionally wait on events for DP Rx thread
  * @netdev: dummy netdev to initialize the napi structure with
+ * @steer_flush_pending: bitmap of threads which received flows steered away
+ *			 from this thread and still need a GRO flush
+ *			 indication
  */
 struct dp_rx_thread {
 	uint8_t id;
@@ -135,6 +149,9 @@ struct dp_rx_thread {
 	qdf_napi_struct napi;
 	qdf_wait_queue_head_t wait_q;
 	qdf_dummy_netdev_t netdev;
+#ifdef WLAN_DP_RX_FLOW_STEERING
+	unsigned long steer_flush_pending;
+#endif
 };
 
 /**
@@ -185,6 +202,8 @@ enum dp_rx_thread_state {
  * @state: state of the rx_threads. All of them should be in the same state.
  * @rx_thread: array of pointers of type struct dp_rx_thread
  * @allow_dropping: flag to indicate frame dropping is enabled
+ * @flow_steer_tbl: rx thread id + 1 per flow hash bucket, or
+ *		    DP_RX_TM_FLOW_STEER_NONE to use the REO ring mapping
  */
 struct dp_rx_tm_handle {
 	uint8_t num_dp_rx_threads;
@@ -192,6 +211,9 @@ struct dp_rx_tm_handle {
 	enum dp_rx_thread_state state;
 	struct dp_rx_thread **rx_thread;
 	qdf_atomic_t allow_dropping;
+#ifdef WLAN_DP_RX_FLOW_STEERING
+	uint8_t flow_steer_tbl[DP_RX_TM_FLOW_STEER_TBL_SIZE];
+#endif
 };
 
 /**
@@ -377,6 +399,23 @@ qdf_napi_struct *dp_rx_tm_get_napi_context(struct dp_rx_tm_handle *rx_tm_hdl,
 QDF_STATUS dp_rx_tm_set_cpu_mask(struct dp_rx_tm_handle *rx_tm_hdl,
 				 qdf_cpu_mask *new_mask);
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * dp_rx_tm_update_flow_steering() - update the rx thread flow steering table
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ *             infrastructure
+ * @steer_tbl: DP_RX_TM_FLOW_STEER_TBL_SIZE entries holding rx thread id + 1
+ *	       for a steered flow hash bucket, or DP_RX_TM_FLOW_STEER_NONE
+ *
+ * Only the entries which differ from the current table are written, so
+ * flows which keep their thread see no change.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+QDF_STATUS dp_rx_tm_update_flow_steering(struct dp_rx_tm_handle *rx_tm_hdl,
+					 const uint8_t *steer_tbl);
+#endif
+
 #ifdef FEATURE_WLAN_DP_RX_THREADS
 /**
  * dp_txrx_get_cmn_hdl_frm_ext_hdl() - conversion func ext_hdl->txrx_handle_cmn
@@ -688,6 +727,33 @@ ret:
 	return qdf_status;
 }
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * dp_rx_update_flow_steering() - update flow to rx thread steering table
+ * @soc: ol_txrx_soc_handle object
+ * @steer_tbl: DP_RX_TM_FLOW_STEER_TBL_SIZE entries of rx thread id + 1, or
+ *	       DP_RX_TM_FLOW_STEER_NONE, indexed by flow hash
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+static inline
+QDF_STATUS dp_rx_update_flow_steering(ol_txrx_soc_handle soc,
+				      const uint8_t *steer_tbl)
+{
+	struct dp_txrx_handle *dp_ext_hdl;
+
+	if (!soc)
+		return QDF_STATUS_E_INVAL;
+
+	dp_ext_hdl = cdp_soc_get_dp_txrx_handle(soc);
+	if (!dp_ext_hdl)
+		return QDF_STATUS_E_FAULT;
+
+	return dp_rx_tm_update_flow_steering(&dp_ext_hdl->rx_tm_hdl,
+					     steer_tbl);
+}
+#endif
+
 #else
 
 static inline
@@ -750,6 +816,15 @@ QDF_STATUS dp_txrx_set_cpu_mask(ol_txrx_soc_handle soc, qdf_cpu_mask *new_mask)
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+static inline
+QDF_STATUS dp_rx_update_flow_steering(ol_txrx_soc_handle soc,
+				      const uint8_t *steer_tbl)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
 #endif /* FEATURE_WLAN_DP_RX_THREADS */
 
 /**
@@ -205,6 +205,57 @@ dp_softap_rx_packet_cbk(void *intf_ctx, qdf_nbuf_t rx_buf);
 QDF_STATUS
 dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf);
 
+/**
+ * dp_tx_batch_init() - Initialize the per CPU tx batches of an interface
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_tx_batch_init(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_tx_batch_deinit() - Drop the held frames and deinit the per CPU tx
+ *			  batches of an interface
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_tx_batch_deinit(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_tx_batch_purge() - Drop the frames held in the tx batches of an
+ *			 interface
+ * @dp_intf: DP interface
+ *
+ * Used when the interface stops or loses a link, the held frames are
+ * accounted as tx drops.
+ *
+ * Return: None
+ */
+void dp_tx_batch_purge(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_tx_batch_flush_stale() - Transmit frames held longer than the max
+ *			       hold time
+ * @dp_intf: DP interface
+ *
+ * Covers a burst whose last frame never reached dp_start_xmit().
+ *
+ * Return: None
+ */
+void dp_tx_batch_flush_stale(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_tx_batch_end() - End the tx burst of the current CPU
+ * @dp_intf: DP interface
+ *
+ * Called from the xmit context when a frame is dropped before it reaches
+ * dp_start_xmit(), the frames held so far are transmitted.
+ *
+ * Return: None
+ */
+void dp_tx_batch_end(struct wlan_dp_intf *dp_intf);
+
 /**
  * dp_tx_timeout() - DP Tx timeout API
  * @dp_intf: Data path interface pointer
@@ -42,6 +42,7 @@
 #include "cdp_txrx_host_stats.h"
 #include "wlan_cm_roam_api.h"
 #include "hif_main.h"
+#include "wlan_dp_fisa_rx.h"
 
 #ifdef FEATURE_BUS_BANDWIDTH_MGR
 /*
@@ -1475,16 +1476,22 @@ bool dp_sap_p2p_update_mid_high_tput(struct wlan_dp_psoc_context *dp_ctx,
  * @dp_ctx: handle to DP context
  * @tx_packets: transmit packet count received in BW interval
  * @rx_packets: receive packet count received in BW interval
+ * @tx_vote_pkts: transmit packet count to base the votes on
+ * @rx_vote_pkts: receive packet count to base the votes on
  * @diff_us: delta time since last invocation.
  *
  * The function controls the bus bandwidth and dynamic control of
- * tcp delayed ack configuration.
+ * tcp delayed ack configuration. The bus, tx and rx levels are decided on
+ * @tx_vote_pkts and @rx_vote_pkts, which may carry a forecast of the next
+ * interval, while the logs and the txrx history keep the measured counts.
  *
  * Returns: None
  */
 static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 					 const uint64_t tx_packets,
 					 const uint64_t rx_packets,
+					 const uint64_t tx_vote_pkts,
+					 const uint64_t rx_vote_pkts,
 					 const uint64_t diff_us)
 {
 	uint16_t index;
@@ -1492,7 +1499,7 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 	bool rx_level_change;
 	bool tx_level_change;
 	bool dptrace_high_tput_req;
-	u64 total_pkts = tx_packets + rx_packets;
+	u64 total_pkts = tx_vote_pkts + rx_vote_pkts;
 	enum pld_bus_width_type next_vote_level = PLD_BUS_WIDTH_IDLE;
 	static enum wlan_tp_level next_rx_level = WLAN_SVC_TP_NONE;
 	enum wlan_tp_level next_tx_level = WLAN_SVC_TP_NONE;
@@ -1601,9 +1608,9 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 
 		if (dp_ctx->dp_cfg.rx_thread_ul_affinity_mask) {
 			if (next_vote_level == PLD_BUS_WIDTH_HIGH &&
-			    tx_packets >
+			    tx_vote_pkts >
 			    dp_ctx->dp_cfg.bus_bw_high_threshold &&
-			    rx_packets >
+			    rx_vote_pkts >
 			    dp_ctx->dp_cfg.bus_bw_low_threshold)
 				cds_sched_handle_rx_thread_affinity_req(true);
 			else if (next_vote_level != PLD_BUS_WIDTH_HIGH)
@@ -1611,10 +1618,10 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 		}
 
 		dp_ops->dp_napi_apply_throughput_policy(ctx,
-							tx_packets,
-							rx_packets);
+							tx_vote_pkts,
+							rx_vote_pkts);
 
-		if (rx_packets < dp_ctx->dp_cfg.bus_bw_low_threshold)
+		if (rx_vote_pkts < dp_ctx->dp_cfg.bus_bw_low_threshold)
 			dp_disable_rx_ol_for_low_tput(dp_ctx, true);
 		else
 			dp_disable_rx_ol_for_low_tput(dp_ctx, false);
@@ -1634,14 +1641,14 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 	qdf_dp_trace_apply_tput_policy(dptrace_high_tput_req);
 
 	rx_level_change = dp_bus_bandwidth_work_tune_rx(dp_ctx,
-							rx_packets,
+							rx_vote_pkts,
 							diff_us,
 							&next_rx_level,
 							&pm_qos_cpu_mask_rx,
 							&is_rx_pm_qos_high);
 
 	tx_level_change = dp_bus_bandwidth_work_tune_tx(dp_ctx,
-							tx_packets,
+							tx_vote_pkts,
 							diff_us,
 							&next_tx_level,
 							&pm_qos_cpu_mask_tx,
@@ -1656,7 +1663,7 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 			is_tx_pm_qos_high = false;
 			qdf_cpumask_clear(&pm_qos_cpu_mask);
 			if (next_vote_level == PLD_BUS_WIDTH_LOW &&
-			    rx_packets > tx_packets &&
+			    rx_vote_pkts > tx_vote_pkts &&
 			    !legacy_client) {
 				pmqos_on_low_tput = true;
 				dp_pm_qos_update_cpu_mask(&pm_qos_cpu_mask,
@@ -1869,6 +1876,100 @@ dp_link_monitoring(struct wlan_dp_psoc_context *dp_ctx,
 	qdf_mem_free(peer_stats);
 }
 
+#ifdef WLAN_DP_BUS_BW_PREDICT
+/*
+ * Smoothing factors of the level and trend, as 1/2^shift. The level follows
+ * the last interval as is, the trend is the average of the interval to
+ * interval change with a weight of 1/2 on the newest one. A step from idle to
+ * N packets forecasts 3N/2 on its first interval and N + N/2^k after k steady
+ * intervals, a ramp of +d packets per interval forecasts the next point.
+ */
+#define DP_BUS_BW_PREDICT_LEVEL_SHIFT	0
+#define DP_BUS_BW_PREDICT_TREND_SHIFT	1
+/* Forecast is capped to this multiple of the packets of the last interval */
+#define DP_BUS_BW_PREDICT_MAX_GAIN	4
+
+/**
+ * dp_bus_bw_predict() - Forecast the packets of the next bus bw interval
+ * @pred: predictor state
+ * @pkts: packets of the last interval
+ *
+ * The votes are taken from the larger of the last interval packets and the
+ * forecast, so a ramp gets its bus level, PM QoS and rx thread affinity one
+ * interval early. The forecast never lowers a vote and is capped relative to
+ * the last interval, so an idle interval drops the boost right away.
+ *
+ * Return: packet count to base the votes on
+ */
+static uint64_t dp_bus_bw_predict(struct dp_bus_bw_predictor *pred,
+				  uint64_t pkts)
+{
+	int64_t prev_level = pred->level;
+	int64_t forecast;
+
+	pred->level = prev_level + pred->trend +
+		((int64_t)pkts - prev_level - pred->trend) /
+		(1 << DP_BUS_BW_PREDICT_LEVEL_SHIFT);
+	pred->trend += (pred->level - prev_level - pred->trend) /
+		(1 << DP_BUS_BW_PREDICT_TREND_SHIFT);
+
+	forecast = pred->level + pred->trend;
+	if (forecast <= (int64_t)pkts)
+		return pkts;
+
+	return qdf_min((uint64_t)forecast, pkts * DP_BUS_BW_PREDICT_MAX_GAIN);
+}
+
+/**
+ * dp_bus_bw_predict_reset() - Reset the bus bw forecast
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+static void dp_bus_bw_predict_reset(struct wlan_dp_psoc_context *dp_ctx)
+{
+	qdf_mem_zero(&dp_ctx->tx_predict, sizeof(dp_ctx->tx_predict));
+	qdf_mem_zero(&dp_ctx->rx_predict, sizeof(dp_ctx->rx_predict));
+}
+
+/**
+ * dp_bus_bw_predict_txrx() - Forecast tx and rx packets of the next interval
+ * @dp_ctx: DP context
+ * @tx_packets: tx packets of the last interval
+ * @rx_packets: rx packets of the last interval
+ * @tx_vote_pkts: tx packet count to base the votes on, to be filled
+ * @rx_vote_pkts: rx packet count to base the votes on, to be filled
+ *
+ * Return: None
+ */
+static void dp_bus_bw_predict_txrx(struct wlan_dp_psoc_context *dp_ctx,
+				   uint64_t tx_packets, uint64_t rx_packets,
+				   uint64_t *tx_vote_pkts,
+				   uint64_t *rx_vote_pkts)
+{
+	*tx_vote_pkts = dp_bus_bw_predict(&dp_ctx->tx_predict, tx_packets);
+	*rx_vote_pkts = dp_bus_bw_predict(&dp_ctx->rx_predict, rx_packets);
+
+	if (*tx_vote_pkts != tx_packets || *rx_vote_pkts != rx_packets)
+		dp_debug("tx:%llu->%llu rx:%llu->%llu", tx_packets,
+			 *tx_vote_pkts, rx_packets, *rx_vote_pkts);
+}
+#else
+static inline void
+dp_bus_bw_predict_reset(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void
+dp_bus_bw_predict_txrx(struct wlan_dp_psoc_context *dp_ctx,
+		       uint64_t tx_packets, uint64_t rx_packets,
+		       uint64_t *tx_vote_pkts, uint64_t *rx_vote_pkts)
+{
+	*tx_vote_pkts = tx_packets;
+	*rx_vote_pkts = rx_packets;
+}
+#endif
+
 /**
  * __dp_bus_bw_work_handler() - Bus bandwidth work handler
  * @dp_ctx: handle to DP context
@@ -1885,6 +1986,7 @@ static void __dp_bus_bw_work_handler(struct wlan_dp_psoc_context *dp_ctx)
 	struct wlan_dp_link *dp_link = NULL;
 	struct wlan_dp_link *dp_link_next;
 	uint64_t tx_packets = 0, rx_packets = 0, tx_bytes = 0;
+	uint64_t tx_vote_pkts, rx_vote_pkts;
 	uint64_t fwd_tx_packets = 0, fwd_rx_packets = 0;
 	uint64_t fwd_tx_packets_temp = 0, fwd_rx_packets_temp = 0;
 	uint64_t fwd_tx_packets_diff = 0, fwd_rx_packets_diff = 0;
@@ -1917,6 +2019,8 @@ static void __dp_bus_bw_work_handler(struct wlan_dp_psoc_context *dp_ctx)
 		if (!vdev)
 			continue;
 
+		dp_tx_batch_flush_stale(dp_intf);
+
 		if ((dp_intf->device_mode == QDF_STA_MODE ||
 		     dp_intf->device_mode == QDF_P2P_CLIENT_MODE) &&
 		    !wlan_cm_is_vdev_active(vdev)) {
@@ -2047,7 +2151,13 @@ static void __dp_bus_bw_work_handler(struct wlan_dp_psoc_context *dp_ctx)
 	rx_packets = rx_packets * bw_interval_us;
 	rx_packets = qdf_do_div(rx_packets, (uint32_t)diff_us);
 
-	dp_pld_request_bus_bandwidth(dp_ctx, tx_packets, rx_packets, diff_us);
+	dp_bus_bw_predict_txrx(dp_ctx, tx_packets, rx_packets,
+			       &tx_vote_pkts, &rx_vote_pkts);
+
+	dp_pld_request_bus_bandwidth(dp_ctx, tx_packets, rx_packets,
+				     tx_vote_pkts, rx_vote_pkts, diff_us);
+
+	dp_rx_fisa_steer_flows(dp_ctx, diff_us);
 
 	return;
 
@@ -2216,6 +2326,7 @@ static void __dp_bus_bw_compute_timer_stop(struct wlan_objmgr_psoc *psoc)
 		goto exit;
 
 	ucfg_ipa_set_perf_level(dp_ctx->pdev, 0, 0);
+	dp_bus_bw_predict_reset(dp_ctx);
 
 	dp_reset_tcp_delack(psoc);
 
@@ -2240,7 +2351,7 @@ exit:
 		uint64_t interval_us =
 			dp_ctx->dp_cfg.bus_bw_compute_interval * 1000;
 		qdf_atomic_set(&dp_ctx->num_latency_critical_clients, 0);
-		dp_pld_request_bus_bandwidth(dp_ctx, 0, 0, interval_us);
+		dp_pld_request_bus_bandwidth(dp_ctx, 0, 0, 0, 0, interval_us);
 	}
 	param.policy = BBM_TPUT_POLICY;
 	param.policy_info.tput_level = TPUT_LEVEL_NONE;
@@ -1350,6 +1350,154 @@ int get_transport_header_offset(struct dp_fisa_rx_sw_ft *fisa_flow,
 	return (l3_hdr_offset + l4_hdr_offset);
 }
 
+#ifdef WLAN_DP_FISA_FRAG_AGGR
+/**
+ * dp_rx_fisa_frag_aggr() - Merge the payload of nbuf into the head skb frags
+ * @fisa_flow: Handle to SW flow entry, which holds the aggregated nbuf
+ * @nbuf: Incoming nbuf, pulled to the UDP payload
+ *
+ * The head skb of the flow grows page fragments instead of a frag_list,
+ * so the stack sees one skb with a flat frags array. Only rx buffers with
+ * a page frag head, e.g. from the rx page pool, can be merged without a
+ * copy; kmalloced rx buffers are left to frag_list chaining. The merge is
+ * also not possible once the head skb has a frag_list or all frag slots
+ * are used, in that case the caller falls back to frag_list chaining.
+ *
+ * Return: true if nbuf was merged and freed, false otherwise
+ */
+static bool dp_rx_fisa_frag_aggr(struct dp_fisa_rx_sw_ft *fisa_flow,
+				 qdf_nbuf_t nbuf)
+{
+	uint32_t len = qdf_nbuf_len(nbuf);
+	bool head_stolen;
+	int delta;
+
+	if (!qdf_nbuf_is_head_frag(nbuf))
+		return false;
+
+	if (!qdf_nbuf_try_coalesce(fisa_flow->head_skb, nbuf,
+				   &head_stolen, &delta))
+		return false;
+
+	qdf_nbuf_free_partial(nbuf, head_stolen);
+	fisa_flow->frag_aggr_len += len;
+	fisa_flow->frag_aggr_count++;
+
+	return true;
+}
+
+/**
+ * dp_rx_fisa_frag_aggr_init() - Reset frag aggregation state for a new head
+ * @fisa_flow: Handle to SW flow entry
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_fisa_frag_aggr_init(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	fisa_flow->frag_aggr_len = 0;
+}
+
+/**
+ * dp_rx_fisa_frag_aggr_len() - Bytes merged into the head skb of the flow
+ * @fisa_flow: Handle to SW flow entry
+ *
+ * Return: number of payload bytes already accounted in head skb len
+ */
+static inline uint16_t
+dp_rx_fisa_frag_aggr_len(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	return fisa_flow->frag_aggr_len;
+}
+
+/**
+ * dp_rx_fisa_update_aggr_limit() - Update per flow aggregation limit
+ * @fisa_flow: Handle to SW flow entry
+ *
+ * Track a moving average of the packet inter-arrival time of the flow.
+ * A flow receiving back to back bursts is allowed to build aggregates up
+ * to FISA_FLOW_MAX_AGGR_COUNT, while a sparse flow is flushed early to
+ * avoid holding its packets in the aggregate.
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_update_aggr_limit(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	uint64_t now = qdf_sched_clock();
+	uint64_t gap;
+	uint32_t avg;
+
+	if (qdf_unlikely(!fisa_flow->aggr_limit)) {
+		fisa_flow->aggr_limit = FISA_FLOW_MAX_AGGR_COUNT;
+		fisa_flow->avg_rx_gap_ns = 0;
+		fisa_flow->last_rx_ts = now;
+		return;
+	}
+
+	gap = now - fisa_flow->last_rx_ts;
+	fisa_flow->last_rx_ts = now;
+	if (gap > FISA_AGGR_GAP_MAX_NS)
+		gap = FISA_AGGR_GAP_MAX_NS;
+
+	avg = fisa_flow->avg_rx_gap_ns;
+	avg = avg - (avg >> FISA_AGGR_GAP_EWMA_SHIFT) +
+	      ((uint32_t)gap >> FISA_AGGR_GAP_EWMA_SHIFT);
+	fisa_flow->avg_rx_gap_ns = avg;
+
+	if (avg < FISA_AGGR_GAP_LOW_NS)
+		fisa_flow->aggr_limit = QDF_MIN(fisa_flow->aggr_limit << 1,
+						FISA_FLOW_MAX_AGGR_COUNT);
+	else if (avg > FISA_AGGR_GAP_HIGH_NS)
+		fisa_flow->aggr_limit = QDF_MAX(fisa_flow->aggr_limit >> 1,
+						FISA_AGGR_LIMIT_MIN);
+}
+
+/**
+ * dp_rx_fisa_aggr_limit_reached() - Check the flow aggregate against limit
+ * @fisa_flow: Handle to SW flow entry
+ *
+ * Return: true if the aggregate should be flushed
+ */
+static inline bool
+dp_rx_fisa_aggr_limit_reached(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	/* cur_aggr does not include the head_skb */
+	if (fisa_flow->cur_aggr + 1 < fisa_flow->aggr_limit)
+		return false;
+
+	fisa_flow->aggr_limit_flush_count++;
+	return true;
+}
+#else
+static inline bool dp_rx_fisa_frag_aggr(struct dp_fisa_rx_sw_ft *fisa_flow,
+					qdf_nbuf_t nbuf)
+{
+	return false;
+}
+
+static inline void
+dp_rx_fisa_frag_aggr_init(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+}
+
+static inline uint16_t
+dp_rx_fisa_frag_aggr_len(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	return 0;
+}
+
+static inline void
+dp_rx_fisa_update_aggr_limit(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+}
+
+static inline bool
+dp_rx_fisa_aggr_limit_reached(struct dp_fisa_rx_sw_ft *fisa_flow)
+{
+	return false;
+}
+#endif
+
 /**
  * dp_rx_fisa_aggr_udp() - Aggregate incoming to UDP nbuf
  * @fisa_hdl: Handle fisa context
@@ -1410,6 +1558,7 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 		fisa_flow->head_skb_l4_hdr_offset = l4_hdr_offset;
 
 		fisa_flow->frags_cumulative_len = 0;
+		dp_rx_fisa_frag_aggr_init(fisa_flow);
 
 		return FISA_AGGR_DONE;
 	}
@@ -1427,6 +1576,12 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 	fisa_flow->frags_cumulative_len += (udp_len -
 						sizeof(qdf_net_udphdr_t));
 
+	if (dp_rx_fisa_frag_aggr(fisa_flow, nbuf)) {
+		/* nbuf payload now lives in the head skb page frags */
+		fisa_flow->aggr_count++;
+		goto check_flush;
+	}
+
 	if (qdf_nbuf_get_ext_list(head_skb)) {
 		/*
 		 * This is 3rd skb for flow.
@@ -1449,6 +1604,7 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 	fisa_flow->last_skb = nbuf;
 	fisa_flow->aggr_count++;
 
+check_flush:
 	dp_fisa_debug("Stiched head skb fisa_flow %pK", fisa_flow);
 	hex_dump_skb_data(fisa_flow->head_skb, false);
 
@@ -1458,6 +1614,8 @@ dp_rx_fisa_aggr_udp(struct dp_rx_fst *fisa_hdl,
 	 */
 	if (udp_len < qdf_ntohs(fisa_flow->head_skb_udp_hdr->udp_len))
 		dp_rx_fisa_flush_flow_wrap(fisa_flow);
+	else if (dp_rx_fisa_aggr_limit_reached(fisa_flow))
+		dp_rx_fisa_flush_flow_wrap(fisa_flow);
 
 	return FISA_AGGR_DONE;
 }
@@ -1604,6 +1762,9 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 	qdf_nbuf_t linear_skb;
 	struct dp_vdev *fisa_flow_vdev;
 	ol_txrx_soc_handle cdp_soc = fisa_flow->dp_ctx->cdp_soc;
+	uint16_t frag_aggr_len = dp_rx_fisa_frag_aggr_len(fisa_flow);
+	uint32_t aggr_len = 0;
+	uint32_t ext_len;
 
 	dp_fisa_debug("head_skb %pK", head_skb);
 	dp_fisa_debug("cumulative ip length %d",
@@ -1615,7 +1776,7 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 
 	qdf_nbuf_set_hash(head_skb, QDF_NBUF_CB_RX_FLOW_ID(head_skb));
 	head_skb->sw_hash = 1;
-	if (qdf_nbuf_get_ext_list(head_skb)) {
+	if (qdf_nbuf_get_ext_list(head_skb) || frag_aggr_len) {
 		__sum16 pseudo;
 
 		shinfo = qdf_nbuf_get_shinfo(head_skb);
@@ -1632,15 +1793,19 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 
 		dp_fisa_debug("ip_len 0x%x", qdf_ntohs(head_skb_iph->ip_len));
 
-		/* data_len is total length of non head_skb,
+		/* aggr_len is total length of non head_skb,
 		 * cumulative ip length is including head_skb ip length also
 		 */
+		aggr_len = fisa_flow->adjusted_cumulative_ip_length -
+			   qdf_ntohs(head_skb_udp_hdr->udp_len);
+
+		/* Bytes merged into head_skb frags are already in len */
+		ext_len = aggr_len - frag_aggr_len;
 		qdf_nbuf_set_data_len(head_skb,
-			      ((fisa_flow->adjusted_cumulative_ip_length) -
-				      qdf_ntohs(head_skb_udp_hdr->udp_len)));
+				      qdf_nbuf_get_only_data_len(head_skb) +
+				      ext_len);
 
-		qdf_nbuf_set_len(head_skb, (qdf_nbuf_len(head_skb) +
-				 qdf_nbuf_get_only_data_len(head_skb)));
+		qdf_nbuf_set_len(head_skb, qdf_nbuf_len(head_skb) + ext_len);
 
 		head_skb_iph->ip_len =
 			qdf_htons((fisa_flow->adjusted_cumulative_ip_length)
@@ -1694,11 +1859,10 @@ dp_rx_fisa_flush_udp_flow(struct dp_vdev *vdev,
 		qdf_nbuf_free(fisa_flow->head_skb);
 	} else {
 		/*
-		 * Sanity check head data_len should be equal to sum of
+		 * Sanity check aggregated length should be equal to sum of
 		 * all fragments length
 		 */
-		if (qdf_unlikely(fisa_flow->frags_cumulative_len !=
-				 qdf_nbuf_get_only_data_len(fisa_flow->head_skb))) {
+		if (qdf_unlikely(fisa_flow->frags_cumulative_len != aggr_len)) {
 			qdf_assert(0);
 			/* Drop the aggregate */
 			qdf_nbuf_free(fisa_flow->head_skb);
@@ -1848,6 +2012,31 @@ static bool dp_fisa_aggregation_should_stop(
 	return false;
 }
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * dp_rx_fisa_steer_account() - Account nbuf for rx thread flow steering
+ * @fisa_hdl: handle to fisa context
+ * @fisa_flow: Handle SW flow entry
+ * @nbuf: Incoming nbuf, still holding the RX packet TLVs
+ *
+ * Return: None
+ */
+static inline void dp_rx_fisa_steer_account(struct dp_rx_fst *fisa_hdl,
+					    struct dp_fisa_rx_sw_ft *fisa_flow,
+					    qdf_nbuf_t nbuf)
+{
+	fisa_flow->steer_bytes += qdf_nbuf_len(nbuf) -
+				  fisa_hdl->rx_pkt_tlv_size;
+	fisa_flow->steer_hash = QDF_NBUF_CB_RX_FLOW_ID(nbuf);
+}
+#else
+static inline void dp_rx_fisa_steer_account(struct dp_rx_fst *fisa_hdl,
+					    struct dp_fisa_rx_sw_ft *fisa_flow,
+					    qdf_nbuf_t nbuf)
+{
+}
+#endif
+
 /**
  * dp_add_nbuf_to_fisa_flow() - Aggregate incoming nbuf
  * @fisa_hdl: handle to fisa context
@@ -2017,7 +2206,10 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 	dp_fisa_record_pkt(fisa_flow, nbuf, rx_tlv_hdr,
 			   fisa_hdl->rx_pkt_tlv_size);
 
+	dp_rx_fisa_steer_account(fisa_hdl, fisa_flow, nbuf);
+
 	if (fisa_flow->is_flow_udp) {
+		dp_rx_fisa_update_aggr_limit(fisa_flow);
 		dp_rx_fisa_aggr_udp(fisa_hdl, fisa_flow, nbuf);
 	} else if (fisa_flow->is_flow_tcp) {
 		qdf_assert(0);
@@ -2338,3 +2530,145 @@ void dp_set_fisa_dynamic_aggr_size_support(bool dynamic_aggr_size_support)
 
 	dp_ctx->fisa_dynamic_aggr_size_support = dynamic_aggr_size_support;
 }
+
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * struct dp_rx_fisa_steer_cand - elephant flow candidate for steering
+ * @flow: SW flow entry
+ * @bytes: bytes received on the flow in the last interval
+ */
+struct dp_rx_fisa_steer_cand {
+	struct dp_fisa_rx_sw_ft *flow;
+	uint64_t bytes;
+};
+
+/**
+ * dp_rx_fisa_steer_add_cand() - Insert a flow into the sorted candidates
+ * @cand: candidate array, sorted by bytes in descending order
+ * @num_cand: number of valid entries in @cand
+ * @flow: SW flow entry
+ * @bytes: bytes received on @flow in the last interval
+ *
+ * Once the array is full the smallest candidate is dropped.
+ *
+ * Return: new number of valid entries in @cand
+ */
+static uint8_t
+dp_rx_fisa_steer_add_cand(struct dp_rx_fisa_steer_cand *cand,
+			  uint8_t num_cand, struct dp_fisa_rx_sw_ft *flow,
+			  uint64_t bytes)
+{
+	uint8_t i = num_cand;
+
+	if (num_cand == DP_RX_FISA_STEER_MAX_FLOWS) {
+		if (bytes <= cand[num_cand - 1].bytes)
+			return num_cand;
+		i--;
+	} else {
+		num_cand++;
+	}
+
+	for (; i > 0 && cand[i - 1].bytes < bytes; i--)
+		cand[i] = cand[i - 1];
+
+	cand[i].flow = flow;
+	cand[i].bytes = bytes;
+
+	return num_cand;
+}
+
+void dp_rx_fisa_steer_flows(struct wlan_dp_psoc_context *dp_ctx,
+			    uint64_t interval_us)
+{
+	struct dp_rx_fst *fisa_hdl = dp_ctx->rx_fst;
+	struct dp_rx_fisa_steer_cand cand[DP_RX_FISA_STEER_MAX_FLOWS];
+	uint8_t steer_tbl[DP_RX_TM_FLOW_STEER_TBL_SIZE] = {0};
+	uint64_t load[DP_MAX_RX_THREADS] = {0};
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	uint64_t elephant_bytes, bytes;
+	uint8_t num_threads, num_cand = 0;
+	uint8_t cur, target, i, t;
+	int ft_idx;
+
+	if (!fisa_hdl || !dp_ctx->enable_dp_rx_threads || !interval_us)
+		return;
+
+	num_threads = cdp_get_num_rx_contexts(dp_ctx->cdp_soc);
+	if (num_threads < 2 || num_threads > DP_MAX_RX_THREADS)
+		return;
+
+	/* 1 Mbps is 1 bit per us */
+	elephant_bytes = (DP_RX_FISA_ELEPHANT_MBPS * interval_us) >> 3;
+
+	sw_ft_entry = (struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	for (ft_idx = 0; ft_idx < fisa_hdl->max_entries;
+	     ft_idx++, sw_ft_entry++) {
+		if (!sw_ft_entry->is_populated)
+			continue;
+
+		/* entry may have been re-used for a new flow meanwhile */
+		if (qdf_unlikely(sw_ft_entry->steer_bytes <
+				 sw_ft_entry->steer_last_bytes))
+			sw_ft_entry->steer_last_bytes = 0;
+
+		bytes = sw_ft_entry->steer_bytes -
+			sw_ft_entry->steer_last_bytes;
+		sw_ft_entry->steer_last_bytes = sw_ft_entry->steer_bytes;
+
+		/* a steered flow stays an elephant down to half the rate */
+		if (bytes >= elephant_bytes ||
+		    (sw_ft_entry->steer_thread &&
+		     bytes >= (elephant_bytes >> 1))) {
+			num_cand = dp_rx_fisa_steer_add_cand(cand, num_cand,
+							     sw_ft_entry,
+							     bytes);
+			continue;
+		}
+
+		sw_ft_entry->steer_thread = DP_RX_TM_FLOW_STEER_NONE;
+	}
+
+	/*
+	 * Largest flows first, each one to the least loaded thread. A flow
+	 * stays on its current thread unless moving it takes off at least
+	 * half of its own load from the imbalance, to avoid flows bouncing
+	 * between threads and getting reordered on every rebalance.
+	 */
+	for (i = 0; i < num_cand; i++) {
+		target = 0;
+		for (t = 1; t < num_threads; t++) {
+			if (load[t] < load[target])
+				target = t;
+		}
+
+		if (cand[i].flow->steer_thread)
+			cur = cand[i].flow->steer_thread - 1;
+		else
+			cur = cand[i].flow->napi_id % num_threads;
+
+		if (cur < num_threads &&
+		    load[cur] <= load[target] + (cand[i].bytes >> 1))
+			target = cur;
+		else
+			fisa_hdl->stats.flow_steer_moves++;
+
+		load[target] += cand[i].bytes;
+		cand[i].flow->steer_thread = target + 1;
+		steer_tbl[cand[i].flow->steer_hash &
+			  DP_RX_TM_FLOW_STEER_TBL_MASK] = target + 1;
+	}
+
+	/* Drop steering of flows which fell out of the candidate list */
+	sw_ft_entry = (struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	for (ft_idx = 0; ft_idx < fisa_hdl->max_entries;
+	     ft_idx++, sw_ft_entry++) {
+		if (sw_ft_entry->steer_thread &&
+		    steer_tbl[sw_ft_entry->steer_hash &
+			      DP_RX_TM_FLOW_STEER_TBL_MASK] !=
+		    sw_ft_entry->steer_thread)
+			sw_ft_entry->steer_thread = DP_RX_TM_FLOW_STEER_NONE;
+	}
+
+	dp_rx_update_flow_steering(dp_ctx->cdp_soc, steer_tbl);
+}
+#endif
@@ -69,6 +69,28 @@
 
 #define FISA_FT_ENTRY_AGING_US	1000000
 
+#ifdef WLAN_DP_FISA_FRAG_AGGR
+/*
+ * Per flow aggregation limit is derived from the packet inter-arrival time.
+ * Back to back packets of a burst grow the limit up to
+ * FISA_FLOW_MAX_AGGR_COUNT, sparse packets shrink it down to
+ * FISA_AGGR_LIMIT_MIN so that they are not held back for aggregation.
+ */
+#define FISA_AGGR_LIMIT_MIN		2
+#define FISA_AGGR_GAP_EWMA_SHIFT	3
+#define FISA_AGGR_GAP_LOW_NS		50000
+#define FISA_AGGR_GAP_HIGH_NS		500000
+/* cap the gap sample so that one idle period does not skew the average */
+#define FISA_AGGR_GAP_MAX_NS		(4 * FISA_AGGR_GAP_HIGH_NS)
+#endif
+
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/* Rate above which a flow gets an rx thread of its own */
+#define DP_RX_FISA_ELEPHANT_MBPS	200
+/* Max number of elephant flows steered at a time */
+#define DP_RX_FISA_STEER_MAX_FLOWS	8
+#endif
+
 struct dp_fisa_rx_fst_update_elem {
 	/* Do not add new entries here */
 	qdf_list_node_t node;
@@ -232,6 +254,29 @@ void dp_set_fst_in_cmem(bool fst_in_cmem);
  * Return: None
  */
 void dp_set_fisa_dynamic_aggr_size_support(bool dynamic_aggr_size_support);
+
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * dp_rx_fisa_steer_flows() - Rebalance elephant flows across rx threads
+ * @dp_ctx: DP component handle
+ * @interval_us: time since the previous call
+ *
+ * Flows of the FISA SW flow table carrying more than
+ * DP_RX_FISA_ELEPHANT_MBPS in the last interval are spread over the rx
+ * threads, largest first, to the least loaded thread. All other flows
+ * follow the REO ring to rx thread mapping.
+ *
+ * Return: None
+ */
+void dp_rx_fisa_steer_flows(struct wlan_dp_psoc_context *dp_ctx,
+			    uint64_t interval_us);
+#else
+static inline void
+dp_rx_fisa_steer_flows(struct wlan_dp_psoc_context *dp_ctx,
+		       uint64_t interval_us)
+{
+}
+#endif
 #else
 static inline void
 dp_rx_fst_update_pm_suspend_status(struct wlan_dp_psoc_context *dp_ctx,
@@ -256,5 +301,11 @@ static inline void
 dp_set_fisa_dynamic_aggr_size_support(bool dynamic_aggr_size_support)
 {
 }
+
+static inline void
+dp_rx_fisa_steer_flows(struct wlan_dp_psoc_context *dp_ctx,
+		       uint64_t interval_us)
+{
+}
 #endif
 #endif
@@ -1347,6 +1347,9 @@ dp_vdev_obj_destroy_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 		dp_intf->def_link =
 			dp_intf_get_next_deflink_candidate(dp_intf, dp_link);
 
+	/* Frames held for a burst must not outlive the link */
+	dp_tx_batch_purge(dp_intf);
+
 	/*
 	 * Change this to link level, since during link switch,
 	 * it might not go to 0
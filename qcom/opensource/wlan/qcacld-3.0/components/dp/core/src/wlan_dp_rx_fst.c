@@ -92,6 +92,7 @@ static void dp_print_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 		fst->stats.reo_mismatch.allow_fse_metdata_mismatch);
 	dp_info("reo_mismatch: allow_non_aggr: %u",
 		fst->stats.reo_mismatch.allow_non_aggr);
+	dp_info("flow steer moves: %u", fst->stats.flow_steer_moves);
 }
 
 /* Length of string to store tuple information for printing */
@@ -124,6 +125,30 @@ void print_flow_tuple(struct cdp_rx_flow_tuple_info *flow_tuple, char *str,
 		      flow_tuple->l4_protocol);
 }
 
+#ifdef WLAN_DP_FISA_FRAG_AGGR
+/**
+ * dp_rx_dump_fisa_frag_aggr_stats() - Dump frag aggregation stats of a flow
+ * @sw_ft_entry: SW flow entry
+ *
+ * Return: None
+ */
+static void
+dp_rx_dump_fisa_frag_aggr_stats(struct dp_fisa_rx_sw_ft *sw_ft_entry)
+{
+	dp_info("Flow[%d] frag-aggr %u aggr-limit %u limit-flushes %u avg-gap-ns %u",
+		sw_ft_entry->flow_id,
+		sw_ft_entry->frag_aggr_count,
+		sw_ft_entry->aggr_limit,
+		sw_ft_entry->aggr_limit_flush_count,
+		sw_ft_entry->avg_rx_gap_ns);
+}
+#else
+static inline void
+dp_rx_dump_fisa_frag_aggr_stats(struct dp_fisa_rx_sw_ft *sw_ft_entry)
+{
+}
+#endif
+
 static QDF_STATUS dp_rx_dump_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 {
 	char tuple_str[DP_TUPLE_STR_LEN] = {'\0'};
@@ -157,6 +182,7 @@ static QDF_STATUS dp_rx_dump_fisa_stats(struct wlan_dp_psoc_context *dp_ctx)
 			qdf_do_div(sw_ft_entry->bytes_aggregated,
 				   sw_ft_entry->flush_count),
 			sw_ft_entry->same_mld_vdev_mismatch);
+		dp_rx_dump_fisa_frag_aggr_stats(sw_ft_entry);
 	}
 	return QDF_STATUS_SUCCESS;
 }
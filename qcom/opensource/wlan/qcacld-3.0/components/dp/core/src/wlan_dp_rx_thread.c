@@ -160,7 +160,7 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 	if (!total_queued)
 		return;
 
-	dp_info("thread:%u - qlen:%u queued:(total:%u %s) dequeued:%u stack:%u gro_flushes: %u gro_flushes_by_vdev_del: %u rx_flushes: %u max_len:%u invalid(peer:%u vdev:%u rx-handle:%u others:%u enq fail:%u)",
+	dp_info("thread:%u - qlen:%u queued:(total:%u %s) dequeued:%u stack:%u gro_flushes: %u gro_flushes_by_vdev_del: %u rx_flushes: %u max_len:%u steered:%u invalid(peer:%u vdev:%u rx-handle:%u others:%u enq fail:%u)",
 		rx_thread->id,
 		qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue),
 		total_queued,
@@ -171,6 +171,7 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 		rx_thread->stats.gro_flushes_by_vdev_del,
 		rx_thread->stats.rx_flushed,
 		rx_thread->stats.nbufq_max_len,
+		rx_thread->stats.nbuf_steered,
 		rx_thread->stats.dropped_invalid_peer,
 		rx_thread->stats.dropped_invalid_vdev,
 		rx_thread->stats.dropped_invalid_os_rx_handles,
@@ -1408,6 +1409,111 @@ static uint8_t dp_rx_tm_select_thread(struct dp_rx_tm_handle *rx_tm_hdl,
 	return selected_rx_thread;
 }
 
+#ifdef WLAN_DP_RX_FLOW_STEERING
+/**
+ * dp_rx_tm_steer_thread() - steer a nbuf to the rx thread owning its flow
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ * infrastructure
+ * @nbuf_list: nbuf list to be enqueued
+ * @thread_id: rx thread selected from the REO ring
+ *
+ * Flows placed on a thread by the flow steering table are moved off the
+ * thread of their REO ring. Only single nbufs are steered, nbuf lists hold
+ * packets of several flows. The RX context id of a steered nbuf is
+ * rewritten to the target thread so that GRO uses the NAPI of the thread
+ * which delivers it. The source thread remembers the target, so that
+ * the next GRO flush indication for the REO ring reaches it as well.
+ *
+ * Return: rx thread ID to enqueue the nbuf list to
+ */
+static uint8_t dp_rx_tm_steer_thread(struct dp_rx_tm_handle *rx_tm_hdl,
+				     qdf_nbuf_t nbuf_list, uint8_t thread_id)
+{
+	struct dp_rx_thread *rx_thread = rx_tm_hdl->rx_thread[thread_id];
+	uint8_t steer;
+
+	if (QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list) > 1)
+		return thread_id;
+
+	steer = rx_tm_hdl->flow_steer_tbl[QDF_NBUF_CB_RX_FLOW_ID(nbuf_list) &
+					  DP_RX_TM_FLOW_STEER_TBL_MASK];
+	if (steer == DP_RX_TM_FLOW_STEER_NONE)
+		return thread_id;
+
+	steer--;
+	if (steer == thread_id || steer >= rx_tm_hdl->num_dp_rx_threads)
+		return thread_id;
+
+	QDF_NBUF_CB_RX_CTX_ID(nbuf_list) = steer;
+	if (!qdf_atomic_test_bit(steer, &rx_thread->steer_flush_pending))
+		qdf_atomic_set_bit(steer, &rx_thread->steer_flush_pending);
+	rx_thread->stats.nbuf_steered++;
+
+	return steer;
+}
+
+/**
+ * dp_rx_tm_steer_gro_flush_ind() - forward GRO flush to steered threads
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ * infrastructure
+ * @thread_id: rx thread which received the GRO flush indication
+ * @flush_code: flush code to differentiate low TPUT flush
+ *
+ * Return: None
+ */
+static void
+dp_rx_tm_steer_gro_flush_ind(struct dp_rx_tm_handle *rx_tm_hdl,
+			     uint8_t thread_id,
+			     enum dp_rx_gro_flush_code flush_code)
+{
+	struct dp_rx_thread *rx_thread = rx_tm_hdl->rx_thread[thread_id];
+	uint8_t i;
+
+	if (qdf_likely(!rx_thread->steer_flush_pending))
+		return;
+
+	for (i = 0; i < rx_tm_hdl->num_dp_rx_threads; i++) {
+		if (!qdf_atomic_test_and_clear_bit(
+					i, &rx_thread->steer_flush_pending))
+			continue;
+		dp_rx_tm_thread_gro_flush_ind(rx_tm_hdl->rx_thread[i],
+					      flush_code);
+	}
+}
+
+QDF_STATUS dp_rx_tm_update_flow_steering(struct dp_rx_tm_handle *rx_tm_hdl,
+					 const uint8_t *steer_tbl)
+{
+	int i;
+
+	for (i = 0; i < DP_RX_TM_FLOW_STEER_TBL_SIZE; i++) {
+		if (steer_tbl[i] > rx_tm_hdl->num_dp_rx_threads)
+			return QDF_STATUS_E_INVAL;
+	}
+
+	for (i = 0; i < DP_RX_TM_FLOW_STEER_TBL_SIZE; i++) {
+		if (rx_tm_hdl->flow_steer_tbl[i] != steer_tbl[i])
+			rx_tm_hdl->flow_steer_tbl[i] = steer_tbl[i];
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline uint8_t
+dp_rx_tm_steer_thread(struct dp_rx_tm_handle *rx_tm_hdl,
+		      qdf_nbuf_t nbuf_list, uint8_t thread_id)
+{
+	return thread_id;
+}
+
+static inline void
+dp_rx_tm_steer_gro_flush_ind(struct dp_rx_tm_handle *rx_tm_hdl,
+			     uint8_t thread_id,
+			     enum dp_rx_gro_flush_code flush_code)
+{
+}
+#endif
+
 QDF_STATUS dp_rx_tm_enqueue_pkt(struct dp_rx_tm_handle *rx_tm_hdl,
 				qdf_nbuf_t nbuf_list)
 {
@@ -1416,6 +1522,8 @@ QDF_STATUS dp_rx_tm_enqueue_pkt(struct dp_rx_tm_handle *rx_tm_hdl,
 	selected_thread_id =
 		dp_rx_tm_select_thread(rx_tm_hdl,
 				       QDF_NBUF_CB_RX_CTX_ID(nbuf_list));
+	selected_thread_id = dp_rx_tm_steer_thread(rx_tm_hdl, nbuf_list,
+						   selected_thread_id);
 	dp_rx_tm_thread_enqueue(rx_tm_hdl->rx_thread[selected_thread_id],
 				nbuf_list);
 	return QDF_STATUS_SUCCESS;
@@ -1430,6 +1538,8 @@ dp_rx_tm_gro_flush_ind(struct dp_rx_tm_handle *rx_tm_hdl, int rx_ctx_id,
 	selected_thread_id = dp_rx_tm_select_thread(rx_tm_hdl, rx_ctx_id);
 	dp_rx_tm_thread_gro_flush_ind(rx_tm_hdl->rx_thread[selected_thread_id],
 				      flush_code);
+	dp_rx_tm_steer_gro_flush_ind(rx_tm_hdl, selected_thread_id,
+				     flush_code);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -570,6 +570,204 @@ void wlan_dp_pkt_add_timestamp(struct wlan_dp_intf *dp_intf,
 }
 #endif
 
+/* Max frames held back for a single tx_list call */
+#define DP_TX_BATCH_MAX 32
+/* Max time frames are held back waiting for the end of a burst */
+#define DP_TX_BATCH_MAX_HOLD_MS 10
+
+/**
+ * dp_tx_batch_drop_list() - Drop frames of a tx batch
+ * @dp_intf: DP interface
+ * @nbuf: list of frames linked through qdf_nbuf_next()
+ * @cpu: CPU the frames were held on
+ *
+ * Frames are accounted the same way as a tx failure in dp_start_xmit().
+ *
+ * Return: None
+ */
+static void dp_tx_batch_drop_list(struct wlan_dp_intf *dp_intf,
+				  qdf_nbuf_t nbuf, int cpu)
+{
+	struct dp_tx_rx_stats *stats = &dp_intf->dp_stats.tx_rx_stats;
+	qdf_nbuf_t next;
+
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		qdf_net_buf_debug_release_skb(nbuf);
+		qdf_dp_trace_data_pkt(nbuf, QDF_TRACE_DEFAULT_PDEV_ID,
+				      QDF_DP_TRACE_DROP_PACKET_RECORD, 0,
+				      QDF_TX);
+		qdf_nbuf_kfree(nbuf);
+		qdf_net_stats_inc_tx_dropped(&dp_intf->stats);
+		++stats->per_cpu[cpu].tx_dropped;
+
+		nbuf = next;
+	}
+}
+
+/**
+ * __dp_tx_batch_flush() - Transmit the frames held back on a CPU
+ * @dp_intf: DP interface
+ * @soc: txrx soc handle
+ * @cpu: CPU the frames were held on
+ *
+ * The frames go out on the current default link of @dp_intf, as a frame
+ * handed to dp_start_xmit() at this point would. Frames which could not be
+ * sent are dropped. The caller holds the batch lock.
+ *
+ * Return: None
+ */
+static void __dp_tx_batch_flush(struct wlan_dp_intf *dp_intf, void *soc,
+				int cpu)
+{
+	struct dp_tx_batch *batch = &dp_intf->tx_batch[cpu];
+	ol_txrx_tx_fp tx_list = dp_intf->txrx_ops.tx.tx_list;
+	struct wlan_dp_link *dp_link = dp_intf->def_link;
+	qdf_nbuf_t nbuf;
+
+	if (!qdf_nbuf_queue_len(&batch->nbuf_q))
+		return;
+
+	nbuf = qdf_nbuf_queue_first(&batch->nbuf_q);
+	qdf_nbuf_queue_init(&batch->nbuf_q);
+
+	if (qdf_likely(tx_list && dp_link))
+		nbuf = tx_list(soc, dp_link->link_id, nbuf);
+
+	if (qdf_unlikely(nbuf)) {
+		dp_debug_rl("Failed to send packets from adapter %u",
+			    dp_link ? dp_link->link_id : WLAN_INVALID_LINK_ID);
+		dp_tx_batch_drop_list(dp_intf, nbuf, cpu);
+	}
+}
+
+/**
+ * dp_tx_batch_flush() - Transmit the frames held back on a CPU
+ * @dp_intf: DP interface
+ * @soc: txrx soc handle
+ * @cpu: CPU the frames were held on
+ *
+ * Return: None
+ */
+static void dp_tx_batch_flush(struct wlan_dp_intf *dp_intf, void *soc,
+			      int cpu)
+{
+	struct dp_tx_batch *batch = &dp_intf->tx_batch[cpu];
+
+	if (!qdf_nbuf_queue_len(&batch->nbuf_q))
+		return;
+
+	qdf_spin_lock_bh(&batch->lock);
+	__dp_tx_batch_flush(dp_intf, soc, cpu);
+	qdf_spin_unlock_bh(&batch->lock);
+}
+
+/**
+ * dp_tx_batch_add() - Hold back a frame while the OS has more frames queued
+ * @dp_intf: DP interface
+ * @soc: txrx soc handle
+ * @nbuf: frame
+ * @cpu: current CPU
+ * @more: the OS has more frames queued on the tx queue of @nbuf
+ *
+ * The OS calls the xmit handler of a tx queue back to back with BH disabled
+ * and tells whether more frames follow, so the frames of a burst are
+ * collected per CPU and handed to the txrx layer with a single TCL head
+ * pointer update when the burst ends. A burst is also cut after
+ * DP_TX_BATCH_MAX frames or DP_TX_BATCH_MAX_HOLD_MS.
+ *
+ * Return: None
+ */
+static void dp_tx_batch_add(struct wlan_dp_intf *dp_intf, void *soc,
+			    qdf_nbuf_t nbuf, int cpu, bool more)
+{
+	struct dp_tx_batch *batch = &dp_intf->tx_batch[cpu];
+
+	qdf_spin_lock_bh(&batch->lock);
+	if (!qdf_nbuf_queue_len(&batch->nbuf_q))
+		batch->hold_ts = qdf_system_ticks();
+
+	qdf_nbuf_queue_add(&batch->nbuf_q, nbuf);
+
+	if (!more || qdf_nbuf_queue_len(&batch->nbuf_q) >= DP_TX_BATCH_MAX ||
+	    qdf_system_time_after(qdf_system_ticks(), batch->hold_ts +
+			qdf_system_msecs_to_ticks(DP_TX_BATCH_MAX_HOLD_MS)))
+		__dp_tx_batch_flush(dp_intf, soc, cpu);
+	qdf_spin_unlock_bh(&batch->lock);
+}
+
+void dp_tx_batch_init(struct wlan_dp_intf *dp_intf)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < NUM_CPUS; cpu++) {
+		qdf_spinlock_create(&dp_intf->tx_batch[cpu].lock);
+		qdf_nbuf_queue_init(&dp_intf->tx_batch[cpu].nbuf_q);
+	}
+}
+
+void dp_tx_batch_deinit(struct wlan_dp_intf *dp_intf)
+{
+	int cpu;
+
+	dp_tx_batch_purge(dp_intf);
+
+	for (cpu = 0; cpu < NUM_CPUS; cpu++)
+		qdf_spinlock_destroy(&dp_intf->tx_batch[cpu].lock);
+}
+
+void dp_tx_batch_purge(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_tx_batch *batch;
+	qdf_nbuf_t nbuf;
+	int cpu;
+
+	for (cpu = 0; cpu < NUM_CPUS; cpu++) {
+		batch = &dp_intf->tx_batch[cpu];
+
+		qdf_spin_lock_bh(&batch->lock);
+		nbuf = qdf_nbuf_queue_first(&batch->nbuf_q);
+		qdf_nbuf_queue_init(&batch->nbuf_q);
+		qdf_spin_unlock_bh(&batch->lock);
+
+		dp_tx_batch_drop_list(dp_intf, nbuf, cpu);
+	}
+}
+
+void dp_tx_batch_flush_stale(struct wlan_dp_intf *dp_intf)
+{
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	qdf_time_t max_hold = qdf_system_msecs_to_ticks(DP_TX_BATCH_MAX_HOLD_MS);
+	struct dp_tx_batch *batch;
+	int cpu;
+
+	qdf_atomic_inc(&dp_intf->num_active_task);
+	for (cpu = 0; cpu < NUM_CPUS; cpu++) {
+		batch = &dp_intf->tx_batch[cpu];
+		if (!qdf_nbuf_queue_len(&batch->nbuf_q))
+			continue;
+
+		qdf_spin_lock_bh(&batch->lock);
+		if (qdf_nbuf_queue_len(&batch->nbuf_q) &&
+		    qdf_system_time_after(qdf_system_ticks(),
+					  batch->hold_ts + max_hold))
+			__dp_tx_batch_flush(dp_intf, soc, cpu);
+		qdf_spin_unlock_bh(&batch->lock);
+	}
+	qdf_atomic_dec(&dp_intf->num_active_task);
+}
+
+void dp_tx_batch_end(struct wlan_dp_intf *dp_intf)
+{
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+
+	qdf_atomic_inc(&dp_intf->num_active_task);
+	dp_tx_batch_flush(dp_intf, soc, qdf_get_smp_processor_id());
+	qdf_atomic_dec(&dp_intf->num_active_task);
+}
+
 QDF_STATUS
 dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 {
@@ -584,6 +782,7 @@ dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 	uint8_t pkt_type;
 	struct qdf_mac_addr mac_addr_tx_allowed = QDF_MAC_ADDR_ZERO_INIT;
 	int cpu = qdf_get_smp_processor_id();
+	bool more = qdf_nbuf_tx_more_pending(nbuf);
 
 	stats = &dp_intf->dp_stats.tx_rx_stats;
 	++stats->per_cpu[cpu].tx_called;
@@ -706,6 +905,20 @@ dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 
 	dp_fix_broadcast_eapol(dp_link, nbuf);
 
+	/*
+	 * Data frames of a burst go out through tx_list. Frames tracked for
+	 * connectivity stats or with special handling flush the burst and
+	 * are sent on their own, which also keeps their order.
+	 */
+	if (dp_intf->txrx_ops.tx.tx_list && !dp_intf->pkt_type_bitmap &&
+	    !is_arp && !is_eapol && !is_dhcp &&
+	    (more || qdf_nbuf_queue_len(&dp_intf->tx_batch[cpu].nbuf_q))) {
+		dp_tx_batch_add(dp_intf, soc, nbuf, cpu, more);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	dp_tx_batch_flush(dp_intf, soc, cpu);
+
 	if (dp_intf->txrx_ops.tx.tx(soc, dp_link->link_id, nbuf)) {
 		dp_debug_rl("Failed to send packet from adapter %u",
 			    dp_link->link_id);
@@ -743,6 +956,10 @@ drop_pkt_accounting:
 				tx_dropped[subtype - QDF_PROTO_DHCP_DISCOVER];
 	}
 
+	/* The burst ends with a dropped frame */
+	if (!more)
+		dp_tx_batch_flush(dp_intf, soc, cpu);
+
 	return QDF_STATUS_E_FAILURE;
 }
 
@@ -345,6 +345,30 @@ QDF_STATUS ucfg_dp_rx_ol_init(struct wlan_objmgr_psoc *psoc,
 QDF_STATUS
 ucfg_dp_start_xmit(qdf_nbuf_t nbuf, struct wlan_objmgr_vdev *vdev);
 
+/**
+ * ucfg_dp_tx_batch_end() - Transmit the frames held back on the current CPU
+ * @psoc: psoc handle
+ * @intf_addr: Interface MAC address
+ *
+ * Called from the xmit context when a frame is dropped before it is handed
+ * to ucfg_dp_start_xmit(), so that the frames of the burst held so far are
+ * not left waiting for a frame which never comes.
+ *
+ * Return: None
+ */
+void ucfg_dp_tx_batch_end(struct wlan_objmgr_psoc *psoc,
+			  struct qdf_mac_addr *intf_addr);
+
+/**
+ * ucfg_dp_tx_batch_purge() - Drop the tx frames held back on an interface
+ * @psoc: psoc handle
+ * @intf_addr: Interface MAC address
+ *
+ * Return: None
+ */
+void ucfg_dp_tx_batch_purge(struct wlan_objmgr_psoc *psoc,
+			    struct qdf_mac_addr *intf_addr);
+
 /**
  * ucfg_dp_rx_packet_cbk() - Receive packet on STA interface
  * @nbuf: n/w buffer to be received
@@ -247,6 +247,7 @@ ucfg_dp_create_intf(struct wlan_objmgr_psoc *psoc,
 	dp_periodic_sta_stats_mutex_create(dp_intf);
 	dp_nud_init_tracking(dp_intf);
 	dp_mic_init_work(dp_intf);
+	dp_tx_batch_init(dp_intf);
 	qdf_atomic_init(&dp_ctx->num_latency_critical_clients);
 	qdf_atomic_init(&dp_intf->gro_disallowed);
 
@@ -278,6 +279,7 @@ ucfg_dp_destroy_intf(struct wlan_objmgr_psoc *psoc,
 	dp_periodic_sta_stats_mutex_destroy(dp_intf);
 	dp_nud_deinit_tracking(dp_intf);
 	dp_mic_deinit_work(dp_intf);
+	dp_tx_batch_deinit(dp_intf);
 
 	qdf_spinlock_destroy(&dp_intf->dp_link_list_lock);
 	qdf_list_destroy(&dp_intf->dp_link_list);
@@ -1423,6 +1425,10 @@ QDF_STATUS ucfg_dp_start_xmit(qdf_nbuf_t nbuf, struct wlan_objmgr_vdev *vdev)
 	dp_link = dp_get_vdev_priv_obj(vdev);
 	if (unlikely(!dp_link)) {
 		dp_err_rl("DP link not found");
+		dp_intf = dp_get_intf_by_macaddr(dp_get_context(),
+			(struct qdf_mac_addr *)wlan_vdev_mlme_get_macaddr(vdev));
+		if (dp_intf)
+			dp_tx_batch_end(dp_intf);
 		return QDF_STATUS_E_INVAL;
 	}
 
@@ -1445,6 +1451,26 @@ QDF_STATUS ucfg_dp_start_xmit(qdf_nbuf_t nbuf, struct wlan_objmgr_vdev *vdev)
 	return status;
 }
 
+void ucfg_dp_tx_batch_end(struct wlan_objmgr_psoc *psoc,
+			  struct qdf_mac_addr *intf_addr)
+{
+	struct wlan_dp_intf *dp_intf;
+
+	dp_intf = dp_get_intf_by_macaddr(dp_get_context(), intf_addr);
+	if (dp_intf)
+		dp_tx_batch_end(dp_intf);
+}
+
+void ucfg_dp_tx_batch_purge(struct wlan_objmgr_psoc *psoc,
+			    struct qdf_mac_addr *intf_addr)
+{
+	struct wlan_dp_intf *dp_intf;
+
+	dp_intf = dp_get_intf_by_macaddr(dp_get_context(), intf_addr);
+	if (dp_intf)
+		dp_tx_batch_purge(dp_intf);
+}
+
 QDF_STATUS ucfg_dp_rx_packet_cbk(struct wlan_objmgr_vdev *vdev, qdf_nbuf_t nbuf)
 {
 	struct wlan_dp_intf *dp_intf;
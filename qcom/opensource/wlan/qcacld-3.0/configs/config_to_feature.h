@@ -342,6 +342,10 @@
 #define WLAN_LOGGING_BUFFERS_DYNAMICALLY (1)
 #endif
 
+#ifdef CONFIG_WLAN_LOGGING_PERCPU_RING
+#define WLAN_LOGGING_PERCPU_RING (1)
+#endif
+
 #ifdef CONFIG_WLAN_FEATURE_FILS
 #define WLAN_FEATURE_FILS_SK (1)
 #endif
@@ -465,6 +469,14 @@
 #define HIF_LATENCY_PROFILE_ENABLE (1)
 #endif
 
+#ifdef CONFIG_FEATURE_HIF_NAPI_DIM
+#define HIF_NAPI_DIM (1)
+#endif
+
+#ifdef CONFIG_FEATURE_DP_HIST_PERCENTILE
+#define DP_HIST_PERCENTILE (1)
+#endif
+
 #ifdef CONFIG_FEATURE_HAL_DELAYED_REG_WRITE
 #define FEATURE_HAL_DELAYED_REG_WRITE (1)
 #endif
@@ -583,6 +595,11 @@
 #define WLAN_FEATURE_DP_BUS_BANDWIDTH (1)
 #endif
 
+#if defined(CONFIG_WLAN_DP_BUS_BW_PREDICT) && \
+	defined(CONFIG_WLAN_FEATURE_DP_BUS_BANDWIDTH)
+#define WLAN_DP_BUS_BW_PREDICT (1)
+#endif
+
 #ifdef CONFIG_WLAN_FEATURE_PERIODIC_STA_STATS
 #define WLAN_FEATURE_PERIODIC_STA_STATS (1)
 #endif
@@ -1116,6 +1133,10 @@
 #define PKTLOG_HAS_SPECIFIC_DATA (1)
 #endif
 
+#if defined(CONFIG_WLAN_STREAMFS) && defined(CONFIG_WLAN_PKTLOG_STREAMFS)
+#define WLAN_PKTLOG_STREAMFS (1)
+#endif
+
 #ifdef CONFIG_LITTLE_ENDIAN
 #define ANI_LITTLE_BYTE_ENDIAN (1)
 #define ANI_LITTLE_BIT_ENDIAN (1)
@@ -1171,6 +1192,14 @@
 #define WLAN_DP_FEATURE_DEFERRED_REO_QDESC_DESTROY (1)
 #endif
 
+#ifdef CONFIG_WLAN_DP_REO_QDESC_CACHE
+#define WLAN_DP_REO_QDESC_CACHE (1)
+#endif
+
+#ifdef CONFIG_WLAN_DP_VDEV_STATS_AGGR_CACHE
+#define WLAN_DP_VDEV_STATS_AGGR_CACHE (1)
+#endif
+
 #ifdef CONFIG_ARCH_SDX20
 #define SYNC_IPA_READY (1)
 #endif
@@ -2211,6 +2240,10 @@
 #define WLAN_FEATURE_DP_RX_RING_HISTORY (1)
 #endif
 
+#ifdef CONFIG_WLAN_DP_RX_REAP_PROFILE
+#define WLAN_DP_RX_REAP_PROFILE (1)
+#endif
+
 #ifdef CONFIG_WLAN_FEATURE_DP_MON_STATUS_RING_HISTORY
 #define WLAN_FEATURE_DP_MON_STATUS_RING_HISTORY (1)
 #endif
@@ -2219,6 +2252,11 @@
 #define WLAN_FEATURE_DP_TX_DESC_HISTORY (1)
 #endif
 
+#if defined(CONFIG_WLAN_DP_TX_DESC_PCPU_CACHE) && \
+	!defined(CONFIG_WLAN_TX_FLOW_CONTROL_V2)
+#define WLAN_DP_TX_DESC_PCPU_CACHE (1)
+#endif
+
 #ifdef CONFIG_REO_QDESC_HISTORY
 #define REO_QDESC_HISTORY (1)
 #endif
@@ -2588,6 +2626,14 @@
 #define WLAN_SUPPORT_RX_FISA_HIST (1)
 #endif
 
+#ifdef CONFIG_RX_FISA_FRAG_AGGR
+#define WLAN_DP_FISA_FRAG_AGGR (1)
+#endif
+
+#if defined(CONFIG_WLAN_DP_RX_FLOW_STEERING) && defined(CONFIG_RX_FISA)
+#define WLAN_DP_RX_FLOW_STEERING (1)
+#endif
+
 #ifdef CONFIG_DP_SWLM
 #define WLAN_DP_FEATURE_SW_LATENCY_MGR (1)
 #endif
@@ -2694,6 +2740,9 @@
 #ifdef CONFIG_DP_RX_REFILL_THRD_THRESHOLD
 #define DP_RX_REFILL_THRD_THRESHOLD (CONFIG_DP_RX_REFILL_THRD_THRESHOLD)
 #endif
+#ifdef CONFIG_WLAN_DP_RX_PAGE_POOL
+#define WLAN_DP_RX_PAGE_POOL (1)
+#endif
 #endif
 #ifdef CONFIG_DP_FT_LOCK_HISTORY
 #define DP_FT_LOCK_HISTORY (1)
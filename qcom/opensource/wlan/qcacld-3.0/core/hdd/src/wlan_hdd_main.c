@@ -9884,6 +9884,7 @@ QDF_STATUS hdd_stop_adapter_ext(struct hdd_context *hdd_ctx,
 	wlan_hdd_netif_queue_control(adapter,
 				     WLAN_STOP_ALL_NETIF_QUEUE_N_CARRIER,
 				     WLAN_CONTROL_PATH);
+	ucfg_dp_tx_batch_purge(hdd_ctx->psoc, &adapter->mac_addr);
 
 	switch (adapter->device_mode) {
 	case QDF_STA_MODE:
@@ -515,8 +515,11 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	enum sme_qos_wmmuptype up;
 	QDF_STATUS status;
 
-	if (hdd_drop_tx_packet_on_ftm(skb))
+	if (hdd_drop_tx_packet_on_ftm(skb)) {
+		ucfg_dp_tx_batch_end(adapter->hdd_ctx->psoc,
+				     &adapter->mac_addr);
 		return;
+	}
 
 	osif_dp_mark_pkt_type(skb);
 	hdd_tx_latency_record_ingress_ts(adapter, skb);